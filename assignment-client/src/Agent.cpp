@@ -11,6 +11,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
+#include <QtCore/QJsonObject>
 #include <QtCore/QStandardPaths>
 #include <QtNetwork/QNetworkDiskCache>
 #include <QtNetwork/QNetworkRequest>
@@ -41,6 +42,7 @@
 #include <WebSocketServerClass.h>
 #include <EntityScriptingInterface.h> // TODO: consider moving to scriptengine.h
 
+#include "avatars/BotHost.h"
 #include "avatars/ScriptableAvatar.h"
 #include "entities/AssignmentParentFinder.h"
 #include "RecordingScriptingInterface.h"
@@ -364,6 +366,10 @@ void Agent::executeScript() {
     packetReceiver.registerListener(PacketType::KillAvatar, avatarHashMap.data(), "processKillAvatar");
     packetReceiver.registerListener(PacketType::AvatarIdentity, avatarHashMap.data(), "processAvatarIdentityPacket");
 
+    // give the script many more avatars to drive, for load testing
+    auto botHost = DependencyManager::set<BotHost>();
+    _scriptEngine->registerGlobalObject("Bots", botHost.data());
+
     // register ourselves to the script engine
     _scriptEngine->registerGlobalObject("Agent", this);
 
@@ -400,12 +406,27 @@ void Agent::executeScript() {
     QObject::connect(_scriptEngine.get(), &ScriptEngine::update, this, &Agent::processAgentAvatar);
     _scriptEngine->run();
 
+    DependencyManager::destroy<BotHost>();
+
     Frame::clearFrameHandler(AUDIO_FRAME_TYPE);
     Frame::clearFrameHandler(AVATAR_FRAME_TYPE);
 
     setFinished(true);
 }
 
+void Agent::sendStatsPacket() {
+    QJsonObject statsObject;
+
+    if (DependencyManager::isSet<BotHost>()) {
+        QVariantMap botStats = DependencyManager::get<BotHost>()->getStats();
+        if (!botStats.isEmpty()) {
+            statsObject["bots"] = QJsonObject::fromVariantMap(botStats);
+        }
+    }
+
+    addPacketStatsAndSendStatsPacket(statsObject);
+}
+
 QUuid Agent::getSessionUUID() const {
     return DependencyManager::get<NodeList>()->getSessionUUID();
 }
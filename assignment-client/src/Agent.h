@@ -60,6 +60,8 @@ public slots:
     void run() override;
     void playAvatarSound(SharedSoundPointer avatarSound);
 
+    void sendStatsPacket() override;
+
 private slots:
     void requestScript();
     void scriptRequestFinished();
@@ -89,6 +89,13 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    static const QString CONGESTION_CONTROL_OPTION = "congestion_control";
+    auto congestionControl = assetServerObject[CONGESTION_CONTROL_OPTION].toString();
+
+    if (!congestionControl.isEmpty() && nodeList->setCongestionControl(congestionControl)) {
+        qInfo() << "Set congestion control for downloads to" << congestionControl;
+    }
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -58,10 +58,10 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
 
-    packetReceiver.registerListenerForTypes({ PacketType::MicrophoneAudioNoEcho, PacketType::MicrophoneAudioWithEcho,
-                                              PacketType::InjectAudio, PacketType::SilentAudioFrame,
-                                              PacketType::AudioStreamStats },
-                                            this, "handleNodeAudioPacket");
+    packetReceiver.registerHandlerForTypes({ PacketType::MicrophoneAudioNoEcho, PacketType::MicrophoneAudioWithEcho,
+                                             PacketType::InjectAudio, PacketType::SilentAudioFrame,
+                                             PacketType::AudioStreamStats },
+                                           this, &AudioMixer::handleNodeAudioPacket, _audioPacketQueue);
     packetReceiver.registerListener(PacketType::NegotiateAudioFormat, this, "handleNegotiateAudioFormat");
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
     packetReceiver.registerListener(PacketType::NodeIgnoreRequest, this, "handleNodeIgnoreRequestPacket");
@@ -282,6 +282,7 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
+    statsObject["avg_silent_listeners_per_frame"] = (float)_stats.silentListeners / (float)_numStatFrames;
 
     // timing stats
     QJsonObject timingStats;
@@ -307,6 +308,13 @@ void AudioMixer::sendStatsPacket() {
     timingStats["us_per_events"] = (qint64)(timing / _numStatFrames);
     timingStats["us_per_events_trailing"] = (qint64)(trailing / _numStatFrames);
 
+    // per listener cost, in fractional microseconds since silent listeners are cheap
+    int audibleListeners = _stats.sumListeners - _stats.silentListeners;
+    timingStats["us_per_silent_listener"] = (_stats.silentListeners > 0) ?
+        (float)_stats.silentListenerNanos / (1000.0f * _stats.silentListeners) : 0.0f;
+    timingStats["us_per_audible_listener"] = (audibleListeners > 0) ?
+        (float)_stats.audibleListenerNanos / (1000.0f * audibleListeners) : 0.0f;
+
     // call it "avg_..." to keep it higher in the display, sorted alphabetically
     statsObject["avg_timing_stats"] = timingStats;
 
@@ -435,6 +443,9 @@ void AudioMixer::start() {
         {
             auto timer = _eventsTiming.timer();
 
+            // parse the audio received during the frame
+            _audioPacketQueue.process();
+
             // since we're a while loop we need to yield to qt's event processing
             QCoreApplication::processEvents();
 
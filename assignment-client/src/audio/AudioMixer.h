@@ -15,6 +15,7 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <PacketReceiver.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 
@@ -91,6 +92,9 @@ private:
 
     AudioMixerSlavePool _slavePool;
 
+    // audio packets, parsed on the mixer thread between frames
+    PacketReceiver::HandlerQueue _audioPacketQueue;
+
     class Timer {
     public:
         class Timing{
@@ -20,6 +20,7 @@
 #include <NodeList.h>
 #include <Node.h>
 #include <OctreeConstants.h>
+#include <PortableHighResolutionClock.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
@@ -165,6 +166,8 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
 
+        auto mixStart = p_high_resolution_clock::now();
+
         // mix the audio
         bool mixHasAudio = prepareMix(node);
 
@@ -185,6 +188,16 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
             sendSilentPacket(node, *data);
         }
 
+        // track the cost of silent listeners separately, as they are the common case
+        uint64_t mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            p_high_resolution_clock::now() - mixStart).count();
+        if (mixHasAudio) {
+            stats.audibleListenerNanos += mixTime;
+        } else {
+            ++stats.silentListeners;
+            stats.silentListenerNanos += mixTime;
+        }
+
         // send environment packet
         sendEnvironmentPacket(node, *data);
 
@@ -200,8 +213,8 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& node) {
     AvatarAudioStream* nodeAudioStream = static_cast<AudioMixerClientData*>(node->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
 
-    // zero out the client mix for this node
-    memset(_mixSamples, 0, sizeof(_mixSamples));
+    // the client mix for this node is zeroed on its first contribution
+    _mixHasEnergy = false;
 
     // loop through all other nodes that have sufficient audio to mix
     std::for_each(_begin, _end, [&](const SharedNodePointer& otherNode){
@@ -263,6 +276,16 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& node) {
         }
     });
 
+    if (!_mixHasEnergy) {
+        if (nodeData->audioLimiter.isSettled()) {
+            // nothing was mixed, and the limiter has no tail left to flush
+            return false;
+        }
+
+        // nothing was mixed, but render silence until the limiter has flushed its delay and released
+        memset(_mixSamples, 0, sizeof(_mixSamples));
+    }
+
     // use the per listener AudioLimiter to render the mixed data...
     nodeData->audioLimiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
@@ -338,6 +361,9 @@ void AudioMixerSlave::addStreamToMix(AudioMixerClientData& listenerNodeData, con
 
                 // this is not done for stereo streams since they do not go through the HRTF
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+                if (!hrtf.isSilent()) {
+                    clearMixOnFirstContribution();
+                }
                 hrtf.renderSilent(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
@@ -354,6 +380,8 @@ void AudioMixerSlave::addStreamToMix(AudioMixerClientData& listenerNodeData, con
     if (streamToAdd.isStereo() || isEcho) {
         // this is a stereo source or server echo so we do not pass it through the HRTF
         // simply apply our calculated gain to each sample
+        clearMixOnFirstContribution();
+
         if (streamToAdd.isStereo()) {
             for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
                 _mixSamples[i] += float(streamPopOutput[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
@@ -383,6 +411,9 @@ void AudioMixerSlave::addStreamToMix(AudioMixerClientData& listenerNodeData, con
         // silent frame from source
 
         // we still need to call renderSilent via the HRTF for mono source
+        if (!hrtf.isSilent()) {
+            clearMixOnFirstContribution();
+        }
         hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
@@ -397,6 +428,9 @@ void AudioMixerSlave::addStreamToMix(AudioMixerClientData& listenerNodeData, con
         // the mixer is struggling so we're going to drop off some streams
 
         // we call renderSilent via the HRTF with the actual frame data and a gain of 0.0
+        if (!hrtf.isSilent()) {
+            clearMixOnFirstContribution();
+        }
         hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, 0.0f,
                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
@@ -407,11 +441,20 @@ void AudioMixerSlave::addStreamToMix(AudioMixerClientData& listenerNodeData, con
 
     ++stats.hrtfRenders;
 
+    clearMixOnFirstContribution();
+
     // mono stream, call the HRTF with our block and calculated azimuth and gain
     hrtf.render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                 AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 }
 
+void AudioMixerSlave::clearMixOnFirstContribution() {
+    if (!_mixHasEnergy) {
+        memset(_mixSamples, 0, sizeof(_mixSamples));
+        _mixHasEnergy = true;
+    }
+}
+
 float AudioMixerSlave::gainForSource(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition, bool isEcho) {
     float gain = 1.0f;
@@ -44,6 +44,8 @@ private:
     // add a stream to the mix
     void addStreamToMix(AudioMixerClientData& listenerData, const QUuid& streamerID,
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+    // zero the mix before the first stream writes to it
+    void clearMixOnFirstContribution();
 
     float gainForSource(const AvatarAudioStream& listener, const PositionalAudioStream& streamer,
             const glm::vec3& relativePosition, bool isEcho);
@@ -53,6 +55,7 @@ private:
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    bool _mixHasEnergy { false };
 
     // frame state
     ConstIter _begin;
@@ -14,6 +14,9 @@
 void AudioMixerStats::reset() {
     sumStreams = 0;
     sumListeners = 0;
+    silentListeners = 0;
+    silentListenerNanos = 0;
+    audibleListenerNanos = 0;
     totalMixes = 0;
     hrtfRenders = 0;
     hrtfSilentRenders = 0;
@@ -25,6 +28,9 @@ void AudioMixerStats::reset() {
 void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumStreams += otherStats.sumStreams;
     sumListeners += otherStats.sumListeners;
+    silentListeners += otherStats.silentListeners;
+    silentListenerNanos += otherStats.silentListenerNanos;
+    audibleListenerNanos += otherStats.audibleListenerNanos;
     totalMixes += otherStats.totalMixes;
     hrtfRenders += otherStats.hrtfRenders;
     hrtfSilentRenders += otherStats.hrtfSilentRenders;
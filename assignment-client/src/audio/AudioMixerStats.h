@@ -12,9 +12,16 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
+#include <stdint.h>
+
 struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
+    int silentListeners { 0 };
+
+    // time spent mixing and sending to each kind of listener
+    uint64_t silentListenerNanos { 0 };
+    uint64_t audibleListenerNanos { 0 };
 
     int totalMixes { 0 };
 
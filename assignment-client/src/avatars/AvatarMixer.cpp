@@ -12,6 +12,7 @@
 #include <cfloat>
 #include <random>
 #include <memory>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
@@ -45,7 +46,12 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::ViewFrustum, this, "handleViewFrustumPacket");
-    packetReceiver.registerListener(PacketType::AvatarData, this, "handleAvatarDataPacket");
+    // avatar data is parsed on the broadcast thread between broadcasts, so it never waits for a broadcast to release
+    // the client data, and never holds up the network thread
+    packetReceiver.registerHandlerForTypes({ PacketType::AvatarData }, this, &AvatarMixer::handleAvatarDataPacket,
+                                           _avatarDataQueue);
+    packetReceiver.registerHandlerForTypes({ PacketType::HostedAvatarData }, this, &AvatarMixer::handleHostedAvatarDataPacket,
+                                           _avatarDataQueue);
     packetReceiver.registerListener(PacketType::AvatarIdentity, this, "handleAvatarIdentityPacket");
     packetReceiver.registerListener(PacketType::KillAvatar, this, "handleKillAvatarPacket");
     packetReceiver.registerListener(PacketType::NodeIgnoreRequest, this, "handleNodeIgnoreRequestPacket");
@@ -96,6 +102,9 @@ void AvatarMixer::broadcastAvatarData() {
         idleTime = std::chrono::duration_cast<std::chrono::microseconds>(idleDuration).count();
     }
 
+    // parse the avatar data received since the last broadcast
+    _avatarDataQueue.process();
+
     ++_numStatFrames;
 
     const float STRUGGLE_TRIGGER_SLEEP_PERCENTAGE_THRESHOLD = 0.10f;
@@ -283,147 +292,166 @@ void AvatarMixer::broadcastAvatarData() {
                 sendIdentityPacket(nodeData, node); // Tell new node about its sessionUUID. Others will find out below.
             }
 
-            // this is an AGENT we have received head data from
-            // send back a packet with other active node data to this node
-            nodeList->eachMatchingNode(
-                [&](const SharedNodePointer& otherNode)->bool {
-                    // make sure we have data for this avatar, that it isn't the same node,
-                    // and isn't an avatar that the viewing node has ignored
-                    // or that has ignored the viewing node
-                    if (!otherNode->getLinkedData()
-                        || otherNode->getUUID() == node->getUUID()
-                        || (node->isIgnoringNodeWithID(otherNode->getUUID()) && !getsIgnoredByMe)
-                        || (otherNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
-                        return false;
-                    } else {
-                        AvatarMixerClientData* otherData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
-                        AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
-                        // Check to see if the space bubble is enabled
-                        if (node->isIgnoreRadiusEnabled() || otherNode->isIgnoreRadiusEnabled()) {
-                            // Define the minimum bubble size
-                            static const glm::vec3 minBubbleSize = glm::vec3(0.3f, 1.3f, 0.3f);
-                            // Define the scale of the box for the current node
-                            glm::vec3 nodeBoxScale = (nodeData->getPosition() - nodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-                            // Define the scale of the box for the current other node
-                            glm::vec3 otherNodeBoxScale = (otherData->getPosition() - otherData->getGlobalBoundingBoxCorner()) * 2.0f;
-
-                            // Set up the bounding box for the current node
-                            AABox nodeBox(nodeData->getGlobalBoundingBoxCorner(), nodeBoxScale);
-                            // Clamp the size of the bounding box to a minimum scale
-                            if (glm::any(glm::lessThan(nodeBoxScale, minBubbleSize))) {
-                                nodeBox.setScaleStayCentered(minBubbleSize);
-                            }
-                            // Set up the bounding box for the current other node
-                            AABox otherNodeBox(otherData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-                            // Clamp the size of the bounding box to a minimum scale
-                            if (glm::any(glm::lessThan(otherNodeBoxScale, minBubbleSize))) {
-                                otherNodeBox.setScaleStayCentered(minBubbleSize);
-                            }
-                            // Quadruple the scale of both bounding boxes
-                            nodeBox.embiggen(4.0f);
-                            otherNodeBox.embiggen(4.0f);
-
-                            // Perform the collision check between the two bounding boxes
-                            if (nodeBox.touches(otherNodeBox)) {
-                                nodeData->ignoreOther(node, otherNode);
-                                return getsAnyIgnored;
-                            }
-                        }
-                        // Not close enough to ignore
-                        nodeData->removeFromRadiusIgnoringSet(node, otherNode->getUUID());
-                        return true;
-                    }
-                },
-                [&](const SharedNodePointer& otherNode) {
-                    ++numOtherAvatars;
+            // decide whether the avatar of another node goes to this node, given their ignores and space bubbles
+            auto shouldSendOtherNode = [&](const SharedNodePointer& otherNode)->bool {
+                // make sure it isn't an avatar that the viewing node has ignored
+                // or that has ignored the viewing node
+                if ((node->isIgnoringNodeWithID(otherNode->getUUID()) && !getsIgnoredByMe)
+                    || (otherNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
+                    return false;
+                }
 
-                    AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
-                    MutexTryLocker lock(otherNodeData->getMutex());
-                    if (!lock.isLocked()) {
-                        return;
+                AvatarMixerClientData* otherData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
+                // Check to see if the space bubble is enabled
+                if (node->isIgnoreRadiusEnabled() || otherNode->isIgnoreRadiusEnabled()) {
+                    // Define the minimum bubble size
+                    static const glm::vec3 minBubbleSize = glm::vec3(0.3f, 1.3f, 0.3f);
+                    // Define the scale of the box for the current node
+                    glm::vec3 nodeBoxScale = (nodeData->getPosition() - nodeData->getGlobalBoundingBoxCorner()) * 2.0f;
+                    // Define the scale of the box for the current other node
+                    glm::vec3 otherNodeBoxScale = (otherData->getPosition() - otherData->getGlobalBoundingBoxCorner()) * 2.0f;
+
+                    // Set up the bounding box for the current node
+                    AABox nodeBox(nodeData->getGlobalBoundingBoxCorner(), nodeBoxScale);
+                    // Clamp the size of the bounding box to a minimum scale
+                    if (glm::any(glm::lessThan(nodeBoxScale, minBubbleSize))) {
+                        nodeBox.setScaleStayCentered(minBubbleSize);
+                    }
+                    // Set up the bounding box for the current other node
+                    AABox otherNodeBox(otherData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
+                    // Clamp the size of the bounding box to a minimum scale
+                    if (glm::any(glm::lessThan(otherNodeBoxScale, minBubbleSize))) {
+                        otherNodeBox.setScaleStayCentered(minBubbleSize);
+                    }
+                    // Quadruple the scale of both bounding boxes
+                    nodeBox.embiggen(4.0f);
+                    otherNodeBox.embiggen(4.0f);
+
+                    // Perform the collision check between the two bounding boxes
+                    if (nodeBox.touches(otherNodeBox)) {
+                        nodeData->ignoreOther(node, otherNode);
+                        return getsAnyIgnored;
                     }
+                }
+                // Not close enough to ignore
+                nodeData->removeFromRadiusIgnoringSet(node, otherNode->getUUID());
+                return true;
+            };
 
-                    // make sure we send out identity packets to and from new arrivals.
-                    bool forceSend = !otherNodeData->checkAndSetHasReceivedFirstPacketsFrom(node->getUUID());
+            // add the data of another avatar, either the one of another node or one hosted by it,
+            // to the packets for this node
+            auto sendOtherAvatar = [&](const QUuid& otherID, AvatarMixerClientData* otherNodeData) {
+                ++numOtherAvatars;
 
-                    if (otherNodeData->getIdentityChangeTimestamp().time_since_epoch().count() > 0
-                        && (forceSend
-                            || otherNodeData->getIdentityChangeTimestamp() > _lastFrameTimestamp
-                            || distribution(generator) < IDENTITY_SEND_PROBABILITY)) {
-                        sendIdentityPacket(otherNodeData, node);
-                    }
+                // make sure we send out identity packets to and from new arrivals.
+                bool forceSend = !otherNodeData->checkAndSetHasReceivedFirstPacketsFrom(node->getUUID());
 
-                    AvatarData& otherAvatar = otherNodeData->getAvatar();
-                    //  Decide whether to send this avatar's data based on it's distance from us
+                if (otherNodeData->getIdentityChangeTimestamp().time_since_epoch().count() > 0
+                    && (forceSend
+                        || otherNodeData->getIdentityChangeTimestamp() > _lastFrameTimestamp
+                        || distribution(generator) < IDENTITY_SEND_PROBABILITY)) {
+                    sendIdentityPacket(otherNodeData, node);
+                }
 
-                    //  The full rate distance is the distance at which EVERY update will be sent for this avatar
-                    //  at twice the full rate distance, there will be a 50% chance of sending this avatar's update
-                    glm::vec3 otherPosition = otherAvatar.getClientGlobalPosition();
-                    float distanceToAvatar = glm::length(myPosition - otherPosition);
+                AvatarData& otherAvatar = otherNodeData->getAvatar();
+                //  Decide whether to send this avatar's data based on it's distance from us
 
-                    // potentially update the max full rate distance for this frame
-                    maxAvatarDistanceThisFrame = std::max(maxAvatarDistanceThisFrame, distanceToAvatar);
+                //  The full rate distance is the distance at which EVERY update will be sent for this avatar
+                //  at twice the full rate distance, there will be a 50% chance of sending this avatar's update
+                glm::vec3 otherPosition = otherAvatar.getClientGlobalPosition();
+                float distanceToAvatar = glm::length(myPosition - otherPosition);
 
-                    if (distanceToAvatar != 0.0f
-                        && !getsOutOfView
-                        && distribution(generator) > (nodeData->getFullRateDistance() / distanceToAvatar)) {
-                        return;
-                    }
+                // potentially update the max full rate distance for this frame
+                maxAvatarDistanceThisFrame = std::max(maxAvatarDistanceThisFrame, distanceToAvatar);
 
-                    AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(otherNode->getUUID());
-                    AvatarDataSequenceNumber lastSeqFromSender = otherNodeData->getLastReceivedSequenceNumber();
+                if (distanceToAvatar != 0.0f
+                    && !getsOutOfView
+                    && distribution(generator) > (nodeData->getFullRateDistance() / distanceToAvatar)) {
+                    return;
+                }
 
-                    if (lastSeqToReceiver > lastSeqFromSender && lastSeqToReceiver != UINT16_MAX) {
-                        // we got out out of order packets from the sender, track it
-                        otherNodeData->incrementNumOutOfOrderSends();
-                    }
+                AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(otherID);
+                AvatarDataSequenceNumber lastSeqFromSender = otherNodeData->getLastReceivedSequenceNumber();
 
-                    // make sure we haven't already sent this data from this sender to this receiver
-                    // or that somehow we haven't sent
-                    if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
-                        ++numAvatarsHeldBack;
-                        return;
-                    } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
-                        // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
-                        ++numAvatarsWithSkippedFrames;
-                    }
+                if (lastSeqToReceiver > lastSeqFromSender && lastSeqToReceiver != UINT16_MAX) {
+                    // we got out out of order packets from the sender, track it
+                    otherNodeData->incrementNumOutOfOrderSends();
+                }
+
+                // make sure we haven't already sent this data from this sender to this receiver
+                // or that somehow we haven't sent
+                if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
+                    ++numAvatarsHeldBack;
+                    return;
+                } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
+                    // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
+                    ++numAvatarsWithSkippedFrames;
+                }
 
-                    // we're going to send this avatar
+                // we're going to send this avatar
 
-                    // increment the number of avatars sent to this reciever
-                    nodeData->incrementNumAvatarsSentLastFrame();
+                // increment the number of avatars sent to this reciever
+                nodeData->incrementNumAvatarsSentLastFrame();
 
-                    // set the last sent sequence number for this sender on the receiver
-                    nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(),
-                                                             otherNodeData->getLastReceivedSequenceNumber());
+                // set the last sent sequence number for this sender on the receiver
+                nodeData->setLastBroadcastSequenceNumber(otherID, otherNodeData->getLastReceivedSequenceNumber());
 
-                    // determine if avatar is in view, to determine how much data to include...
-                    glm::vec3 otherNodeBoxScale = (otherNodeData->getPosition() - otherNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-                    AABox otherNodeBox(otherNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-                    bool isInView = nodeData->otherAvatarInView(otherNodeBox);
+                // determine if avatar is in view, to determine how much data to include...
+                glm::vec3 otherNodeBoxScale = (otherNodeData->getPosition() - otherNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
+                AABox otherNodeBox(otherNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
+                bool isInView = nodeData->otherAvatarInView(otherNodeBox);
 
-                    // this throttles the extra data to only be sent every Nth message
-                    if (!isInView && getsOutOfView && (lastSeqToReceiver % EXTRA_AVATAR_DATA_FRAME_RATIO > 0)) {
+                // this throttles the extra data to only be sent every Nth message
+                if (!isInView && getsOutOfView && (lastSeqToReceiver % EXTRA_AVATAR_DATA_FRAME_RATIO > 0)) {
+                    return;
+                }
+
+                // start a new segment in the PacketList for this avatar
+                avatarPacketList->startSegment();
+
+                AvatarData::AvatarDataDetail detail;
+                if (!isInView && !getsOutOfView) {
+                    detail = AvatarData::MinimumData;
+                    nodeData->incrementAvatarOutOfView();
+                } else {
+                    detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO
+                                    ? AvatarData::SendAllData : AvatarData::IncludeSmallData;
+                    nodeData->incrementAvatarInView();
+                }
+
+                numAvatarDataBytes += avatarPacketList->write(otherID.toRfc4122());
+                numAvatarDataBytes += avatarPacketList->write(otherAvatar.toByteArray(detail));
+
+                avatarPacketList->endSegment();
+            };
+
+            // this is an AGENT we have received head data from
+            // send back a packet with other active node data to this node
+            nodeList->eachMatchingNode(
+                [&](const SharedNodePointer& otherNode)->bool {
+                    // make sure we have data for this avatar, and that it isn't the same node
+                    return otherNode->getLinkedData() && otherNode->getUUID() != node->getUUID();
+                },
+                [&](const SharedNodePointer& otherNode) {
+                    AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
+                    MutexTryLocker lock(otherNodeData->getMutex());
+                    if (!lock.isLocked()) {
                         return;
                     }
 
-                    // start a new segment in the PacketList for this avatar
-                    avatarPacketList->startSegment();
-
-                    AvatarData::AvatarDataDetail detail;
-                    if (!isInView && !getsOutOfView) {
-                        detail = AvatarData::MinimumData;
-                        nodeData->incrementAvatarOutOfView();
-                    } else {
-                        detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO
-                                        ? AvatarData::SendAllData : AvatarData::IncludeSmallData;
-                        nodeData->incrementAvatarInView();
+                    if (shouldSendOtherNode(otherNode)) {
+                        sendOtherAvatar(otherNode->getUUID(), otherNodeData);
                     }
 
-                    numAvatarDataBytes += avatarPacketList->write(otherNode->getUUID().toRfc4122());
-                    numAvatarDataBytes += avatarPacketList->write(otherAvatar.toByteArray(detail));
-
-                    avatarPacketList->endSegment();
+                    // the avatars hosted by the other node follow the ignores of the nodes, but have no space bubble
+                    for (auto& hostedAvatar : otherNodeData->getHostedAvatars()) {
+                        const QUuid& hostedAvatarID = hostedAvatar.first;
+                        if ((node->isIgnoringNodeWithID(hostedAvatarID) && !getsIgnoredByMe)
+                            || (otherNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
+                            continue;
+                        }
+                        sendOtherAvatar(hostedAvatarID, hostedAvatar.second.get());
+                    }
             });
 
             // close the current packet so that we're always sending something
@@ -474,6 +502,10 @@ void AvatarMixer::broadcastAvatarData() {
             }
             AvatarData& otherAvatar = otherNodeData->getAvatar();
             otherAvatar.doneEncoding(false);
+
+            for (auto& hostedAvatar : otherNodeData->getHostedAvatars()) {
+                hostedAvatar.second->getAvatar().doneEncoding(false);
+            }
         });
 
     _lastFrameTimestamp = p_high_resolution_clock::now();
@@ -494,8 +526,7 @@ void AvatarMixer::broadcastAvatarData() {
 void AvatarMixer::nodeKilled(SharedNodePointer killedNode) {
     if (killedNode->getType() == NodeType::Agent
         && killedNode->getLinkedData()) {
-        auto nodeList = DependencyManager::get<NodeList>();
-
+        std::vector<QUuid> hostedAvatarIDs;
         {  // decrement sessionDisplayNames table and possibly remove
            QMutexLocker nodeDataLocker(&killedNode->getLinkedData()->getMutex());
            AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(killedNode->getLinkedData());
@@ -504,38 +535,51 @@ void AvatarMixer::nodeKilled(SharedNodePointer killedNode) {
            if (--_sessionDisplayNames[baseDisplayName].second <= 0) {
                _sessionDisplayNames.remove(baseDisplayName);
            }
+
+           for (auto& hostedAvatar : nodeData->getHostedAvatars()) {
+               hostedAvatarIDs.push_back(hostedAvatar.first);
+           }
         }
 
-        // this was an avatar we were sending to other people
-        // send a kill packet for it to our other nodes
-        auto killPacket = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason));
-        killPacket->write(killedNode->getUUID().toRfc4122());
-        killPacket->writePrimitive(KillAvatarReason::AvatarDisconnected);
+        // this was an avatar we were sending to other people, along with the avatars it hosted
+        broadcastKillAvatar(killedNode->getUUID());
+        for (auto& hostedAvatarID : hostedAvatarIDs) {
+            broadcastKillAvatar(hostedAvatarID);
+        }
+    }
+}
 
-        nodeList->broadcastToNodes(std::move(killPacket), NodeSet() << NodeType::Agent);
+void AvatarMixer::broadcastKillAvatar(const QUuid& avatarID) {
+    auto nodeList = DependencyManager::get<NodeList>();
 
-        // we also want to remove sequence number data for this avatar on our other avatars
-        // so invoke the appropriate method on the AvatarMixerClientData for other avatars
-        nodeList->eachMatchingNode(
-            [&](const SharedNodePointer& node)->bool {
-                if (!node->getLinkedData()) {
-                    return false;
-                }
+    // send a kill packet for the avatar to our other nodes
+    auto killPacket = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason));
+    killPacket->write(avatarID.toRfc4122());
+    killPacket->writePrimitive(KillAvatarReason::AvatarDisconnected);
 
-                if (node->getUUID() == killedNode->getUUID()) {
-                    return false;
-                }
+    nodeList->broadcastToNodes(std::move(killPacket), NodeSet() << NodeType::Agent);
 
-                return true;
-            },
-            [&](const SharedNodePointer& node) {
-                QMetaObject::invokeMethod(node->getLinkedData(),
-                                          "removeLastBroadcastSequenceNumber",
-                                          Qt::AutoConnection,
-                                          Q_ARG(const QUuid&, QUuid(killedNode->getUUID())));
+    // we also want to remove sequence number data for this avatar on our other avatars
+    // so invoke the appropriate method on the AvatarMixerClientData for other avatars
+    nodeList->eachMatchingNode(
+        [&](const SharedNodePointer& node)->bool {
+            if (!node->getLinkedData()) {
+                return false;
             }
-        );
-    }
+
+            if (node->getUUID() == avatarID) {
+                return false;
+            }
+
+            return true;
+        },
+        [&](const SharedNodePointer& node) {
+            QMetaObject::invokeMethod(node->getLinkedData(),
+                                      "removeLastBroadcastSequenceNumber",
+                                      Qt::AutoConnection,
+                                      Q_ARG(const QUuid&, avatarID));
+        }
+    );
 }
 
 void AvatarMixer::handleViewFrustumPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -569,6 +613,33 @@ void AvatarMixer::handleAvatarDataPacket(QSharedPointer<ReceivedMessage> message
     nodeList->updateNodeWithDataFromPacket(message, senderNode);
 }
 
+void AvatarMixer::handleHostedAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    // only assignment clients, and users the domain lets host avatars, can speak for other avatars
+    if (!senderNode->getCanHostAvatars()) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    NodeData* linkedData = nodeList->getOrCreateLinkedData(senderNode);
+
+    if (linkedData) {
+        // the ID of the hosted avatar comes first, then the same data as an AvatarData packet
+        QUuid hostedAvatarID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+        // never host an avatar under the ID of a connected node. This is looked up before locking the node data,
+        // since the broadcast locks node data while it holds the node list.
+        if (nodeList->nodeWithUUID(hostedAvatarID)) {
+            return;
+        }
+
+        QMutexLocker linkedDataLocker(&linkedData->getMutex());
+        auto hostedAvatar = static_cast<AvatarMixerClientData*>(linkedData)->getOrCreateHostedAvatar(hostedAvatarID);
+        if (hostedAvatar) {
+            hostedAvatar->parseData(*message);
+        }
+    }
+}
+
 void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->getOrCreateLinkedData(senderNode);
@@ -576,11 +647,24 @@ void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> mes
     if (senderNode->getLinkedData()) {
         AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
         if (nodeData != nullptr) {
-            AvatarData& avatar = nodeData->getAvatar();
-
             // parse the identity packet and update the change timestamp if appropriate
             AvatarData::Identity identity;
             AvatarData::parseAvatarIdentityPacket(message->getMessage(), identity);
+
+            // the identity of an avatar hosted by the node, which we have had data from
+            if (!identity.uuid.isNull() && identity.uuid != senderNode->getUUID()) {
+                QMutexLocker nodeDataLocker(&nodeData->getMutex());
+                auto hostedAvatar = nodeData->getHostedAvatar(identity.uuid);
+                if (hostedAvatar && hostedAvatar->getAvatar().processAvatarIdentity(identity)) {
+                    hostedAvatar->flagIdentityChange();
+                    hostedAvatar->setReceivedIdentity();
+                }
+                if (hostedAvatar) {
+                    return;
+                }
+            }
+
+            AvatarData& avatar = nodeData->getAvatar();
             if (avatar.processAvatarIdentity(identity)) {
                 QMutexLocker nodeDataLocker(&nodeData->getMutex());
                 nodeData->flagIdentityChange();
@@ -590,7 +674,24 @@ void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> mes
     }
 }
 
-void AvatarMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message) {
+void AvatarMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    // a node removing one of the avatars it hosts
+    AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
+    if (nodeData) {
+        QUuid avatarID = QUuid::fromRfc4122(message->peek(NUM_BYTES_RFC4122_UUID));
+
+        bool wasHosted;
+        {
+            QMutexLocker nodeDataLocker(&nodeData->getMutex());
+            wasHosted = nodeData->removeHostedAvatar(avatarID);
+        }
+
+        if (wasHosted) {
+            broadcastKillAvatar(avatarID);
+            return;
+        }
+    }
+
     DependencyManager::get<NodeList>()->processKillNode(*message);
 }
 
@@ -633,6 +734,7 @@ void AvatarMixer::sendStatsPacket() {
             MutexTryLocker lock(clientData->getMutex());
             if (lock.isLocked()) {
                 clientData->loadJSONStats(avatarStats);
+                avatarStats["num_hosted_avatars"] = (int)clientData->getHostedAvatars().size();
 
                 // add the diff between the full outbound bandwidth and the measured bandwidth for AvatarData send only
                 avatarStats["delta_full_vs_avatar_data_kbps"] =
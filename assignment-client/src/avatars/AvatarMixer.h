@@ -16,6 +16,7 @@
 #define hifi_AvatarMixer_h
 
 #include <shared/RateCounter.h>
+#include <PacketReceiver.h>
 #include <PortableHighResolutionClock.h>
 
 #include <ThreadedAssignment.h>
@@ -38,8 +39,9 @@ public slots:
 private slots:
     void handleViewFrustumPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleHostedAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
-    void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message);
+    void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleRadiusIgnoreRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -51,9 +53,13 @@ private:
     void broadcastAvatarData();
     void parseDomainServerSettings(const QJsonObject& domainSettings);
     void sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode);
+    void broadcastKillAvatar(const QUuid& avatarID);
 
     QThread _broadcastThread;
 
+    // avatar data, parsed on the broadcast thread before each broadcast
+    PacketReceiver::HandlerQueue _avatarDataQueue;
+
     p_high_resolution_clock::time_point _lastFrameTimestamp;
 
     float _trailingSleepRatio { 1.0f };
@@ -16,6 +16,16 @@
 
 #include "AvatarMixerClientData.h"
 
+std::mutex AvatarMixerClientData::_allHostedAvatarIDsMutex;
+std::unordered_set<QUuid> AvatarMixerClientData::_allHostedAvatarIDs;
+
+AvatarMixerClientData::~AvatarMixerClientData() {
+    std::lock_guard<std::mutex> lock(_allHostedAvatarIDsMutex);
+    for (auto& hostedAvatar : _hostedAvatars) {
+        _allHostedAvatarIDs.erase(hostedAvatar.first);
+    }
+}
+
 int AvatarMixerClientData::parseData(ReceivedMessage& message) {
     // pull the sequence number from the data first
     message.readPrimitive(&_lastReceivedSequenceNumber);
@@ -24,6 +34,44 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message) {
     return _avatar->parseDataFromBuffer(message.readWithoutCopy(message.getBytesLeftToRead()));
 }
 
+AvatarMixerClientData* AvatarMixerClientData::getHostedAvatar(const QUuid& avatarID) const {
+    auto it = _hostedAvatars.find(avatarID);
+    return it != _hostedAvatars.end() ? it->second.get() : nullptr;
+}
+
+AvatarMixerClientData* AvatarMixerClientData::getOrCreateHostedAvatar(const QUuid& avatarID) {
+    auto it = _hostedAvatars.find(avatarID);
+    if (it != _hostedAvatars.end()) {
+        return it->second.get();
+    }
+
+    if (avatarID.isNull() || avatarID == getNodeID() || _hostedAvatars.size() >= MAX_HOSTED_AVATARS_PER_NODE) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_allHostedAvatarIDsMutex);
+        if (!_allHostedAvatarIDs.insert(avatarID).second) {
+            return nullptr;
+        }
+    }
+
+    auto hostedAvatar = new AvatarMixerClientData(avatarID);
+    hostedAvatar->getAvatar().setSessionUUID(avatarID);
+    hostedAvatar->getAvatar().setDomainMinimumScale(_avatar->getDomainMinScale());
+    hostedAvatar->getAvatar().setDomainMaximumScale(_avatar->getDomainMaxScale());
+    _hostedAvatars.emplace(avatarID, std::unique_ptr<AvatarMixerClientData>(hostedAvatar));
+    return hostedAvatar;
+}
+
+bool AvatarMixerClientData::removeHostedAvatar(const QUuid& avatarID) {
+    if (_hostedAvatars.erase(avatarID) == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(_allHostedAvatarIDsMutex);
+    _allHostedAvatarIDs.erase(avatarID);
+    return true;
+}
+
 bool AvatarMixerClientData::checkAndSetHasReceivedFirstPacketsFrom(const QUuid& uuid) {
     if (_hasReceivedFirstPacketsFrom.find(uuid) == _hasReceivedFirstPacketsFrom.end()) {
         _hasReceivedFirstPacketsFrom.insert(uuid);
@@ -14,6 +14,8 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -32,16 +34,29 @@
 const QString OUTBOUND_AVATAR_DATA_STATS_KEY = "outbound_av_data_kbps";
 const QString INBOUND_AVATAR_DATA_STATS_KEY = "inbound_av_data_kbps";
 
+// How many avatars one node can host besides its own, see AvatarMixerClientData::getOrCreateHostedAvatar
+const int MAX_HOSTED_AVATARS_PER_NODE = 1000;
+
 class AvatarMixerClientData : public NodeData {
     Q_OBJECT
 public:
     AvatarMixerClientData(const QUuid& nodeID = QUuid()) : NodeData(nodeID) { _currentViewFrustum.invalidate(); }
-    virtual ~AvatarMixerClientData() {}
+    virtual ~AvatarMixerClientData();
     using HRCTime = p_high_resolution_clock::time_point;
 
     int parseData(ReceivedMessage& message) override;
     AvatarData& getAvatar() { return *_avatar; }
 
+    // A node can send the data of other avatars than its own (HostedAvatarData packets), each with its own ID.
+    // They are broadcast like the avatars of other nodes, and are guarded by the mutex of the hosting node.
+    using HostedAvatars = std::unordered_map<QUuid, std::unique_ptr<AvatarMixerClientData>>;
+    const HostedAvatars& getHostedAvatars() const { return _hostedAvatars; }
+    AvatarMixerClientData* getHostedAvatar(const QUuid& avatarID) const;
+    // returns nullptr if the node already hosts the maximum number of avatars, or another node hosts this one.
+    // The caller rejects the IDs of connected nodes.
+    AvatarMixerClientData* getOrCreateHostedAvatar(const QUuid& avatarID);
+    bool removeHostedAvatar(const QUuid& avatarID);
+
     bool checkAndSetHasReceivedFirstPacketsFrom(const QUuid& uuid);
 
     uint16_t getLastBroadcastSequenceNumber(const QUuid& nodeUUID) const;
@@ -106,6 +121,11 @@ public:
 
 private:
     AvatarSharedPointer _avatar { new AvatarData() };
+    HostedAvatars _hostedAvatars;
+
+    // the IDs of the avatars hosted by all nodes, so that no two nodes host the same one
+    static std::mutex _allHostedAvatarIDsMutex;
+    static std::unordered_set<QUuid> _allHostedAvatarIDs;
 
     uint16_t _lastReceivedSequenceNumber { 0 };
     std::unordered_map<QUuid, uint16_t> _lastBroadcastSequenceNumbers;
@@ -0,0 +1,481 @@
+//
+//  BotHost.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BotHost.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <AudioConstants.h>
+#include <AudioHelpers.h>
+#include <GLMHelpers.h>
+#include <MovingMinMaxAvg.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <RegisteredMetaTypes.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+#include <recording/ClipCache.h>
+#include <recording/Frame.h>
+#include <shared/ParallelFor.h>
+
+#include "../AvatarAudioTimer.h"
+#include "ScriptableAvatar.h"
+
+// Each bot sends its avatar data every other tick, and half of the bots send on each tick
+static const int AVATAR_DATA_TICKS = 2;
+static const quint64 AVATAR_DATA_SEND_INTERVAL_USECS = AVATAR_DATA_TICKS * AudioConstants::NETWORK_FRAME_USECS;
+static const quint64 AVATAR_IDENTITY_SEND_INTERVAL_USECS = AVATAR_IDENTITY_PACKET_SEND_INTERVAL_MSECS * USECS_PER_MSEC;
+
+static const float DEFAULT_WALK_RADIUS = 2.0f; // meters
+static const float DEFAULT_WALK_SPEED = 1.0f; // meters per second
+
+// send gaps are collected over 10 seconds, updated every second
+static const int SEND_GAP_STATS_INTERVAL = 1000000 / AVATAR_DATA_SEND_INTERVAL_USECS;
+static const int SEND_GAP_STATS_WINDOW_INTERVALS = 10;
+// the gain of the running estimate of the jitter, as for RTP interarrival jitter
+static const float JITTER_GAIN = 1.0f / 16.0f;
+
+static recording::FrameType avatarFrameType() {
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    return AVATAR_FRAME_TYPE;
+}
+
+static recording::FrameType audioFrameType() {
+    static const recording::FrameType AUDIO_FRAME_TYPE =
+        recording::Frame::registerFrameType(AudioConstants::getAudioFrameName());
+    return AUDIO_FRAME_TYPE;
+}
+
+class Bot {
+public:
+    Bot(const QUuid& id, const QVariantMap& properties);
+
+    const QUuid& getID() const { return _id; }
+    ScriptableAvatar& getAvatar() { return *_avatar; }
+
+    bool hasRecording() const { return _hasRecording; }
+    void setClip(const recording::ClipPointer& clip) { std::atomic_store(&_clip, clip); }
+
+    // on the pool: read the frames of the recording that are due
+    void readFrames(quint64 now);
+    // on the timer thread, where the avatar lives: apply the frames, or walk
+    void animate(quint64 now);
+    // on the pool: encode the avatar data, if it is due, and the audio
+    void encode(bool sendAvatarData);
+    // on the timer thread
+    void send(quint64 now, NodeList& nodeList, const SharedNodePointer& avatarMixer, const SharedNodePointer& audioMixer);
+
+    QVariantMap getStats() const;
+
+private:
+    void walk(float deltaTime);
+    std::unique_ptr<NLPacket> createAudioPacket(const QByteArray& audio);
+
+    QUuid _id;
+    std::unique_ptr<ScriptableAvatar> _avatar;
+
+    std::mt19937 _random;
+    std::uniform_real_distribution<float> _distribution;
+
+    bool _hasRecording { false };
+    recording::ClipPointer _clip; // set once loaded, with std::atomic_store
+    bool _isPlaying { false };
+    quint64 _clipStartTime { 0 };
+    QJsonObject _avatarJson; // of the last avatar frame that was due
+    bool _hasAvatarJson { false };
+    std::vector<recording::FrameConstPointer> _audioFrames;
+
+    glm::vec3 _walkCenter;
+    float _walkRadius { DEFAULT_WALK_RADIUS };
+    float _walkSpeed { DEFAULT_WALK_SPEED };
+    float _walkAngle { 0.0f };
+    quint64 _lastAnimateTime { 0 };
+
+    AvatarDataSequenceNumber _avatarSequenceNumber { 0 };
+    quint16 _audioSequenceNumber { 0 };
+    std::unique_ptr<NLPacket> _avatarPacket;
+    std::vector<std::unique_ptr<NLPacket>> _audioPackets;
+    quint64 _nextIdentitySendTime { 0 };
+
+    mutable std::mutex _statsMutex;
+    quint64 _lastAvatarSendTime { 0 };
+    MovingMinMaxAvg<quint64> _sendGaps { SEND_GAP_STATS_INTERVAL, SEND_GAP_STATS_WINDOW_INTERVALS };
+    float _jitter { 0.0f }; // usecs
+    quint64 _numAvatarSends { 0 };
+};
+
+Bot::Bot(const QUuid& id, const QVariantMap& properties) :
+    _id(id),
+    _avatar(new ScriptableAvatar()),
+    _random((unsigned int)qHash(id))
+{
+    _avatar->setSessionUUID(_id);
+    _avatar->setForceFaceTrackerConnected(true);
+    _avatar->setSkeletonModelURL(properties["skeletonModelURL"].toUrl());
+    _avatar->setDisplayName(properties.value("displayName", "Bot").toString());
+
+    _walkCenter = vec3FromVariant(properties["position"]);
+    _avatar->setPosition(_walkCenter);
+    _walkRadius = properties.value("walkRadius", DEFAULT_WALK_RADIUS).toFloat();
+    _walkSpeed = properties.value("walkSpeed", DEFAULT_WALK_SPEED).toFloat();
+    _walkAngle = _distribution(_random) * TWO_PI;
+
+    // recordings play around the position of the bot
+    _hasRecording = !properties["recordingURL"].toString().isEmpty();
+    if (_hasRecording) {
+        _avatar->setRecordingBasis(std::make_shared<Transform>(Quaternions::IDENTITY, Vectors::ONE, _walkCenter));
+    }
+
+    QString animationURL = properties["animationURL"].toString();
+    if (!_hasRecording && !animationURL.isEmpty()) {
+        const float ANIMATION_FPS = 30.0f;
+        const float ANIMATION_PRIORITY = 1.0f;
+        _avatar->startAnimation(animationURL, ANIMATION_FPS, ANIMATION_PRIORITY, true);
+    }
+}
+
+void Bot::readFrames(quint64 now) {
+    using namespace recording;
+
+    auto clip = std::atomic_load(&_clip);
+    if (!clip) {
+        return;
+    }
+
+    if (!_isPlaying) {
+        // start somewhere in the recording, so that bots playing the same one are not in step
+        Frame::Time duration = Frame::secondsToFrameTime(clip->duration());
+        Frame::Time offset = duration > 0 ? (Frame::Time)(_distribution(_random) * duration) : 0;
+        clip->seekFrameTime(offset);
+        _clipStartTime = now - offset * USECS_PER_MSEC;
+        _isPlaying = true;
+    }
+
+    Frame::Time position = (Frame::Time)((now - _clipStartTime) / USECS_PER_MSEC);
+    while (clip->positionFrameTime() <= position) {
+        auto frame = clip->nextFrame();
+        if (frame->type == avatarFrameType()) {
+            // only the last avatar frame matters
+            _avatarJson = QJsonDocument::fromBinaryData(frame->data).object();
+            _hasAvatarJson = true;
+        } else if (frame->type == audioFrameType()) {
+            _audioFrames.push_back(frame);
+        }
+    }
+
+    if (clip->positionFrameTime() == Frame::INVALID_TIME) {
+        // loop
+        clip->seekFrameTime(0);
+        _clipStartTime = now;
+    }
+}
+
+void Bot::animate(quint64 now) {
+    float deltaTime = _lastAnimateTime > 0 ? (float)(now - _lastAnimateTime) / (float)USECS_PER_SECOND : 0.0f;
+    _lastAnimateTime = now;
+
+    if (_hasAvatarJson) {
+        _avatar->fromJson(_avatarJson);
+        _hasAvatarJson = false;
+    } else if (!_hasRecording) {
+        walk(deltaTime);
+        _avatar->update(deltaTime);
+    }
+}
+
+void Bot::walk(float deltaTime) {
+    if (_walkRadius <= 0.0f) {
+        return;
+    }
+
+    _walkAngle = fmodf(_walkAngle + deltaTime * _walkSpeed / _walkRadius, TWO_PI);
+    glm::vec3 radial(cosf(_walkAngle), 0.0f, sinf(_walkAngle));
+    glm::vec3 direction(-radial.z, 0.0f, radial.x);
+
+    // avatars face -z
+    _avatar->setPosition(_walkCenter + _walkRadius * radial);
+    _avatar->setOrientation(glm::angleAxis(atan2f(-direction.x, -direction.z), Vectors::UNIT_Y));
+}
+
+void Bot::encode(bool sendAvatarData) {
+    if (sendAvatarData) {
+        QByteArray avatarByteArray = _avatar->toByteArray((_distribution(_random) < AVATAR_SEND_FULL_UPDATE_RATIO)
+                                                            ? AvatarData::SendAllData : AvatarData::CullSmallData);
+        _avatar->doneEncoding(true);
+
+        _avatarPacket = NLPacket::create(PacketType::HostedAvatarData,
+                                         NUM_BYTES_RFC4122_UUID + sizeof(_avatarSequenceNumber) + avatarByteArray.size());
+        _avatarPacket->write(_id.toRfc4122());
+        _avatarPacket->writePrimitive(_avatarSequenceNumber++);
+        _avatarPacket->write(avatarByteArray);
+    }
+
+    for (auto& frame : _audioFrames) {
+        _audioPackets.push_back(createAudioPacket(frame->data));
+    }
+    _audioFrames.clear();
+}
+
+std::unique_ptr<NLPacket> Bot::createAudioPacket(const QByteArray& audio) {
+    // the same packet as an AudioInjector, with the ID of the bot as the stream identifier
+    auto audioPacket = NLPacket::create(PacketType::InjectAudio);
+    audioPacket->writePrimitive(_audioSequenceNumber++);
+
+    // injected streams are not encoded, so there is no codec name
+    QDataStream audioPacketStream(audioPacket.get());
+    audioPacketStream << (quint32)0;
+    audioPacketStream << _id;
+
+    bool isStereo = audio.size() == AudioConstants::NETWORK_FRAME_BYTES_STEREO;
+    uchar loopbackFlag = 0;
+    audioPacketStream << isStereo << loopbackFlag;
+
+    glm::vec3 position = _avatar->getPosition();
+    glm::quat orientation = _avatar->getOrientation();
+    glm::vec3 boxCorner = glm::vec3(0);
+    audioPacketStream.writeRawData(reinterpret_cast<const char*>(&position), sizeof(position));
+    audioPacketStream.writeRawData(reinterpret_cast<const char*>(&orientation), sizeof(orientation));
+    audioPacketStream.writeRawData(reinterpret_cast<const char*>(&position), sizeof(position));
+    audioPacketStream.writeRawData(reinterpret_cast<const char*>(&boxCorner), sizeof(boxCorner));
+
+    float radius = 0.0f;
+    quint8 volume = packFloatGainToByte(1.0f);
+    bool ignorePenumbra = false;
+    audioPacketStream << radius << volume << ignorePenumbra;
+
+    audioPacket->write(audio);
+    return audioPacket;
+}
+
+void Bot::send(quint64 now, NodeList& nodeList, const SharedNodePointer& avatarMixer, const SharedNodePointer& audioMixer) {
+    if (_avatarPacket && avatarMixer) {
+        nodeList.sendUnreliablePacket(*_avatarPacket, *avatarMixer);
+
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        if (_lastAvatarSendTime > 0) {
+            quint64 gap = now - _lastAvatarSendTime;
+            _sendGaps.update(gap);
+            float deviation = fabsf((float)gap - (float)AVATAR_DATA_SEND_INTERVAL_USECS);
+            _jitter += (deviation - _jitter) * JITTER_GAIN;
+        }
+        _lastAvatarSendTime = now;
+        ++_numAvatarSends;
+    }
+    _avatarPacket.reset();
+
+    // the mixer only takes the identity of hosted avatars it has data for
+    if (avatarMixer && _numAvatarSends > 0 && now >= _nextIdentitySendTime) {
+        _avatar->sendIdentityPacket();
+        _nextIdentitySendTime = now + AVATAR_IDENTITY_SEND_INTERVAL_USECS;
+    }
+
+    if (audioMixer) {
+        for (auto& audioPacket : _audioPackets) {
+            nodeList.sendUnreliablePacket(*audioPacket, *audioMixer);
+        }
+    }
+    _audioPackets.clear();
+}
+
+QVariantMap Bot::getStats() const {
+    QVariantMap stats;
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    stats["num_avatar_sends"] = _numAvatarSends;
+    stats["avg_send_gap_usecs"] = _sendGaps.getWindowAverage();
+    stats["min_send_gap_usecs"] = _sendGaps.getWindowMin();
+    stats["max_send_gap_usecs"] = _sendGaps.getWindowMax();
+    stats["jitter_usecs"] = _jitter;
+    return stats;
+}
+
+BotHost::BotHost() {
+    _timerThread.setObjectName("Bot Host Timer");
+}
+
+BotHost::~BotHost() {
+    if (_timer) {
+        _timer->stop();
+        _timerThread.quit();
+        _timerThread.wait();
+    }
+
+    removeAllBots();
+
+    // the timer is gone, so kill the bots from here
+    std::vector<QUuid> removedBotIDs;
+    for (auto& bot : _removedBots) {
+        removedBotIDs.push_back(bot->getID());
+    }
+    sendKillAvatars(removedBotIDs);
+    _removedBots.clear();
+}
+
+QUuid BotHost::addBot(const QVariantMap& properties) {
+    using namespace recording;
+
+    QUuid botID = QUuid::createUuid();
+    auto bot = std::make_shared<Bot>(botID, properties);
+
+    QUrl recordingURL = properties["recordingURL"].toUrl();
+    if (bot->hasRecording()) {
+        // bots playing the same recording share its data
+        if (recordingURL.isLocalFile()) {
+            bot->setClip(ClipCache::instance().getFileClip(recordingURL.toLocalFile()));
+        } else {
+            auto loader = ClipCache::instance().getClipLoader(recordingURL);
+            if (loader->isLoaded()) {
+                bot->setClip(loader->getClip());
+            } else {
+                // the connection keeps the loader until it is done, or the bot host is gone
+                std::weak_ptr<Bot> weakBot = bot;
+                connect(loader.data(), &Resource::loaded, this, [weakBot, loader] {
+                    auto bot = weakBot.lock();
+                    if (bot) {
+                        bot->setClip(loader->getClip());
+                    }
+                });
+                connect(loader.data(), &Resource::failed, this, [recordingURL] {
+                    qWarning() << "Bot recording failed to load from" << recordingURL;
+                });
+            }
+        }
+    }
+
+    // the avatar lives on the timer thread, where it is animated
+    startTimer();
+    bot->getAvatar().moveToThread(&_timerThread);
+
+    {
+        std::lock_guard<std::mutex> lock(_botsMutex);
+        _bots.push_back(bot);
+    }
+    return botID;
+}
+
+void BotHost::removeBot(const QUuid& botID) {
+    std::lock_guard<std::mutex> lock(_botsMutex);
+    auto it = std::find_if(_bots.begin(), _bots.end(), [&](const BotPointer& bot) { return bot->getID() == botID; });
+    if (it != _bots.end()) {
+        _removedBots.push_back(*it);
+        _bots.erase(it);
+    }
+}
+
+void BotHost::removeAllBots() {
+    std::lock_guard<std::mutex> lock(_botsMutex);
+    _removedBots.insert(_removedBots.end(), _bots.begin(), _bots.end());
+    _bots.clear();
+}
+
+int BotHost::getCount() const {
+    std::lock_guard<std::mutex> lock(_botsMutex);
+    return (int)_bots.size();
+}
+
+QVariantMap BotHost::getStats() const {
+    std::vector<BotPointer> bots;
+    {
+        std::lock_guard<std::mutex> lock(_botsMutex);
+        bots = _bots;
+    }
+
+    QVariantMap stats;
+    for (auto& bot : bots) {
+        stats[uuidStringWithoutCurlyBraces(bot->getID())] = bot->getStats();
+    }
+    return stats;
+}
+
+void BotHost::startTimer() {
+    if (_timer) {
+        return;
+    }
+
+    // one 100Hz timer for all the bots, on its own thread
+    _timer = new AvatarAudioTimer();
+    _timer->moveToThread(&_timerThread);
+    connect(_timer, &AvatarAudioTimer::avatarTick, this, &BotHost::tick, Qt::DirectConnection);
+    connect(&_timerThread, &QThread::started, _timer, &AvatarAudioTimer::start);
+    connect(&_timerThread, &QThread::finished, _timer, &QObject::deleteLater);
+    _timerThread.start();
+}
+
+void BotHost::tick() {
+    std::vector<BotPointer> bots;
+    std::vector<BotPointer> removedBots;
+    {
+        std::lock_guard<std::mutex> lock(_botsMutex);
+        bots = _bots;
+        removedBots.swap(_removedBots);
+    }
+    if (bots.empty() && removedBots.empty()) {
+        return;
+    }
+
+    quint64 now = usecTimestampNow();
+    int sendingBots = (int)(_tickCount++ % AVATAR_DATA_TICKS);
+
+    parallelFor((int)bots.size(), [&](int i) {
+        bots[i]->readFrames(now);
+    });
+
+    for (auto& bot : bots) {
+        bot->animate(now);
+    }
+
+    parallelFor((int)bots.size(), [&](int i) {
+        bots[i]->encode(i % AVATAR_DATA_TICKS == sendingBots);
+    });
+
+    // send from here, so that the packets of a bot keep their order
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer && !avatarMixer->getActiveSocket()) {
+        avatarMixer.clear();
+    }
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (audioMixer && !audioMixer->getActiveSocket()) {
+        audioMixer.clear();
+    }
+
+    for (auto& bot : bots) {
+        bot->send(now, *nodeList, avatarMixer, audioMixer);
+    }
+
+    // removed bots are killed after their last data
+    if (!removedBots.empty()) {
+        std::vector<QUuid> removedBotIDs;
+        for (auto& bot : removedBots) {
+            removedBotIDs.push_back(bot->getID());
+        }
+        sendKillAvatars(removedBotIDs);
+    }
+}
+
+void BotHost::sendKillAvatars(const std::vector<QUuid>& botIDs) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (!avatarMixer || !avatarMixer->getActiveSocket()) {
+        return;
+    }
+
+    for (auto& botID : botIDs) {
+        auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
+        packet->write(botID.toRfc4122());
+        packet->writePrimitive(KillAvatarReason::NoReason);
+        nodeList->sendPacket(std::move(packet), *avatarMixer);
+    }
+}
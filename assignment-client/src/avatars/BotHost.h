@@ -0,0 +1,68 @@
+//
+//  BotHost.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BotHost_h
+#define hifi_BotHost_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtCore/QUuid>
+#include <QtCore/QVariantMap>
+
+#include <DependencyManager.h>
+
+class AvatarAudioTimer;
+class Bot;
+
+/// Drives many avatars from one agent, for load testing a domain. Each bot plays a recording, or walks in a circle,
+/// with an avatar ID of its own. The bots share the node, socket and timer of the agent: the avatar mixer broadcasts
+/// them as avatars hosted by the agent (HostedAvatarData packets), and the recorded audio of each goes to the audio
+/// mixer as an injected stream. Every 10ms tick the bots are encoded on the global thread pool, then sent in order.
+class BotHost : public QObject, public Dependency {
+    Q_OBJECT
+    Q_PROPERTY(int count READ getCount)
+
+public:
+    BotHost();
+    ~BotHost();
+
+    /// Adds a bot and returns its avatar ID. The properties are all optional:
+    /// recordingURL, position, skeletonModelURL, displayName,
+    /// and for bots without a recording animationURL, walkRadius (meters) and walkSpeed (meters per second)
+    Q_INVOKABLE QUuid addBot(const QVariantMap& properties = QVariantMap());
+    Q_INVOKABLE void removeBot(const QUuid& botID);
+    Q_INVOKABLE void removeAllBots();
+
+    int getCount() const;
+
+    /// The stats of each bot, by avatar ID, in particular the jitter of its avatar data sends
+    Q_INVOKABLE QVariantMap getStats() const;
+
+private:
+    using BotPointer = std::shared_ptr<Bot>;
+
+    void tick();
+    void startTimer();
+    void sendKillAvatars(const std::vector<QUuid>& botIDs);
+
+    mutable std::mutex _botsMutex;
+    std::vector<BotPointer> _bots;
+    std::vector<BotPointer> _removedBots; // killed from the timer thread, after their last data was sent
+
+    QThread _timerThread;
+    AvatarAudioTimer* _timer { nullptr };
+    quint64 _tickCount { 0 };
+};
+
+#endif // hifi_BotHost_h
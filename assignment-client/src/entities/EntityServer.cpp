@@ -27,8 +27,9 @@ EntityServer::EntityServer(ReceivedMessage& message) :
     _entitySimulation(NULL)
 {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::EntityAdd, PacketType::EntityEdit, PacketType::EntityErase },
-                                            this, "handleEntityPacket");
+    // edits only go to the inbound packet processor's queue, so there is no need to go through our thread
+    packetReceiver.registerHandlerForTypes({ PacketType::EntityAdd, PacketType::EntityEdit, PacketType::EntityErase },
+                                           this, &EntityServer::handleEntityPacket);
 }
 
 EntityServer::~EntityServer() {
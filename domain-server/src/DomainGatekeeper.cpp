@@ -270,6 +270,7 @@ void DomainGatekeeper::updateNodePermissions() {
             userPerms.permissions |= NodePermissions::Permission::canRezPermanentEntities;
             userPerms.permissions |= NodePermissions::Permission::canRezTemporaryEntities;
             userPerms.permissions |= NodePermissions::Permission::canWriteToAssetServer;
+            userPerms.permissions |= NodePermissions::Permission::canHostAvatars;
         } else {
             // this node is an agent
             const QHostAddress& addr = node->getLocalSocket().getAddress();
@@ -293,6 +294,7 @@ void DomainGatekeeper::updateNodePermissions() {
         }
 
         node->setPermissions(userPerms);
+        _server->updateDomainListEntry(node);
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
@@ -358,6 +360,8 @@ SharedNodePointer DomainGatekeeper::processAssignmentConnectRequest(const NodeCo
     userPerms.permissions |= NodePermissions::Permission::canRezPermanentEntities;
     userPerms.permissions |= NodePermissions::Permission::canRezTemporaryEntities;
     userPerms.permissions |= NodePermissions::Permission::canWriteToAssetServer;
+    // and to host avatars, as the bots of an agent do
+    userPerms.permissions |= NodePermissions::Permission::canHostAvatars;
     newNode->setPermissions(userPerms);
     return newNode;
 }
@@ -18,6 +18,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QMessageAuthenticationCode>
 #include <QProcess>
 #include <QSharedMemory>
 #include <QStandardPaths>
@@ -839,6 +840,7 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // update this node's sockets in case they have changed
     sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
     sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    updateDomainListEntry(sendingNode);
     
     // update the NodeInterestSet in case there have been any changes
     DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
@@ -849,12 +851,17 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
-    nodeData->setNodeInterestSet(safeInterestSet);
+    if (safeInterestSet != nodeData->getNodeInterestSet()) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+
+        // the list this node holds is missing the nodes it was not interested in
+        nodeData->setMinimumListBaseEpoch(++_domainListEpoch);
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    sendDomainListToNode(sendingNode, message->getSenderSockAddr(), nodeRequestData.listEpoch);
 }
 
 unsigned int DomainServer::countConnectedUsers() {
@@ -914,6 +921,8 @@ QUrl DomainServer::oauthAuthorizationURL(const QUuid& stateUUID) {
 void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(newNode->getLinkedData());
 
+    updateDomainListEntry(newNode);
+
     // reply back to the user with a PacketType::DomainList
     sendDomainListToNode(newNode, nodeData->getSendingSockAddr());
 
@@ -926,27 +935,44 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr,
+                                        quint32 baseEpoch) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+
+    DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(node->getLinkedData());
+
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // serialize the entries not serialized yet first, so that the epoch in the header covers what they bump it to
+    limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
+        auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+        if (otherNodeData && otherNodeData->getListEntry().isEmpty()) {
+            updateDomainListEntry(otherNode);
+        }
+    });
+
+    // only send what changed since the list the node holds, if we can still tell what that is
+    bool isDelta = baseEpoch != 0 && baseEpoch <= _domainListEpoch
+        && baseEpoch >= _minimumListBaseEpoch && baseEpoch >= nodeData->getMinimumListBaseEpoch();
+    if (!isDelta) {
+        baseEpoch = 0;
+    }
     
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
-   
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-    
+
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getPermissions();
+    extendedHeaderStream << _domainListEpoch << baseEpoch;
 
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(node->getLinkedData());
-
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
@@ -954,16 +980,33 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
 
         // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
         if (nodeData->isAuthenticated()) {
+            if (isDelta) {
+                // the nodes removed since, newest first - the node ignores any it never heard of
+                for (auto it = _removedNodes.rbegin(); it != _removedNodes.rend() && it->first > baseEpoch; ++it) {
+                    domainListPackets->startSegment();
+                    domainListStream << (quint8)DomainListEntry::RemovedNode << it->second;
+                    domainListPackets->endSegment();
+                }
+            }
+
             // if this authenticated node has any interest types, send back those nodes as well
             limitedNodeList->eachNode([&](const SharedNodePointer& otherNode){
                 if (otherNode->getUUID() != node->getUUID()
                     && nodeInterestSet.contains(otherNode->getType())) {
+
+                    // skip the nodes that have not changed since the list the node holds
+                    auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                    if (otherNodeData->getListEntryEpoch() <= baseEpoch || otherNodeData->getListEntry().isEmpty()) {
+                        return;
+                    }
                     
                     // since we're about to add a node to the packet we start a segment
                     domainListPackets->startSegment();
 
                     // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+                    const QByteArray& listEntry = otherNodeData->getListEntry();
+                    domainListStream << (quint8)DomainListEntry::Node;
+                    domainListStream.writeRawData(listEntry.constData(), listEntry.size());
 
                     // pack the secret that these two nodes will use to communicate with each other
                     domainListStream << connectionSecretForNodes(node, otherNode);
@@ -975,29 +1018,47 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
         }
     }
     
-    // send an empty list to the node, in case there were no other nodes
+    // send an empty list to the node, in case there were no other nodes (or no changes)
     domainListPackets->closeCurrentPacket(true);
 
     // write the PacketList to this node
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
 }
 
-QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
+void DomainServer::updateDomainListEntry(const SharedNodePointer& node) {
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (!nodeData) {
+        return;
+    }
+
+    QByteArray listEntry;
+    QDataStream listEntryStream(&listEntry, QIODevice::WriteOnly);
+    listEntryStream << *node.data();
+
+    if (listEntry != nodeData->getListEntry()) {
+        nodeData->setListEntry(listEntry, ++_domainListEpoch);
+    }
+}
+
+QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) const {
     DomainServerNodeData* nodeAData = dynamic_cast<DomainServerNodeData*>(nodeA->getLinkedData());
     DomainServerNodeData* nodeBData = dynamic_cast<DomainServerNodeData*>(nodeB->getLinkedData());
 
     if (nodeAData && nodeBData) {
-        QUuid& secretUUID = nodeAData->getSessionSecretHash()[nodeB->getUUID()];
-
-        if (secretUUID.isNull()) {
-            // generate a new secret UUID these two nodes can use
-            secretUUID = QUuid::createUuid();
-
-            // set it on the other Node's sessionSecretHash
-            reinterpret_cast<DomainServerNodeData*>(nodeBData)->getSessionSecretHash().insert(nodeA->getUUID(), secretUUID);
+        // rather than storing a secret per pair of nodes, the secret is an HMAC of the seeds of both nodes
+        // under a key only the domain-server knows, so the state is per node and nothing is kept per pair.
+        // The seeds are ordered so both nodes get the same secret, and a node that reconnects gets a new seed.
+        QByteArray seedA = nodeAData->getConnectionSecretSeed().toRfc4122();
+        QByteArray seedB = nodeBData->getConnectionSecretSeed().toRfc4122();
+        if (seedB < seedA) {
+            std::swap(seedA, seedB);
         }
 
-        return secretUUID;
+        QMessageAuthenticationCode hmac(QCryptographicHash::Sha256, _connectionSecretKey);
+        hmac.addData(seedA);
+        hmac.addData(seedB);
+
+        return QUuid::fromRfc4122(hmac.result().left(NUM_BYTES_RFC4122_UUID));
     }
 
     return QUuid();
@@ -2158,6 +2219,14 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.removeICEPeer(node->getUUID());
 
+    // remember the removal for the domain list deltas, for a while
+    static const size_t MAX_REMOVED_NODES = 1024;
+    _removedNodes.emplace_back(++_domainListEpoch, node->getUUID());
+    while (_removedNodes.size() > MAX_REMOVED_NODES) {
+        _minimumListBaseEpoch = _removedNodes.front().first;
+        _removedNodes.pop_front();
+    }
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
@@ -2170,14 +2239,6 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
             }
         }
 
-        // cleanup the connection secrets that we set up for this node (on the other nodes)
-        foreach (const QUuid& otherNodeSessionUUID, nodeData->getSessionSecretHash().keys()) {
-            SharedNodePointer otherNode = DependencyManager::get<LimitedNodeList>()->nodeWithUUID(otherNodeSessionUUID);
-            if (otherNode) {
-                static_cast<DomainServerNodeData*>(otherNode->getLinkedData())->getSessionSecretHash().remove(node->getUUID());
-            }
-        }
-
         if (node->getType() == NodeType::Agent) {
             // if this node was an Agent ask DomainServerNodeData to remove the interpolation we potentially stored
             nodeData->removeOverrideForKey(USERNAME_UUID_REPLACEMENT_STATS_KEY,
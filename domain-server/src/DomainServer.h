@@ -21,6 +21,8 @@
 #include <QtCore/QUrl>
 #include <QAbstractNativeEventFilter>
 
+#include <deque>
+
 #include <Assignment.h>
 #include <HTTPSConnection.h>
 #include <LimitedNodeList.h>
@@ -130,9 +132,13 @@ private:
 
     void handleKillNode(SharedNodePointer nodeToKill);
 
-    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr);
+    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr, quint32 baseEpoch = 0);
+
+    // re-serializes the domain list entry for this node, and moves it to a new epoch if it changed
+    void updateDomainListEntry(const SharedNodePointer& node);
 
-    QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
+    // derives the secret two nodes use to communicate with each other, the same whichever order they are passed in
+    QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) const;
     void broadcastNewNode(const SharedNodePointer& node);
 
     void parseAssignmentConfigs(QSet<Assignment::Type>& excludedTypes);
@@ -214,6 +220,14 @@ private:
 
     bool _sendICEServerAddressToMetaverseAPIInProgress { false };
     bool _sendICEServerAddressToMetaverseAPIRedo { false };
+
+    // domain lists are versioned, so that a node is only sent what changed since the list it holds
+    quint32 _domainListEpoch { 0 };
+    std::deque<std::pair<quint32, QUuid>> _removedNodes;    // recent removals and their epochs
+    quint32 _minimumListBaseEpoch { 0 };                   // before this, removals have been forgotten
+
+    // key for deriving connection secrets from the secret seeds of the two nodes, random per run
+    QByteArray _connectionSecretKey { QUuid::createUuid().toRfc4122() + QUuid::createUuid().toRfc4122() };
 };
 
 
@@ -46,7 +46,8 @@ public:
     void setIsAuthenticated(bool isAuthenticated) { _isAuthenticated = isAuthenticated; }
     bool isAuthenticated() const { return _isAuthenticated; }
 
-    QHash<QUuid, QUuid>& getSessionSecretHash() { return _sessionSecretHash; }
+    // random per node session, the connection secrets between this node and others are derived from it
+    const QUuid& getConnectionSecretSeed() const { return _connectionSecretSeed; }
 
     const NodeSet& getNodeInterestSet() const { return _nodeInterestSet; }
     void setNodeInterestSet(const NodeSet& nodeInterestSet) { _nodeInterestSet = nodeInterestSet; }
@@ -68,12 +69,21 @@ public:
 
     bool wasAssigned() const { return _wasAssigned; };
     void setWasAssigned(bool wasAssigned) { _wasAssigned = wasAssigned; }
+
+    // this node as serialized in the domain lists of other nodes, and the list epoch it last changed at
+    const QByteArray& getListEntry() const { return _listEntry; }
+    quint32 getListEntryEpoch() const { return _listEntryEpoch; }
+    void setListEntry(const QByteArray& listEntry, quint32 epoch) { _listEntry = listEntry; _listEntryEpoch = epoch; }
+
+    // a domain list sent to this node can only be a delta from this epoch or a later one
+    quint32 getMinimumListBaseEpoch() const { return _minimumListBaseEpoch; }
+    void setMinimumListBaseEpoch(quint32 epoch) { _minimumListBaseEpoch = epoch; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
     QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
     
-    QHash<QUuid, QUuid> _sessionSecretHash;
+    QUuid _connectionSecretSeed { QUuid::createUuid() };
     QUuid _assignmentUUID;
     QUuid _walletUUID;
     QString _username;
@@ -93,6 +103,10 @@ private:
     QString _placeName;
 
     bool _wasAssigned { false };
+
+    QByteArray _listEntry;
+    quint32 _listEntryEpoch { 0 };
+    quint32 _minimumListBaseEpoch { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
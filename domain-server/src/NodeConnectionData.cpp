@@ -41,6 +41,11 @@ NodeConnectionData NodeConnectionData::fromDataStream(QDataStream& dataStream, c
         >> newHeader.publicSockAddr >> newHeader.localSockAddr
         >> newHeader.interestList >> newHeader.placeName;
 
+    if (!isConnectRequest) {
+        // the epoch of the domain list this node holds, so that only what changed since is sent back
+        dataStream >> newHeader.listEpoch;
+    }
+
     newHeader.senderSockAddr = senderSockAddr;
     
     if (newHeader.publicSockAddr.getAddress().isNull()) {
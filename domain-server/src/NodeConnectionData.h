@@ -30,6 +30,7 @@ public:
     QString placeName;
     QString hardwareAddress;
     QUuid machineFingerprint;
+    quint32 listEpoch { 0 };
 
     QByteArray protocolVersion;
 };
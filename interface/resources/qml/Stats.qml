@@ -54,6 +54,10 @@ Item {
                     StatText {
                         text: "Avatars: " + root.avatarCount
                     }
+                    StatText {
+                        text: "Animated Avatars: " + root.animatedAvatarCount +
+                            " (" + root.avatarAnimationTime.toFixed(2) + " ms)"
+                    }
                     StatText {
                         text: "Frame Rate: " + root.framerate.toFixed(2);
                     }
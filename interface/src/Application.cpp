@@ -1296,6 +1296,10 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         auto loadingRequests = ResourceCache::getLoadingRequests();
         properties["active_downloads"] = loadingRequests.size();
         properties["pending_downloads"] = ResourceCache::getPendingRequestCount();
+        properties["download_limit"] = ResourceCache::getCurrentRequestLimit();
+        properties["download_queue_ms"] = ResourceCache::getAverageQueueTimeMsecs();
+        properties["download_usable_ms"] = ResourceCache::getAverageUsableTimeMsecs();
+        properties["download_kbps"] = ResourceCache::getThroughputKbps();
 
         properties["throttled"] = _displayPlugin ? _displayPlugin->isThrottled() : false;
 
@@ -3316,7 +3320,12 @@ void Application::idle(float nsecsElapsed) {
     PROFILE_COUNTER(app, "fps", { { "fps", _frameCounter.rate() } });
     PROFILE_COUNTER(app, "downloads", {
         { "current", ResourceCache::getLoadingRequests().length() },
-        { "pending", ResourceCache::getPendingRequestCount() }
+        { "pending", ResourceCache::getPendingRequestCount() },
+        { "limit", ResourceCache::getCurrentRequestLimit() }
+    });
+    PROFILE_COUNTER(app, "downloadTimes", {
+        { "queue_ms", ResourceCache::getAverageQueueTimeMsecs() },
+        { "usable_ms", ResourceCache::getAverageUsableTimeMsecs() }
     });
     PROFILE_COUNTER(app, "processing", {
         { "current", DependencyManager::get<StatTracker>()->getStat("Processing") },
@@ -4399,6 +4408,11 @@ void Application::update(float deltaTime) {
         _postUpdateLambdas.clear();
     }
 
+    {
+        PROFILE_RANGE_EX(app, "ClusterMatrices", 0xffff0000, (uint64_t)0);
+        Model::updatePendingClusterMatrices();
+    }
+
     AnimDebugDraw::getInstance().update();
 }
 
@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <atomic>
 #include <vector>
 
 #include <QDesktopWidget>
@@ -58,6 +59,8 @@ const float DISPLAYNAME_FADE_TIME = 0.5f;
 const float DISPLAYNAME_FADE_FACTOR = pow(0.01f, 1.0f / DISPLAYNAME_FADE_TIME);
 const float DISPLAYNAME_ALPHA = 1.0f;
 const float DISPLAYNAME_BACKGROUND_ALPHA = 0.4f;
+// avatars load ahead of any entity, whose priority is its angular size (at most PI / 2)
+const float AVATAR_LOADING_PRIORITY = 4.0f;
 const glm::vec3 HAND_TO_PALM_OFFSET(0.0f, 0.12f, 0.08f);
 
 namespace render {
@@ -76,8 +79,9 @@ namespace render {
     }
 }
 
-static uint64_t timeProcessingJoints = 0;
-static int32_t numJointsProcessed = 0;
+// summed over the skeletons of all avatars, which may be updated as parallel jobs
+static std::atomic<uint64_t> timeProcessingJoints { 0 };
+static std::atomic<int32_t> numJointsProcessed { 0 };
 
 float Avatar::getNumJointsProcessedPerSecond() {
     float rate = 0.0f;
@@ -112,6 +116,7 @@ Avatar::Avatar(RigPointer rig) :
     _headData = static_cast<HeadData*>(new Head(this));
 
     _skeletonModel = std::make_shared<SkeletonModel>(this, nullptr, rig);
+    _skeletonModel->setLoadingPriority(AVATAR_LOADING_PRIORITY);
     connect(_skeletonModel.get(), &Model::setURLFinished, this, &Avatar::setModelURLFinished);
 
     auto geometryCache = DependencyManager::get<GeometryCache>();
@@ -299,6 +304,18 @@ void Avatar::setShouldDie() {
 }
 
 void Avatar::simulate(float deltaTime) {
+    beginSimulate(deltaTime);
+    simulateSkeleton();
+    endSimulate(deltaTime);
+}
+
+// the joints of avatars this far from the camera are updated every few frames
+static const float REDUCED_JOINT_RATE_DISTANCE = 20.0f; // meters
+static const float MINIMUM_JOINT_RATE_DISTANCE = 40.0f; // meters
+static const int REDUCED_JOINT_RATE_INTERVAL = 2; // frames
+static const int MINIMUM_JOINT_RATE_INTERVAL = 4; // frames
+
+void Avatar::beginSimulate(float deltaTime) {
     PerformanceTimer perfTimer("simulate");
 
     if (!isDead() && !_motionState) {
@@ -334,39 +351,74 @@ void Avatar::simulate(float deltaTime) {
                 _shouldAnimate = false;
                 qCDebug(interfaceapp) << "Optimizing" << (isMyAvatar() ? "myself" : getSessionUUID()) << "for visibility" << visibility;
             }
+            _distanceToCamera = glm::distance(viewFrustum.getPosition(), getPosition());
         }
     }
 
-    uint64_t start = usecTimestampNow();
+    _deltaTime = deltaTime;
     // CRUFT? _shouldSkipRender is never set 'true'
-    if (_shouldAnimate && avatarInView && !_shouldSkipRender) {
-        {
-            PerformanceTimer perfTimer("skeleton");
-            _skeletonModel->getRig()->copyJointsFromJointData(_jointData);
-            _skeletonModel->simulate(deltaTime, _hasNewJointRotations || _hasNewJointTranslations);
-            locationChanged(); // joints changed, so if there are any children, update them.
-            _hasNewJointRotations = false;
-            _hasNewJointTranslations = false;
-        }
-        {
-            PerformanceTimer perfTimer("head");
-            glm::vec3 headPosition = getPosition();
-            if (!_skeletonModel->getHeadPosition(headPosition)) {
-                headPosition = getPosition();
-            }
-            Head* head = getHead();
-            head->setPosition(headPosition);
-            head->setScale(getUniformScale());
-            head->simulate(deltaTime, false, !_shouldAnimate);
+    _animateSkeleton = _shouldAnimate && avatarInView && !_shouldSkipRender;
+    if (_animateSkeleton) {
+        _skeletonDeltaTime += deltaTime;
+        int interval = 1;
+        if (_distanceToCamera > MINIMUM_JOINT_RATE_DISTANCE) {
+            interval = MINIMUM_JOINT_RATE_INTERVAL;
+        } else if (_distanceToCamera > REDUCED_JOINT_RATE_DISTANCE) {
+            interval = REDUCED_JOINT_RATE_INTERVAL;
         }
+        _updateJoints = (++_framesSinceJointsUpdate >= interval);
     } else {
         // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+        _updateJoints = false;
+        // don't let the time spent out of view reach the skeleton as one long step when it comes back
+        _skeletonDeltaTime = 0.0f;
         getHead()->setPosition(getPosition());
+    }
+}
+
+bool Avatar::canSimulateSkeletonInParallel() const {
+    // until its joints are set up, simulating the model loads the skeleton, which emits signals
+    return !_skeletonModel->isLoaded() || !_skeletonModel->getRig()->jointStatesEmpty() ||
+        _skeletonModel->getFBXGeometry().joints.isEmpty();
+}
+
+void Avatar::simulateSkeleton() {
+    uint64_t start = usecTimestampNow();
+    if (_updateJoints) {
+        PerformanceTimer perfTimer("skeleton");
+        _skeletonModel->getRig()->copyJointsFromJointData(_jointData);
+        _skeletonModel->simulate(_skeletonDeltaTime, _hasNewJointRotations || _hasNewJointTranslations);
+        _hasNewJointRotations = false;
+        _hasNewJointTranslations = false;
+        _skeletonDeltaTime = 0.0f;
+        _framesSinceJointsUpdate = 0;
+        numJointsProcessed += _jointData.size();
+    } else {
+        // the joints are left as they were, only the transform of the model moves with the avatar
         PerformanceTimer perfTimer("skeleton");
-        _skeletonModel->simulate(deltaTime, false);
+        _skeletonModel->simulate(_deltaTime, false);
+    }
+    _lastSkeletonTime = usecTimestampNow() - start;
+    timeProcessingJoints += _lastSkeletonTime;
+}
+
+void Avatar::endSimulate(float deltaTime) {
+    PerformanceTimer perfTimer("simulate");
+
+    if (_animateSkeleton) {
+        if (_updateJoints) {
+            locationChanged(); // joints changed, so if there are any children, update them.
+        }
+        PerformanceTimer perfTimer("head");
+        glm::vec3 headPosition = getPosition();
+        if (!_skeletonModel->getHeadPosition(headPosition)) {
+            headPosition = getPosition();
+        }
+        Head* head = getHead();
+        head->setPosition(headPosition);
+        head->setScale(getUniformScale());
+        head->simulate(deltaTime, false, !_shouldAnimate);
     }
-    timeProcessingJoints += usecTimestampNow() - start;
-    numJointsProcessed += _jointData.size();
 
     // update animation for display name fade in/out
     if ( _displayNameTargetAlpha != _displayNameAlpha) {
@@ -1036,12 +1088,15 @@ void Avatar::setModelURLFinished(bool success) {
 
 // create new model, can return an instance of a SoftAttachmentModel rather then Model
 static std::shared_ptr<Model> allocateAttachmentModel(bool isSoft, RigPointer rigOverride) {
+    std::shared_ptr<Model> model;
     if (isSoft) {
         // cast to std::shared_ptr<Model>
-        return std::dynamic_pointer_cast<Model>(std::make_shared<SoftAttachmentModel>(std::make_shared<Rig>(), nullptr, rigOverride));
+        model = std::dynamic_pointer_cast<Model>(std::make_shared<SoftAttachmentModel>(std::make_shared<Rig>(), nullptr, rigOverride));
     } else {
-        return std::make_shared<Model>(std::make_shared<Rig>());
+        model = std::make_shared<Model>(std::make_shared<Rig>());
     }
+    model->setLoadingPriority(AVATAR_LOADING_PRIORITY);
+    return model;
 }
 
 void Avatar::setAttachmentData(const QVector<AttachmentData>& attachmentData) {
@@ -68,6 +68,17 @@ public:
     void init();
     void updateAvatarEntities();
     void simulate(float deltaTime);
+
+    // simulate() in three steps, so the skeletons of many avatars can be updated as parallel jobs:
+    // beginSimulate and endSimulate run on the main thread, simulateSkeleton touches only this avatar
+    // once canSimulateSkeletonInParallel() is true (before that, loading the skeleton emits signals)
+    void beginSimulate(float deltaTime);
+    void simulateSkeleton();
+    void endSimulate(float deltaTime);
+    bool canSimulateSkeletonInParallel() const;
+    bool isAnimatingSkeleton() const { return _animateSkeleton; }
+    quint64 getLastSkeletonTime() const { return _lastSkeletonTime; } // usecs spent in the last simulateSkeleton
+
     virtual void simulateAttachments(float deltaTime);
 
     virtual void render(RenderArgs* renderArgs, const glm::vec3& cameraPosition);
@@ -266,6 +277,15 @@ private:
     bool _initialized;
     bool _shouldAnimate { true };
     bool _shouldSkipRender { false };
+
+    // the level of detail of the skeleton, picked by beginSimulate
+    bool _animateSkeleton { false }; // in view and close enough to animate at all
+    bool _updateJoints { false }; // distant avatars update their joints every few frames
+    float _distanceToCamera { 0.0f };
+    int _framesSinceJointsUpdate { 0 };
+    float _skeletonDeltaTime { 0.0f }; // since the joints were last updated
+    float _deltaTime { 0.0f };
+    quint64 _lastSkeletonTime { 0 };
     bool _isLookAtTarget { false };
     bool _inScene { false };
 
@@ -29,6 +29,7 @@
 #include <PerfStat.h>
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
+#include <shared/ParallelFor.h>
 #include <SettingHandle.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
@@ -152,6 +153,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     auto hashCopy = getHashCopy();
 
     uint64_t start = usecTimestampNow();
+    std::vector<std::shared_ptr<Avatar>> simulatedAvatars;
     AvatarHash::iterator avatarIterator = hashCopy.begin();
     while (avatarIterator != hashCopy.end()) {
         auto avatar = std::static_pointer_cast<Avatar>(avatarIterator.value());
@@ -165,12 +167,43 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             ++avatarIterator;
         } else {
             avatar->ensureInScene(avatar);
-            avatar->simulate(deltaTime);
+            avatar->beginSimulate(deltaTime);
+            simulatedAvatars.push_back(avatar);
             ++avatarIterator;
+        }
+    }
+
+    // the skeletons only touch their own avatar, so they are updated as parallel jobs,
+    // except for those loading their skeleton this frame
+    {
+        PerformanceTimer perfTimer("skeletons");
+        std::vector<Avatar*> parallelAvatars;
+        parallelAvatars.reserve(simulatedAvatars.size());
+        for (auto& avatar : simulatedAvatars) {
+            if (avatar->canSimulateSkeletonInParallel()) {
+                parallelAvatars.push_back(avatar.get());
+            } else {
+                avatar->simulateSkeleton();
+            }
+        }
+        parallelFor((int)parallelAvatars.size(), [&](int i) {
+            parallelAvatars[i]->simulateSkeleton();
+        });
+    }
+
+    int animatedAvatarCount = 0;
+    quint64 avatarAnimationTime = 0;
+    for (auto& avatar : simulatedAvatars) {
+        avatar->endSimulate(deltaTime);
+        avatar->updateRenderItem(pendingChanges);
 
-            avatar->updateRenderItem(pendingChanges);
+        if (avatar->isAnimatingSkeleton()) {
+            animatedAvatarCount++;
         }
+        avatarAnimationTime += avatar->getLastSkeletonTime();
     }
+    _animatedAvatarCount = animatedAvatarCount;
+    _avatarAnimationTime = (float)avatarAnimationTime / (float)USECS_PER_MSEC;
     qApp->getMain3DScene()->enqueuePendingChanges(pendingChanges);
 
     // simulate avatar fades
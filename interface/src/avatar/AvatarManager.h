@@ -77,6 +77,11 @@ public:
 
     float getMyAvatarSendRate() const { return _myAvatarSendRate.rate(); }
 
+    // of the other avatars in the last update: how many had their skeletons animated,
+    // and the msecs spent on all their skeletons, summed over the threads they were updated on
+    int getAnimatedAvatarCount() const { return _animatedAvatarCount; }
+    float getAvatarAnimationTime() const { return _avatarAnimationTime; }
+
 public slots:
     void setShouldShowReceiveStats(bool shouldShowReceiveStats) { _shouldShowReceiveStats = shouldShowReceiveStats; }
     void updateAvatarRenderStatus(bool shouldRenderAvatars);
@@ -111,6 +116,9 @@ private:
 
     RateCounter<> _myAvatarSendRate;
 
+    int _animatedAvatarCount { 0 };
+    float _avatarAnimationTime { 0.0f };
+
 };
 
 Q_DECLARE_METATYPE(AvatarManager::LocalLight)
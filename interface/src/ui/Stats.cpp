@@ -121,6 +121,8 @@ void Stats::updateStats(bool force) {
     auto avatarManager = DependencyManager::get<AvatarManager>();
     // we need to take one avatar out so we don't include ourselves
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
+    STAT_UPDATE(animatedAvatarCount, avatarManager->getAnimatedAvatarCount());
+    STAT_UPDATE_FLOAT(avatarAnimationTime, avatarManager->getAvatarAnimationTime(), 0.01f);
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE(framerate, qApp->getFps());
     if (qApp->getActiveDisplayPlugin()) {
@@ -213,7 +215,7 @@ void Stats::updateStats(bool force) {
 
         auto loadingRequests = ResourceCache::getLoadingRequests();
         STAT_UPDATE(downloads, loadingRequests.size());
-        STAT_UPDATE(downloadLimit, ResourceCache::getRequestLimit())
+        STAT_UPDATE(downloadLimit, ResourceCache::getCurrentRequestLimit())
         STAT_UPDATE(downloadsPending, ResourceCache::getPendingRequestCount());
 
         // See if the active download urls have changed
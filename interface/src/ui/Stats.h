@@ -46,6 +46,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, simrate, 0)
     STATS_PROPERTY(int, avatarSimrate, 0)
     STATS_PROPERTY(int, avatarCount, 0)
+    STATS_PROPERTY(int, animatedAvatarCount, 0)
+    STATS_PROPERTY(float, avatarAnimationTime, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -150,6 +152,8 @@ signals:
     void simrateChanged();
     void avatarSimrateChanged();
     void avatarCountChanged();
+    void animatedAvatarCountChanged();
+    void avatarAnimationTimeChanged();
     void packetInCountChanged();
     void packetOutCountChanged();
     void mbpsInChanged();
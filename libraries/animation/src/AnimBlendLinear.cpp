@@ -58,8 +58,8 @@ void AnimBlendLinear::evaluateAndBlendChildren(const AnimVariantMap& animVars, T
         _poses = _children[prevPoseIndex]->evaluate(animVars, dt, triggersOut);
     } else {
         // need to eval and blend between two children.
-        auto prevPoses = _children[prevPoseIndex]->evaluate(animVars, dt, triggersOut);
-        auto nextPoses = _children[nextPoseIndex]->evaluate(animVars, dt, triggersOut);
+        const AnimPoseVec& prevPoses = _children[prevPoseIndex]->evaluate(animVars, dt, triggersOut);
+        const AnimPoseVec& nextPoses = _children[nextPoseIndex]->evaluate(animVars, dt, triggersOut);
 
         if (prevPoses.size() > 0 && prevPoses.size() == nextPoses.size()) {
             _poses.resize(prevPoses.size());
@@ -70,8 +70,8 @@ void AnimBlendLinearMove::evaluateAndBlendChildren(const AnimVariantMap& animVar
         _poses = _children[prevPoseIndex]->evaluate(animVars, prevDeltaTime, triggersOut);
     } else {
         // need to eval and blend between two children.
-        auto prevPoses = _children[prevPoseIndex]->evaluate(animVars, prevDeltaTime, triggersOut);
-        auto nextPoses = _children[nextPoseIndex]->evaluate(animVars, nextDeltaTime, triggersOut);
+        const AnimPoseVec& prevPoses = _children[prevPoseIndex]->evaluate(animVars, prevDeltaTime, triggersOut);
+        const AnimPoseVec& nextPoses = _children[nextPoseIndex]->evaluate(animVars, nextDeltaTime, triggersOut);
 
         if (prevPoses.size() > 0 && prevPoses.size() == nextPoses.size()) {
             _poses.resize(prevPoses.size());
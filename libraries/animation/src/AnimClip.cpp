@@ -50,11 +50,11 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
         _networkAnim.reset();
     }
 
-    if (_anim.size()) {
+    if (_clip && _clip->getFrameCount() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
-            buildMirrorAnim();
+        if (_mirrorFlag && !_mirrorClip) {
+            buildMirrorClip();
         }
 
         int prevIndex = (int)glm::floor(_frame);
@@ -67,15 +67,20 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _clip->getFrameCount();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
-        float alpha = glm::fract(_frame);
+        const AnimCompressedClip& clip = _mirrorFlag ? *_mirrorClip : *_clip;
+        if (prevIndex == nextIndex) {
+            clip.sampleFrame(prevIndex, _poses);
+        } else {
+            clip.sampleFrame(prevIndex, _prevPoses);
+            clip.sampleFrame(nextIndex, _nextPoses);
+            float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+            ::blend(_poses.size(), &_prevPoses[0], &_nextPoses[0], alpha, &_poses[0]);
+        }
     }
 
     return _poses;
@@ -96,14 +101,28 @@ void AnimClip::setCurrentFrameInternal(float frame) {
 
 void AnimClip::copyFromNetworkAnim() {
     assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
+
+    const auto skeletonJointCount = _skeleton->getNumJoints();
+    _poses.resize(skeletonJointCount);
+    _prevPoses.resize(skeletonJointCount);
+    _nextPoses.resize(skeletonJointCount);
+
+    // mirrorClip will be re-built on demand, if needed.
+    _mirrorClip.reset();
+
+    // another clip may have baked this animation for an equal skeleton already.
+    auto animCache = DependencyManager::get<AnimationCache>();
+    _bakedClipKey = _skeleton->getSignature() + _url.toUtf8() + (usePreAndPostPoseFromAnim ? "/prepost" : "/bind");
+    _clip = animCache->getBakedClip(_bakedClipKey);
+    if (_clip) {
+        return;
+    }
 
     // build a mapping from animation joint indices to skeleton joint indices.
     // by matching joints with the same name.
     const FBXGeometry& geom = _networkAnim->getGeometry();
     AnimSkeleton animSkeleton(geom);
     const auto animJointCount = animSkeleton.getNumJoints();
-    const auto skeletonJointCount = _skeleton->getNumJoints();
     std::vector<int> jointMap;
     jointMap.reserve(animJointCount);
     for (int i = 0; i < animJointCount; i++) {
@@ -115,7 +134,8 @@ void AnimClip::copyFromNetworkAnim() {
     }
 
     const int frameCount = geom.animationFrames.size();
-    _anim.resize(frameCount);
+    // anim[frame][joint]
+    std::vector<AnimPoseVec> anim(frameCount);
 
     for (int frame = 0; frame < frameCount; frame++) {
 
@@ -123,9 +143,9 @@ void AnimClip::copyFromNetworkAnim() {
 
         // init all joints in animation to default pose
         // this will give us a resonable result for bones in the model skeleton but not in the animation.
-        _anim[frame].reserve(skeletonJointCount);
+        anim[frame].reserve(skeletonJointCount);
         for (int skeletonJoint = 0; skeletonJoint < skeletonJointCount; skeletonJoint++) {
-            _anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
+            anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
         }
 
         for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
@@ -165,26 +185,32 @@ void AnimClip::copyFromNetworkAnim() {
 
                 AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
 
-                _anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
+                anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
             }
         }
     }
 
-    // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
-
-    _poses.resize(skeletonJointCount);
+    _clip = std::make_shared<AnimCompressedClip>(anim);
+    animCache->addBakedClip(_bakedClipKey, _clip);
 }
 
-void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+void AnimClip::buildMirrorClip() {
+    assert(_skeleton && _clip);
+
+    auto animCache = DependencyManager::get<AnimationCache>();
+    QByteArray mirrorKey = _bakedClipKey + "/mirror";
+    _mirrorClip = animCache->getBakedClip(mirrorKey);
+    if (_mirrorClip) {
+        return;
+    }
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    std::vector<AnimPoseVec> mirrorAnim(_clip->getFrameCount(), AnimPoseVec(_clip->getJointCount()));
+    for (int frame = 0; frame < _clip->getFrameCount(); frame++) {
+        _clip->sampleFrame(frame, mirrorAnim[frame]);
+        _skeleton->mirrorRelativePoses(mirrorAnim[frame]);
     }
+    _mirrorClip = std::make_shared<AnimCompressedClip>(mirrorAnim);
+    animCache->addBakedClip(mirrorKey, _mirrorClip);
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
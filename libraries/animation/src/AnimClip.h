@@ -59,7 +59,7 @@ protected:
     virtual void setCurrentFrameInternal(float frame) override;
 
     void copyFromNetworkAnim();
-    void buildMirrorAnim();
+    void buildMirrorClip();
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
@@ -67,9 +67,12 @@ protected:
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // the frames baked for the skeleton, shared with the other clips playing the same animation on an equal skeleton
+    AnimCompressedClip::ConstPointer _clip;
+    AnimCompressedClip::ConstPointer _mirrorClip;
+    QByteArray _bakedClipKey;
+    AnimPoseVec _prevPoses;
+    AnimPoseVec _nextPoses;
 
     QString _url;
     float _startFrame;
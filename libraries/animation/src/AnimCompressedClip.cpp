@@ -0,0 +1,151 @@
+//
+//  AnimCompressedClip.cpp
+//
+//  Copyright (c) 2016 High Fidelity, Inc. All rights reserved.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimCompressedClip.h"
+
+#include <algorithm>
+
+// how far the frames between two keys may be from their interpolation
+static const float ROTATION_TOLERANCE = 0.0005f; // per component of the unit quaternion
+static const float RELATIVE_TRANSLATION_TOLERANCE = 0.0002f; // of the longest translation of the track
+static const float MIN_TRANSLATION_TOLERANCE = 0.00001f;
+
+// bounds the time spent looking for the next key
+static const int MAX_FRAMES_BETWEEN_KEYS = 120;
+
+static const float ROTATION_QUANTUM = 32767.0f;
+static const float TRANSLATION_QUANTUM = 65535.0f;
+
+static glm::quat interpolate(const glm::quat& a, const glm::quat& b, float alpha) {
+    return glm::normalize(a * (1.0f - alpha) + b * alpha);
+}
+
+static float rotationError(const glm::quat& a, const glm::quat& b) {
+    glm::quat d = (glm::dot(a, b) < 0.0f) ? (a + b) : (a - b);
+    return std::max(std::max(fabsf(d.x), fabsf(d.y)), std::max(fabsf(d.z), fabsf(d.w)));
+}
+
+AnimCompressedClip::AnimCompressedClip(const std::vector<AnimPoseVec>& frames) {
+    _frameCount = (int)frames.size();
+    if (_frameCount == 0) {
+        return;
+    }
+    int jointCount = (int)frames[0].size();
+    _tracks.resize(jointCount);
+    for (int joint = 0; joint < jointCount; joint++) {
+        compressTrack(frames, joint, _tracks[joint]);
+    }
+}
+
+void AnimCompressedClip::compressTrack(const std::vector<AnimPoseVec>& frames, int joint, Track& track) {
+    int frameCount = (int)frames.size();
+
+    // flip the rotations onto the hemisphere of the previous frame, so that keys interpolate the short way
+    std::vector<glm::quat> rotations(frameCount);
+    std::vector<glm::vec3> translations(frameCount);
+    glm::vec3 transMax = frames[0][joint].trans;
+    track.transMin = transMax;
+    float maxTransLength = 0.0f;
+    for (int frame = 0; frame < frameCount; frame++) {
+        const AnimPose& pose = frames[frame][joint];
+        rotations[frame] = (frame > 0 && glm::dot(pose.rot, rotations[frame - 1]) < 0.0f) ? -pose.rot : pose.rot;
+        translations[frame] = pose.trans;
+        track.transMin = glm::min(track.transMin, pose.trans);
+        transMax = glm::max(transMax, pose.trans);
+        maxTransLength = std::max(maxTransLength, glm::length(pose.trans));
+    }
+    track.scale = frames[0][joint].scale;
+    track.transStep = (transMax - track.transMin) / TRANSLATION_QUANTUM;
+    float transTolerance = std::max(MIN_TRANSLATION_TOLERANCE, RELATIVE_TRANSLATION_TOLERANCE * maxTransLength);
+
+    auto segmentFits = [&](int start, int end) {
+        float length = (float)(end - start);
+        for (int frame = start + 1; frame < end; frame++) {
+            float alpha = (float)(frame - start) / length;
+            glm::quat rot = interpolate(rotations[start], rotations[end], alpha);
+            if (rotationError(rot, rotations[frame]) > ROTATION_TOLERANCE) {
+                return false;
+            }
+            glm::vec3 delta = glm::abs(glm::mix(translations[start], translations[end], alpha) - translations[frame]);
+            if (std::max(std::max(delta.x, delta.y), delta.z) > transTolerance) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // keep the first and last frames, and between them each frame the segment from the last key can't reach past
+    track.keyFrames.push_back(0);
+    int key = 0;
+    while (key < frameCount - 1) {
+        int next = key + 1;
+        while (next + 1 < frameCount && next + 1 - key <= MAX_FRAMES_BETWEEN_KEYS && segmentFits(key, next + 1)) {
+            next++;
+        }
+        track.keyFrames.push_back((uint32_t)next);
+        key = next;
+    }
+
+    track.rotations.reserve(4 * track.keyFrames.size());
+    track.translations.reserve(3 * track.keyFrames.size());
+    glm::quat previous = rotations[0];
+    for (uint32_t frame : track.keyFrames) {
+        glm::quat rot = (glm::dot(rotations[frame], previous) < 0.0f) ? -rotations[frame] : rotations[frame];
+        previous = rot;
+        for (int i = 0; i < 4; i++) {
+            track.rotations.push_back((int16_t)glm::round(glm::clamp(rot[i], -1.0f, 1.0f) * ROTATION_QUANTUM));
+        }
+        for (int i = 0; i < 3; i++) {
+            float step = track.transStep[i];
+            float quantized = (step > 0.0f) ? glm::round((translations[frame][i] - track.transMin[i]) / step) : 0.0f;
+            track.translations.push_back((uint16_t)glm::clamp(quantized, 0.0f, TRANSLATION_QUANTUM));
+        }
+    }
+}
+
+AnimPose AnimCompressedClip::sampleTrack(const Track& track, int frame) {
+    auto decodeRotation = [&](size_t key) {
+        const int16_t* r = &track.rotations[4 * key];
+        return glm::quat((float)r[3], (float)r[0], (float)r[1], (float)r[2]) * (1.0f / ROTATION_QUANTUM);
+    };
+    auto decodeTranslation = [&](size_t key) {
+        const uint16_t* t = &track.translations[3 * key];
+        return track.transMin + track.transStep * glm::vec3((float)t[0], (float)t[1], (float)t[2]);
+    };
+
+    // the first key after the frame
+    auto next = std::upper_bound(track.keyFrames.begin(), track.keyFrames.end(), (uint32_t)frame);
+    if (next == track.keyFrames.end()) {
+        size_t last = track.keyFrames.size() - 1;
+        return AnimPose(track.scale, glm::normalize(decodeRotation(last)), decodeTranslation(last));
+    }
+    size_t nextKey = next - track.keyFrames.begin();
+    size_t prevKey = nextKey - 1;
+    uint32_t prevFrame = track.keyFrames[prevKey];
+    float alpha = (float)((uint32_t)frame - prevFrame) / (float)(*next - prevFrame);
+    return AnimPose(track.scale,
+        interpolate(decodeRotation(prevKey), decodeRotation(nextKey), alpha),
+        glm::mix(decodeTranslation(prevKey), decodeTranslation(nextKey), alpha));
+}
+
+void AnimCompressedClip::sampleFrame(int frame, AnimPoseVec& poses) const {
+    frame = std::min(std::max(0, frame), _frameCount - 1);
+    for (size_t joint = 0; joint < _tracks.size(); joint++) {
+        poses[joint] = sampleTrack(_tracks[joint], frame);
+    }
+}
+
+size_t AnimCompressedClip::getKeySize() const {
+    size_t size = 0;
+    for (const Track& track : _tracks) {
+        size += track.keyFrames.size() * sizeof(uint32_t) + track.rotations.size() * sizeof(int16_t) +
+            track.translations.size() * sizeof(uint16_t);
+    }
+    return size;
+}
@@ -0,0 +1,57 @@
+//
+//  AnimCompressedClip.h
+//
+//  Copyright (c) 2016 High Fidelity, Inc. All rights reserved.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimCompressedClip
+#define hifi_AnimCompressedClip
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AnimPose.h"
+
+// The frames of an animation, baked for a skeleton, held as one track of keys per joint.
+// Keys that linear interpolation from their neighbours reproduces are dropped, rotations are quantized
+// to 16 bits per component and translations to 16 bits over the range of their track.
+// The scale of each joint is held constant, as it is in the frames AnimClip bakes.
+// Compressed clips are immutable, so they can be shared by all the clips playing them.
+class AnimCompressedClip {
+public:
+    using ConstPointer = std::shared_ptr<const AnimCompressedClip>;
+
+    // frames[frame][joint], every frame with the same number of joints
+    explicit AnimCompressedClip(const std::vector<AnimPoseVec>& frames);
+
+    int getFrameCount() const { return _frameCount; }
+    int getJointCount() const { return (int)_tracks.size(); }
+
+    // poses must hold getJointCount() poses, frame is clamped to the clip
+    void sampleFrame(int frame, AnimPoseVec& poses) const;
+
+    // the bytes held by the keys of all the tracks
+    size_t getKeySize() const;
+
+private:
+    struct Track {
+        glm::vec3 scale;
+        glm::vec3 transMin;
+        glm::vec3 transStep; // per unit of the quantized translation
+        std::vector<uint32_t> keyFrames;
+        std::vector<int16_t> rotations; // four per key, with the sign of each key matching the previous one
+        std::vector<uint16_t> translations; // three per key
+    };
+
+    static void compressTrack(const std::vector<AnimPoseVec>& frames, int joint, Track& track);
+    static AnimPose sampleTrack(const Track& track, int frame);
+
+    int _frameCount { 0 };
+    std::vector<Track> _tracks;
+};
+
+#endif
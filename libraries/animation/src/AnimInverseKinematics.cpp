@@ -136,7 +136,7 @@ void AnimInverseKinematics::computeTargets(const AnimVariantMap& animVars, std::
 
 void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<IKTarget>& targets) {
     // compute absolute poses that correspond to relative target poses
-    AnimPoseVec absolutePoses;
+    AnimPoseVec& absolutePoses = _absolutePoses;
     absolutePoses.resize(_relativePoses.size());
     computeAbsolutePoses(absolutePoses);
 
@@ -430,8 +430,9 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
 
     if (!_relativePoses.empty()) {
 
-        // build a list of targets from _targetVarVec
-        std::vector<IKTarget> targets;
+        // build a list of targets from _targetVarVec, reusing the list from the last frame
+        std::vector<IKTarget>& targets = _targets;
+        targets.clear();
         {
             PROFILE_RANGE_EX(simulation_animation, "ik/computeTargets", 0xffff00ff, 0);
             computeTargets(animVars, targets, underPoses);
@@ -81,6 +81,10 @@ protected:
     AnimPoseVec _defaultRelativePoses; // poses of the relaxed state
     AnimPoseVec _relativePoses; // current relative poses
 
+    // scratch, kept between frames so that overlay does not allocate
+    std::vector<IKTarget> _targets;
+    AnimPoseVec _absolutePoses;
+
     // experimental data for moving hips during IK
     glm::vec3 _hipsOffset { Vectors::ZERO };
     int _headIndex { -1 };
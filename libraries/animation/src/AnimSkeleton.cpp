@@ -10,6 +10,8 @@
 
 #include "AnimSkeleton.h"
 
+#include <QtCore/QCryptographicHash>
+
 #include <glm/gtx/transform.hpp>
 
 #include <GLMHelpers.h>
@@ -226,6 +228,16 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints)
             _mirrorMap.push_back(i);
         }
     }
+
+    // hash everything a clip baked for this skeleton depends on
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (int i = 0; i < (int)joints.size(); i++) {
+        hash.addData(_joints[i].name.toUtf8());
+        hash.addData((const char*)&_joints[i].parentIndex, sizeof(int));
+        hash.addData((const char*)&_relativeDefaultPoses[i], sizeof(AnimPose));
+        hash.addData((const char*)&_relativeBindPoses[i], sizeof(AnimPose));
+    }
+    _signature = hash.result();
 }
 
 void AnimSkeleton::dump(bool verbose) const {
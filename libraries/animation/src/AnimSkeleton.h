@@ -63,6 +63,9 @@ public:
     void mirrorRelativePoses(AnimPoseVec& poses) const;
     void mirrorAbsolutePoses(AnimPoseVec& poses) const;
 
+    // equal for skeletons that clips bake to the same frames for
+    const QByteArray& getSignature() const { return _signature; }
+
     void dump(bool verbose) const;
     void dump(const AnimPoseVec& poses) const;
 
@@ -79,6 +82,7 @@ protected:
     mutable AnimPoseVec _nonMirroredPoses;
     std::vector<int> _nonMirroredIndices;
     std::vector<int> _mirrorMap;
+    QByteArray _signature;
 
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
@@ -52,9 +52,8 @@ const AnimPoseVec& AnimStateMachine::evaluate(const AnimVariantMap& animVars, fl
     if (_duringInterp) {
         _alpha += _alphaVel * dt;
         if (_alpha < 1.0f) {
-            AnimPoseVec* nextPoses = nullptr;
-            AnimPoseVec* prevPoses = nullptr;
-            AnimPoseVec localNextPoses;
+            const AnimPoseVec* nextPoses = nullptr;
+            const AnimPoseVec* prevPoses = nullptr;
             if (_interpType == InterpType::SnapshotBoth) {
                 // interp between both snapshots
                 prevPoses = &_prevPoses;
@@ -62,9 +61,8 @@ const AnimPoseVec& AnimStateMachine::evaluate(const AnimVariantMap& animVars, fl
             } else if (_interpType == InterpType::SnapshotPrev) {
                 // interp between the prev snapshot and evaluated next target.
                 // this is useful for interping into a blend
-                localNextPoses = currentStateNode->evaluate(animVars, dt, triggersOut);
                 prevPoses = &_prevPoses;
-                nextPoses = &localNextPoses;
+                nextPoses = &currentStateNode->evaluate(animVars, dt, triggersOut);
             } else {
                 assert(false);
             }
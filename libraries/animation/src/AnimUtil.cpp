@@ -11,25 +11,77 @@
 #include "AnimUtil.h"
 #include "GLMHelpers.h"
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+// blend() works on whole poses, ten floats each: scale, rot then trans
+static_assert(sizeof(AnimPose) == 10 * sizeof(float), "AnimPose must be tightly packed");
+
+//
+// on x86 architecture, assume that SSE is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <xmmintrin.h>
+
+// the sum of the four lanes, in every lane
+static inline __m128 dot4(__m128 a, __m128 b) {
+    __m128 product = _mm_mul_ps(a, b);
+    __m128 sum = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+// Each pose is lerped as three overlapping four float chunks, all within the pose:
+// scale plus rot.x, rot, and rot.w plus trans. The rot chunk is stored last, over the lanes the others share with it.
+static inline void blendPose(const AnimPose& a, const AnimPose& b, float alpha, AnimPose& result) {
+    const float* aFloats = &a.scale.x;
+    const float* bFloats = &b.scale.x;
+    float* resultFloats = &result.scale.x;
+
+    __m128 alphas = _mm_set1_ps(alpha);
+    __m128 betas = _mm_set1_ps(1.0f - alpha);
+
+    // adjust signs if necessary
+    __m128 aRot = _mm_loadu_ps(aFloats + 3);
+    __m128 bRot = _mm_loadu_ps(bFloats + 3);
+    __m128 signs = _mm_and_ps(_mm_cmplt_ps(dot4(aRot, bRot), _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+    bRot = _mm_xor_ps(bRot, signs);
+
+    __m128 rot = _mm_add_ps(_mm_mul_ps(aRot, betas), _mm_mul_ps(bRot, alphas));
+    rot = _mm_div_ps(rot, _mm_sqrt_ps(dot4(rot, rot)));
+
+    __m128 scale = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(aFloats), betas), _mm_mul_ps(_mm_loadu_ps(bFloats), alphas));
+    __m128 trans = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(aFloats + 6), betas), _mm_mul_ps(_mm_loadu_ps(bFloats + 6), alphas));
+
+    _mm_storeu_ps(resultFloats, scale);
+    _mm_storeu_ps(resultFloats + 6, trans);
+    _mm_storeu_ps(resultFloats + 3, rot);
+}
+
+#else   // portable reference code
+
+static inline void blendPose(const AnimPose& a, const AnimPose& b, float alpha, AnimPose& result) {
+    // adjust signs if necessary
+    const glm::quat& q1 = a.rot;
+    glm::quat q2 = b.rot;
+    float dot = glm::dot(q1, q2);
+    if (dot < 0.0f) {
+        q2 = -q2;
+    }
+
+    result.scale = lerp(a.scale, b.scale, alpha);
+    result.rot = glm::normalize(glm::lerp(q1, q2, alpha));
+    result.trans = lerp(a.trans, b.trans, alpha);
+}
+
+#endif
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
-        const AnimPose& aPose = a[i];
-        const AnimPose& bPose = b[i];
-
-        // adjust signs if necessary
-        const glm::quat& q1 = aPose.rot;
-        glm::quat q2 = bPose.rot;
-        float dot = glm::dot(q1, q2);
-        if (dot < 0.0f) {
-            q2 = -q2;
-        }
+        blendPose(a[i], b[i], alpha, result[i]);
+    }
+}
 
-        result[i].scale = lerp(aPose.scale, bPose.scale, alpha);
-        result[i].rot = glm::normalize(glm::lerp(aPose.rot, q2, alpha));
-        result[i].trans = lerp(aPose.trans, bPose.trans, alpha);
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* alphas, float alphaScale, AnimPose* result) {
+    for (size_t i = 0; i < numPoses; i++) {
+        blendPose(a[i], b[i], alphas[i] * alphaScale, result[i]);
     }
 }
 
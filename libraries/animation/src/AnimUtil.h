@@ -14,8 +14,12 @@
 #include "AnimNode.h"
 
 // this is where the magic happens
+// result may be a or b, and the poses need not be aligned.
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
+// same, with an alpha per pose, each scaled by alphaScale
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* alphas, float alphaScale, AnimPose* result);
+
 float accumulateTime(float startFrame, float endFrame, float timeScale, float currentFrame, float dt, bool loopFlag,
                      const QString& id, AnimNode::Triggers& triggersOut);
 
@@ -38,6 +38,26 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+AnimCompressedClip::ConstPointer AnimationCache::getBakedClip(const QByteArray& key) {
+    std::lock_guard<std::mutex> lock(_bakedClipsMutex);
+    auto iterator = _bakedClips.find(key);
+    return (iterator == _bakedClips.end()) ? nullptr : iterator.value().lock();
+}
+
+void AnimationCache::addBakedClip(const QByteArray& key, const AnimCompressedClip::ConstPointer& clip) {
+    std::lock_guard<std::mutex> lock(_bakedClipsMutex);
+
+    // forget the clips no longer in use
+    for (auto iterator = _bakedClips.begin(); iterator != _bakedClips.end(); ) {
+        if (iterator.value().expired()) {
+            iterator = _bakedClips.erase(iterator);
+        } else {
+            ++iterator;
+        }
+    }
+    _bakedClips.insert(key, clip);
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
     const void* extra) {
     return QSharedPointer<Resource>(new Animation(url), &Resource::deleter);
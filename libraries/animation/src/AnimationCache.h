@@ -12,6 +12,8 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <mutex>
+
 #include <QtCore/QRunnable>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
@@ -20,6 +22,8 @@
 #include <FBXReader.h>
 #include <ResourceCache.h>
 
+#include "AnimCompressedClip.h"
+
 class Animation;
 
 typedef QSharedPointer<Animation> AnimationPointer;
@@ -45,6 +49,11 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    // Animations baked for a skeleton and compressed, shared by every AnimClip playing them on a skeleton
+    // of the same signature. They are held for as long as a clip uses them. Thread safe.
+    AnimCompressedClip::ConstPointer getBakedClip(const QByteArray& key);
+    void addBakedClip(const QByteArray& key, const AnimCompressedClip::ConstPointer& clip);
+
 protected:
 
     virtual QSharedPointer<Resource> createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
@@ -53,6 +62,8 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    std::mutex _bakedClipsMutex;
+    QHash<QByteArray, std::weak_ptr<const AnimCompressedClip>> _bakedClips;
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
@@ -44,6 +44,11 @@ public:
     //
     void renderSilent(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
+    //
+    // True when renderSilent() has already flushed the internal state, and will not write to output
+    //
+    bool isSilent() const { return _silentState; }
+
 private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
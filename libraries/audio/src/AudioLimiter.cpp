@@ -7,6 +7,7 @@
 //
 
 #include <math.h>
+#include <string.h>
 #include <assert.h>
 
 #include "AudioLimiter.h"
@@ -141,10 +142,10 @@ static const int IEEE754_EXPN_BIAS = 127;
 // x < 2^(31-LOG2_HEADROOM) returns 0x7fffffff
 // x > 2^LOG2_HEADROOM undefined
 //
-static inline int32_t peaklog2(float* input) {
+static inline int32_t peaklog2(const float* input) {
 
     // float as integer bits
-    int32_t u = *(int32_t*)input;
+    int32_t u = *(const int32_t*)input;
 
     // absolute value
     int32_t peak = u & IEEE754_FABS_MASK;
@@ -177,11 +178,11 @@ static inline int32_t peaklog2(float* input) {
 // x < 2^(31-LOG2_HEADROOM) returns 0x7fffffff
 // x > 2^LOG2_HEADROOM undefined
 //
-static inline int32_t peaklog2(float* input0, float* input1) {
+static inline int32_t peaklog2(const float* input0, const float* input1) {
 
     // float as integer bits
-    int32_t u0 = *(int32_t*)input0;
-    int32_t u1 = *(int32_t*)input1;
+    int32_t u0 = *(const int32_t*)input0;
+    int32_t u1 = *(const int32_t*)input1;
 
     // max absolute value
     u0 &= IEEE754_FABS_MASK;
@@ -216,13 +217,13 @@ static inline int32_t peaklog2(float* input0, float* input1) {
 // x < 2^(31-LOG2_HEADROOM) returns 0x7fffffff
 // x > 2^LOG2_HEADROOM undefined
 //
-static inline int32_t peaklog2(float* input0, float* input1, float* input2, float* input3) {
+static inline int32_t peaklog2(const float* input0, const float* input1, const float* input2, const float* input3) {
 
     // float as integer bits
-    int32_t u0 = *(int32_t*)input0;
-    int32_t u1 = *(int32_t*)input1;
-    int32_t u2 = *(int32_t*)input2;
-    int32_t u3 = *(int32_t*)input3;
+    int32_t u0 = *(const int32_t*)input0;
+    int32_t u1 = *(const int32_t*)input1;
+    int32_t u2 = *(const int32_t*)input2;
+    int32_t u3 = *(const int32_t*)input3;
 
     // max absolute value
     u0 &= IEEE754_FABS_MASK;
@@ -278,15 +279,98 @@ static inline int32_t fixexp2(int32_t x) {
     return c2 >> e;
 }
 
-// fast TPDF dither in [-1.0f, 1.0f]
-static inline float dither() {
-    static uint32_t rz = 0;
-    rz = rz * 69069 + 1;
-    int32_t r0 = rz & 0xffff;
-    int32_t r1 = rz >> 16;
-    return (int32_t)(r0 - r1) * (1/65536.0f);
+//
+// Block processing
+//
+// The envelope is inherently serial, so each block of frames is processed in three stages:
+// peak detection in log2 domain (vectorized), gain computation (serial), and delay/gain/dither
+// with conversion to 16-bit (vectorized).
+//
+static const int LIMITER_BLOCK = 256;
+
+// peak detect and convert to log2 domain (interleaved input)
+void limiterPeak_ref(const float* input, int32_t* output, int numChannels, int numFrames) {
+
+    switch (numChannels) {
+    case 1:
+        for (int n = 0; n < numFrames; n++) {
+            output[n] = peaklog2(&input[n]);
+        }
+        break;
+    case 2:
+        for (int n = 0; n < numFrames; n++) {
+            output[n] = peaklog2(&input[2*n+0], &input[2*n+1]);
+        }
+        break;
+    case 4:
+        for (int n = 0; n < numFrames; n++) {
+            output[n] = peaklog2(&input[4*n+0], &input[4*n+1], &input[4*n+2], &input[4*n+3]);
+        }
+        break;
+    default:
+        assert(0); // unsupported
+    }
 }
 
+// apply per-frame gain and dither, convert to 16-bit (interleaved input/output)
+void limiterOutput_ref(const float* input, const float* gain, const float* dither, int16_t* output,
+                       int numChannels, int numFrames) {
+
+    for (int n = 0; n < numFrames; n++) {
+        for (int c = 0; c < numChannels; c++) {
+
+            float x = input[numChannels*n + c];
+
+            // apply gain
+            x *= gain[n];
+
+            // apply dither
+            x += dither[n];
+
+            // store 16-bit output
+            output[numChannels*n + c] = (int16_t)floatToInt(x);
+        }
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void limiterPeak_AVX2(const float* input, int32_t* output, int numChannels, int numFrames);
+void limiterOutput_AVX2(const float* input, const float* gain, const float* dither, int16_t* output,
+                        int numChannels, int numFrames);
+
+static void limiterPeak(const float* input, int32_t* output, int numChannels, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? limiterPeak_AVX2 : limiterPeak_ref;
+    (*f)(input, output, numChannels, numFrames); // dispatch
+}
+
+static void limiterOutput(const float* input, const float* gain, const float* dither, int16_t* output,
+                          int numChannels, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? limiterOutput_AVX2 : limiterOutput_ref;
+    (*f)(input, gain, dither, output, numChannels, numFrames); // dispatch
+}
+
+#else   // portable reference code
+
+static void limiterPeak(const float* input, int32_t* output, int numChannels, int numFrames) {
+    limiterPeak_ref(input, output, numChannels, numFrames);
+}
+
+static void limiterOutput(const float* input, const float* gain, const float* dither, int16_t* output,
+                          int numChannels, int numFrames) {
+    limiterOutput_ref(input, gain, dither, output, numChannels, numFrames);
+}
+
+#endif
+
 //
 // Peak-hold lowpass filter
 //
@@ -364,91 +448,34 @@ template<> class PeakFilter<128> : public PeakFilterT<128,  53,  76> {};
 template<> class PeakFilter<256> : public PeakFilterT<256, 106, 151> {};
 
 //
-// N-1 sample delay (mono)
+// N-1 sample delay (interleaved)
+// The delayed frames are returned as a contiguous block, for vectorized processing.
 //
-template<int N>
-class MonoDelay {
+template<int N, int C>
+class BlockDelay {
 
     static_assert((N & (N - 1)) == 0, "N must be a power of 2");
 
-    float _buffer[N] = {};
-    size_t _index = 0;
-
-public:
-    void process(float& x) {
-
-        const size_t MASK = N - 1;  // buffer wrap
-        size_t i = _index;
-
-        _buffer[i] = x;
-
-        i = (i + (N - 1)) & MASK;
-
-        x = _buffer[i];
-
-        _index = i;
-    }
-};
-
-//
-// N-1 sample delay (stereo)
-//
-template<int N>
-class StereoDelay {
-
-    static_assert((N & (N - 1)) == 0, "N must be a power of 2");
+    static const int HISTORY = C * (N - 1);
 
-    float _buffer[2*N] = {};
-    size_t _index = 0;
+    float _buffer[HISTORY + C * LIMITER_BLOCK] = {};
 
 public:
-    void process(float& x0, float& x1) {
+    // returns the delayed frames, valid until advance()
+    const float* write(const float* input, int numFrames) {
 
-        const size_t MASK = 2*N - 1;    // buffer wrap
-        size_t i = _index;
-
-        _buffer[i+0] = x0;
-        _buffer[i+1] = x1;
-
-        i = (i + 2*(N - 1)) & MASK;
+        assert(numFrames <= LIMITER_BLOCK);
 
-        x0 = _buffer[i+0];
-        x1 = _buffer[i+1];
+        // append to the history
+        memcpy(&_buffer[HISTORY], input, C * numFrames * sizeof(float));
 
-        _index = i;
+        return _buffer;
     }
-};
-
-//
-// N-1 sample delay (quad)
-//
-template<int N>
-class QuadDelay {
 
-    static_assert((N & (N - 1)) == 0, "N must be a power of 2");
-
-    float _buffer[4*N] = {};
-    size_t _index = 0;
-
-public:
-    void process(float& x0, float& x1, float& x2, float& x3) {
-
-        const size_t MASK = 4*N - 1;    // buffer wrap
-        size_t i = _index;
-
-        _buffer[i+0] = x0;
-        _buffer[i+1] = x1;
-        _buffer[i+2] = x2;
-        _buffer[i+3] = x3;
-
-        i = (i + 4*(N - 1)) & MASK;
+    void advance(int numFrames) {
 
-        x0 = _buffer[i+0];
-        x1 = _buffer[i+1];
-        x2 = _buffer[i+2];
-        x3 = _buffer[i+3];
-
-        _index = i;
+        // retain the last N-1 frames as history
+        memmove(_buffer, &_buffer[C * numFrames], HISTORY * sizeof(float));
     }
 };
 
@@ -474,6 +501,22 @@ protected:
     int _sampleRate;
     float _outGain = 0.0f;
 
+    uint32_t _ditherState = 0;
+
+    // block processing buffers
+    int32_t _peak[LIMITER_BLOCK];
+    float _gain[LIMITER_BLOCK];
+    float _dither[LIMITER_BLOCK];
+
+    // fast TPDF dither in [-1.0f, 1.0f]
+    // state is per-instance, so that limiters can safely run on concurrent threads
+    float dither() {
+        _ditherState = _ditherState * 69069 + 1;
+        int32_t r0 = _ditherState & 0xffff;
+        int32_t r1 = _ditherState >> 16;
+        return (int32_t)(r0 - r1) * (1/65536.0f);
+    }
+
 public:
     LimiterImpl(int sampleRate);
     virtual ~LimiterImpl() {}
@@ -484,6 +527,7 @@ public:
     int32_t envelope(int32_t attn);
 
     virtual void process(float* input, int16_t* output, int numFrames) = 0;
+    virtual bool isSettled() const = 0;
 };
 
 LimiterImpl::LimiterImpl(int sampleRate) {
@@ -632,178 +676,83 @@ int32_t LimiterImpl::envelope(int32_t attn) {
 }
 
 //
-// Limiter (mono)
+// Limiter (interleaved, C channels)
 //
-template<int N>
-class LimiterMono : public LimiterImpl {
+template<int N, int C>
+class LimiterT : public LimiterImpl {
 
     PeakFilter<N> _filter;
-    MonoDelay<N> _delay;
+    BlockDelay<N, C> _delay;
 
-public:
-    LimiterMono(int sampleRate) : LimiterImpl(sampleRate) {}
-
-    void process(float* input, int16_t* output, int numFrames) override;
-};
-
-template<int N>
-void LimiterMono<N>::process(float* input, int16_t* output, int numFrames) {
-
-    for (int n = 0; n < numFrames; n++) {
-
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[n]);
-
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
-
-        // apply envelope
-        attn = envelope(attn);
-
-        // convert from log2 domain
-        attn = fixexp2(attn);
-
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
-
-        // delay audio
-        float x = input[n];
-        _delay.process(x);
-
-        // apply gain
-        x *= gain;
-
-        // apply dither
-        x += dither();
-
-        // store 16-bit output
-        output[n] = (int16_t)floatToInt(x);
-    }
-}
-
-//
-// Limiter (stereo)
-//
-template<int N>
-class LimiterStereo : public LimiterImpl {
-
-    PeakFilter<N> _filter;
-    StereoDelay<N> _delay;
+    // consecutive frames of silent input with no attenuation, saturating at SETTLED
+    // once the delay and the peak filter have been flushed, and the envelope has decayed to zero,
+    // processing silence has no further effect
+    static const int SETTLED = 2*N;
+    int _silentFrames = SETTLED;
 
 public:
-    LimiterStereo(int sampleRate) : LimiterImpl(sampleRate) {}
+    LimiterT(int sampleRate) : LimiterImpl(sampleRate) {}
 
-    // interleaved stereo input/output
+    // interleaved input/output
     void process(float* input, int16_t* output, int numFrames) override;
-};
-
-template<int N>
-void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
-
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
-
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
-
-        // apply envelope
-        attn = envelope(attn);
+    // the RMS estimate keeps releasing after the attenuation reaches zero
+    bool isSettled() const override { return _silentFrames >= SETTLED && _attn == 0 && _rms == 0; }
+};
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+template<int N, int C>
+void LimiterT<N, C>::process(float* input, int16_t* output, int numFrames) {
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+    while (numFrames > 0) {
 
-        // delay audio
-        float x0 = input[2*n+0];
-        float x1 = input[2*n+1];
-        _delay.process(x0, x1);
-
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
-
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
-
-        // store 16-bit output
-        output[2*n+0] = (int16_t)floatToInt(x0);
-        output[2*n+1] = (int16_t)floatToInt(x1);
-    }
-}
+        int n = MIN(numFrames, LIMITER_BLOCK);
 
-//
-// Limiter (quad)
-//
-template<int N>
-class LimiterQuad : public LimiterImpl {
+        // peak detect and convert to log2 domain
+        limiterPeak(input, _peak, C, n);
 
-    PeakFilter<N> _filter;
-    QuadDelay<N> _delay;
+        for (int i = 0; i < n; i++) {
 
-public:
-    LimiterQuad(int sampleRate) : LimiterImpl(sampleRate) {}
+            // compute limiter attenuation
+            int32_t attn = MAX(_threshold - _peak[i], 0);
 
-    // interleaved quad input/output
-    void process(float* input, int16_t* output, int numFrames) override;
-};
+            // apply envelope
+            attn = envelope(attn);
 
-template<int N>
-void LimiterQuad<N>::process(float* input, int16_t* output, int numFrames) {
+            // track the run of silent, fully released frames
+            if (_peak[i] == 0x7fffffff && attn == 0) {
+                _silentFrames = MIN(_silentFrames + 1, SETTLED);
+            } else {
+                _silentFrames = 0;
+            }
 
-    for (int n = 0; n < numFrames; n++) {
+            // convert from log2 domain
+            attn = fixexp2(attn);
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[4*n+0], &input[4*n+1], &input[4*n+2], &input[4*n+3]);
+            // lowpass filter
+            attn = _filter.process(attn);
+            _gain[i] = attn * _outGain;
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+            _dither[i] = dither();
+        }
 
-        // apply envelope
-        attn = envelope(attn);
+        // delay audio
+        const float* x = _delay.write(input, n);
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+        // apply gain and dither, store 16-bit output
+        limiterOutput(x, _gain, _dither, output, C, n);
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+        _delay.advance(n);
 
-        // delay audio
-        float x0 = input[4*n+0];
-        float x1 = input[4*n+1];
-        float x2 = input[4*n+2];
-        float x3 = input[4*n+3];
-        _delay.process(x0, x1, x2, x3);
-
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
-        x2 *= gain;
-        x3 *= gain;
-
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
-        x2 += d;
-        x3 += d;
-
-        // store 16-bit output
-        output[4*n+0] = (int16_t)floatToInt(x0);
-        output[4*n+1] = (int16_t)floatToInt(x1);
-        output[4*n+2] = (int16_t)floatToInt(x2);
-        output[4*n+3] = (int16_t)floatToInt(x3);
+        input += C * n;
+        output += C * n;
+        numFrames -= n;
     }
 }
 
+template<int N> using LimiterMono = LimiterT<N, 1>;
+template<int N> using LimiterStereo = LimiterT<N, 2>;
+template<int N> using LimiterQuad = LimiterT<N, 4>;
+
 //
 // Public API
 //
@@ -862,6 +811,10 @@ void AudioLimiter::render(float* input, int16_t* output, int numFrames) {
     _impl->process(input, output, numFrames);
 }
 
+bool AudioLimiter::isSettled() const {
+    return _impl->isSettled();
+}
+
 void AudioLimiter::setThreshold(float threshold) {
     _impl->setThreshold(threshold);
 }
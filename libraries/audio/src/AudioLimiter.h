@@ -20,6 +20,10 @@ public:
 
     void render(float* input, int16_t* output, int numFrames);
 
+    // true when the input has been silent long enough to flush the lookahead delay and for the envelope
+    // to decay to zero, so that skipping render() on silent input does not disturb the limiter state
+    bool isSettled() const;
+
     void setThreshold(float threshold);
     void setRelease(float release);
 
@@ -630,6 +630,72 @@ void PZShelf(double coef[3], double w0, double dbgain, int isHigh) {
     coef[2] = a1 * scale;
 }
 
+//
+// Block processing
+//
+// The early reflections and output diffusers are feed-forward, so they are processed
+// a block at a time. Each allpass is vectorized over runs of up to one delay length,
+// where the delayed samples never depend on the current run.
+//
+static const int REVERB_BLOCK = 256;
+
+// allpass over a contiguous run, numFrames <= delay
+void allpass_ref(const float* src, float* dst, const float* input, float* output, float coef, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        float x = input[i];
+        float y = src[i] - coef * x;    // feedforward path
+        dst[i] = x + coef * y;          // feedback path
+        output[i] = y;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void allpass_AVX2(const float* src, float* dst, const float* input, float* output, float coef, int numFrames);
+
+static void allpass(const float* src, float* dst, const float* input, float* output, float coef, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? allpass_AVX2 : allpass_ref;
+    (*f)(src, dst, input, output, coef, numFrames); // dispatch
+}
+
+#else   // portable reference code
+
+static void allpass(const float* src, float* dst, const float* input, float* output, float coef, int numFrames) {
+    allpass_ref(src, dst, input, output, coef, numFrames);
+}
+
+#endif
+
+//
+// Delay taps in block mode. A run of samples is written at once, so taps longer than
+// half the buffer are read before the write (run <= delay), and shorter taps are read
+// after the write (run <= N - delay). A delay of 0 reads the oldest sample, same as N.
+//
+template<int N>
+static inline bool tapReadsFirst(int delay) {
+    return delay == 0 || delay > N/2;
+}
+
+template<int N>
+static inline int tapMaxRun(int delay) {
+    return tapReadsFirst<N>(delay) ? (delay ? delay : N) : N - delay;
+}
+
+// scaled tap over a contiguous run
+static inline void readTap(const float* buffer, float gain, float* output, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        output[i] = gain * buffer[i];
+    }
+}
+
 class BandwidthEQ {
 
     float _buffer[4] {};
@@ -727,6 +793,34 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // block version, output must hold numFrames+1
+    void process(const float* input, float* output, int numFrames) {
+        output[0] = _output;
+
+        bool readFirst = tapReadsFirst<N>(_delay);
+
+        for (int i = 0; i < numFrames;) {
+            int k = (_index - _delay) & (N - 1);
+
+            int n = MIN(numFrames - i, tapMaxRun<N>(_delay));
+            n = MIN(n, N - k);
+            n = MIN(n, N - _index);
+
+            if (readFirst) {
+                memcpy(&output[i + 1], &_buffer[k], n * sizeof(float));
+            }
+            memcpy(&_buffer[_index], &input[i], n * sizeof(float));
+            if (!readFirst) {
+                memcpy(&output[i + 1], &_buffer[k], n * sizeof(float));
+            }
+
+            _index = (_index + n) & (N - 1);
+            i += n;
+        }
+
+        _output = output[numFrames];
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -773,6 +867,25 @@ public:
         _index1 = (_index1 + 1) & (N - 1);
     }
 
+    // block version, output must hold numFrames+1
+    void process(const float* input, float* output, int numFrames) {
+        output[0] = _output;
+
+        for (int i = 0; i < numFrames;) {
+            int n = MIN(numFrames - i, _delay);
+            n = MIN(n, N - _index0);
+            n = MIN(n, N - _index1);
+
+            allpass(&_buffer[_index1], &_buffer[_index0], &input[i], &output[i + 1], _coef, n);
+
+            _index0 = (_index0 + n) & (N - 1);
+            _index1 = (_index1 + n) & (N - 1);
+            i += n;
+        }
+
+        _output = output[numFrames];
+    }
+
     void getOutput(float& output) {
         output = _output;
     }
@@ -1065,6 +1178,38 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // block version, outputs must hold numFrames+1
+    void process(const float* input, float* output0, float* output1, int numFrames) {
+        output0[0] = _output0;
+        output1[0] = _output1;
+
+        bool readFirst0 = tapReadsFirst<N>(_delay0);
+        bool readFirst1 = tapReadsFirst<N>(_delay1);
+
+        for (int i = 0; i < numFrames;) {
+            int k0 = (_index - _delay0) & (N - 1);
+            int k1 = (_index - _delay1) & (N - 1);
+
+            int n = MIN(numFrames - i, MIN(tapMaxRun<N>(_delay0), tapMaxRun<N>(_delay1)));
+            n = MIN(n, MIN(N - k0, N - k1));
+            n = MIN(n, N - _index);
+
+            if (readFirst0) readTap(&_buffer[k0], _gain0, &output0[i + 1], n);
+            if (readFirst1) readTap(&_buffer[k1], _gain1, &output1[i + 1], n);
+
+            memcpy(&_buffer[_index], &input[i], n * sizeof(float));
+
+            if (!readFirst0) readTap(&_buffer[k0], _gain0, &output0[i + 1], n);
+            if (!readFirst1) readTap(&_buffer[k1], _gain1, &output1[i + 1], n);
+
+            _index = (_index + n) & (N - 1);
+            i += n;
+        }
+
+        _output0 = output0[numFrames];
+        _output1 = output1[numFrames];
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -1132,6 +1277,45 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // block version, outputs must hold numFrames+1
+    void process(const float* input, float* output0, float* output1, float* output2, int numFrames) {
+        output0[0] = _output0;
+        output1[0] = _output1;
+        output2[0] = _output2;
+
+        bool readFirst0 = tapReadsFirst<N>(_delay0);
+        bool readFirst1 = tapReadsFirst<N>(_delay1);
+        bool readFirst2 = tapReadsFirst<N>(_delay2);
+
+        for (int i = 0; i < numFrames;) {
+            int k0 = (_index - _delay0) & (N - 1);
+            int k1 = (_index - _delay1) & (N - 1);
+            int k2 = (_index - _delay2) & (N - 1);
+
+            int n = MIN(numFrames - i, MIN(tapMaxRun<N>(_delay0), tapMaxRun<N>(_delay2)));
+            n = MIN(n, tapMaxRun<N>(_delay1));
+            n = MIN(n, MIN(N - k0, MIN(N - k1, N - k2)));
+            n = MIN(n, N - _index);
+
+            if (readFirst0) readTap(&_buffer[k0], _gain0, &output0[i + 1], n);
+            if (readFirst1) readTap(&_buffer[k1], _gain1, &output1[i + 1], n);
+            if (readFirst2) readTap(&_buffer[k2], _gain2, &output2[i + 1], n);
+
+            memcpy(&_buffer[_index], &input[i], n * sizeof(float));
+
+            if (!readFirst0) readTap(&_buffer[k0], _gain0, &output0[i + 1], n);
+            if (!readFirst1) readTap(&_buffer[k1], _gain1, &output1[i + 1], n);
+            if (!readFirst2) readTap(&_buffer[k2], _gain2, &output2[i + 1], n);
+
+            _index = (_index + n) & (N - 1);
+            i += n;
+        }
+
+        _output0 = output0[numFrames];
+        _output1 = output1[numFrames];
+        _output2 = output2[numFrames];
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -1210,6 +1394,26 @@ class ReverbImpl {
     float _earlyGain = 0.0f;
     float _wetDryMix = 0.0f;
 
+    // block processing buffers, sized for the output delay of each stage
+    float _preL[REVERB_BLOCK + 1];
+    float _preR[REVERB_BLOCK + 1];
+    float _early0L[REVERB_BLOCK + 1];
+    float _early1L[REVERB_BLOCK + 1];
+    float _early2L[REVERB_BLOCK + 1];
+    float _early0R[REVERB_BLOCK + 1];
+    float _early1R[REVERB_BLOCK + 1];
+    float _early2R[REVERB_BLOCK + 1];
+    float _earlyOutL[REVERB_BLOCK + 1];
+    float _earlyOutR[REVERB_BLOCK + 1];
+    float _tmp[6][REVERB_BLOCK + 1];
+
+    template<class MT0, class AP0, class MT1, class AP1, class AP2, class MT2>
+    void processEarly(const float* pre, float* early0, float* early1, float* early2, float* earlyOut,
+                      MT0& mt0, AP0& ap0, MT1& mt1, AP1& ap1, AP2& ap2, MT2& mt2,
+                      float earlyMix1, float earlyMix2, int numFrames);
+
+    void processBlock(const float* inputL, const float* inputR, float* outputL, float* outputR, int numFrames);
+
 public:
     void setParameters(ReverbParameters *p);
     void process(float** inputs, float** outputs, int numFrames);
@@ -1582,41 +1786,69 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
     _wetDryMix = MIN(MAX(_wetDryMix, 0.0f), 1.0f);
 }
 
-void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
+//
+// Early reflections (block)
+//
+template<class MT0, class AP0, class MT1, class AP1, class AP2, class MT2>
+void ReverbImpl::processEarly(const float* pre, float* early0, float* early1, float* early2, float* earlyOut,
+                              MT0& mt0, AP0& ap0, MT1& mt1, AP1& ap1, AP2& ap2, MT2& mt2,
+                              float earlyMix1, float earlyMix2, int numFrames) {
+    float* x0 = _tmp[0];
+    float* x1 = _tmp[1];
+    float* x2 = _tmp[2];
+    float* y0 = _tmp[3];
+    float* y1 = _tmp[4];
+    float* y2 = _tmp[5];
+
+    mt0.process(pre, x0, x1, y0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        x2[i] = x0[i] + x1[i];
+    }
+    ap0.process(x2, y1, numFrames);
+    mt1.process(y1, x0, x1, early0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        x2[i] = x0[i] + x1[i];
+    }
+    ap1.process(x2, y2, numFrames);
+    ap2.process(y2, x0, numFrames);
+    mt2.process(x0, early1, early2, numFrames);
 
     for (int i = 0; i < numFrames; i++) {
-        float x0, x1, y0, y1, y2, y3;
-
-        // Preprocess
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        _bw.process(x0, x1, x0, x1);
-
-        float preL, preR;
-        _dl0.process(x0, preL);
-        _dl1.process(x1, preR);
-
-        // Early Left
-        float early0L, early1L, early2L, earlyOutL;
-        _mt0.process(preL, x0, x1, y0);
-        _ap0.process(x0 + x1, y1);
-        _mt1.process(y1, x0, x1, early0L);
-        _ap1.process(x0 + x1, y2);
-        _ap2.process(y2, x0);
-        _mt2.process(x0, early1L, early2L);
-
-        earlyOutL = (y0 + y1 * _earlyMix1L + y2 * _earlyMix2L) * _earlyGain;
-
-        // Early Right
-        float early0R, early1R, early2R, earlyOutR;
-        _mt3.process(preR, x0, x1, y0);
-        _ap3.process(x0 + x1, y1);
-        _mt4.process(y1, x0, x1, early0R);
-        _ap4.process(x0 + x1, y2);
-        _ap5.process(y2, x0);
-        _mt5.process(x0, early1R, early2R);
-
-        earlyOutR = (y0 + y1 * _earlyMix1R + y2 * _earlyMix2R) * _earlyGain;
+        earlyOut[i] = (y0[i] + y1[i] * earlyMix1 + y2[i] * earlyMix2) * _earlyGain;
+    }
+}
+
+void ReverbImpl::processBlock(const float* inputL, const float* inputR, float* outputL, float* outputR, int numFrames) {
+
+    // Preprocess
+    float* bwL = _tmp[0];
+    float* bwR = _tmp[1];
+    for (int i = 0; i < numFrames; i++) {
+        _bw.process(inputL[i], inputR[i], bwL[i], bwR[i]);
+    }
+    _dl0.process(bwL, _preL, numFrames);
+    _dl1.process(bwR, _preR, numFrames);
+
+    // Early Left
+    processEarly(_preL, _early0L, _early1L, _early2L, _earlyOutL,
+                 _mt0, _ap0, _mt1, _ap1, _ap2, _mt2, _earlyMix1L, _earlyMix2L, numFrames);
+
+    // Early Right
+    processEarly(_preR, _early0R, _early1R, _early2R, _earlyOutR,
+                 _mt3, _ap3, _mt4, _ap4, _ap5, _mt5, _earlyMix1R, _earlyMix2R, numFrames);
+
+    float* outL = _tmp[0];
+    float* outR = _tmp[1];
+
+    for (int i = 0; i < numFrames; i++) {
+        float x0, y0, y1, y2, y3;
+
+        float early0L = _early0L[i];
+        float early1L = _early1L[i];
+        float early2L = _early2L[i];
+        float early0R = _early0R[i];
+        float early1R = _early1R[i];
+        float early2R = _early2R[i];
 
         // LFO update
         int32_t lfoSin, lfoCos;
@@ -1657,18 +1889,34 @@ void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
         _ap10.process(-early2R + y0 + y1, x0);
         _ap14.process(-early2L - y0 + y1, x0);
 
-        // Output Left
-        _ap18.process(-earlyOutL + lateOut0 + lateOut3, x0);
-        _ap19.process(x0, y0);
+        outL[i] = -_earlyOutL[i] + lateOut0 + lateOut3;
+        outR[i] = -_earlyOutR[i] + lateOut1 + lateOut2;
+    }
+
+    // Output Left
+    _ap18.process(outL, _tmp[2], numFrames);
+    _ap19.process(_tmp[2], _tmp[3], numFrames);
 
-        // Output Right
-        _ap20.process(-earlyOutR + lateOut1 + lateOut2, x1);
-        _ap21.process(x1, y1);
+    // Output Right
+    _ap20.process(outR, _tmp[4], numFrames);
+    _ap21.process(_tmp[4], _tmp[5], numFrames);
 
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        outputs[0][i] = x0 + (y0 - x0) * _wetDryMix;
-        outputs[1][i] = x1 + (y1 - x1) * _wetDryMix;
+    float* yL = _tmp[3];
+    float* yR = _tmp[5];
+    for (int i = 0; i < numFrames; i++) {
+        float x0 = inputL[i];
+        float x1 = inputR[i];
+        outputL[i] = x0 + (yL[i] - x0) * _wetDryMix;
+        outputR[i] = x1 + (yR[i] - x1) * _wetDryMix;
+    }
+}
+
+void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
+
+    for (int i = 0; i < numFrames; i += REVERB_BLOCK) {
+        int n = MIN(numFrames - i, REVERB_BLOCK);
+
+        processBlock(&inputs[0][i], &inputs[1][i], &outputs[0][i], &outputs[1][i], n);
     }
 }
 
@@ -1725,8 +1973,6 @@ void ReverbImpl::reset() {
 // Public API
 //
 
-static const int REVERB_BLOCK = 256;
-
 AudioReverb::AudioReverb(float sampleRate) {
 
     _impl = new ReverbImpl;
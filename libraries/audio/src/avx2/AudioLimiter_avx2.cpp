@@ -0,0 +1,265 @@
+//
+//  AudioLimiter_avx2.cpp
+//  libraries/audio/src
+//
+//  Created by Ken Cooke on 2/11/15.
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+#if defined(_MSC_VER)
+#define FORCEINLINE __forceinline
+#define ALIGN32 __declspec(align(32))
+#elif defined(__GNUC__)
+#define FORCEINLINE inline __attribute__((always_inline))
+#define ALIGN32 __attribute__((aligned(32)))
+#else
+#define FORCEINLINE inline
+#define ALIGN32
+#endif
+
+// must match AudioLimiter.cpp
+static const int LOG2_INTBITS = 5;
+static const int LOG2_FRACBITS = 31 - LOG2_INTBITS;
+static const int LOG2_HEADROOM = 15;
+
+static const int IEEE754_FABS_MASK = 0x7fffffff;
+static const int IEEE754_MANT_BITS = 23;
+static const int IEEE754_EXPN_BIAS = 127;
+
+//
+// P(x) = log2(1+x) for x=[0,1]
+// scaled by 1, 0.5, 0.25
+//
+static const int LOG2_TABBITS = 4;
+ALIGN32 static const int32_t log2Table[1 << LOG2_TABBITS][3] = {
+    { -0x56dfe26d, 0x5c46daff, 0x00000000 },
+    { -0x4d397571, 0x5bae58e7, 0x00025a75 },
+    { -0x4518f84b, 0x5aabcac4, 0x000a62db },
+    { -0x3e3075ec, 0x596168c0, 0x0019d0e6 },
+    { -0x384486e9, 0x57e769c7, 0x00316109 },
+    { -0x332742ba, 0x564f1461, 0x00513776 },
+    { -0x2eb4bad4, 0x54a4cdfe, 0x00791de2 },
+    { -0x2ad07c6c, 0x52f18320, 0x00a8aa46 },
+    { -0x2763c4d6, 0x513ba123, 0x00df574c },
+    { -0x245c319b, 0x4f87c5c4, 0x011c9399 },
+    { -0x21aac79f, 0x4dd93bef, 0x015fcb52 },
+    { -0x1f433872, 0x4c325584, 0x01a86ddc },
+    { -0x1d1b54b4, 0x4a94ac6e, 0x01f5f13e },
+    { -0x1b2a9f81, 0x4901524f, 0x0247d3f2 },
+    { -0x1969fa57, 0x4778f3a7, 0x029d9dbf },
+    { -0x17d36370, 0x45fbf1e8, 0x02f6dfe8 },
+};
+
+// (int32_t)(((int64_t)a * b) >> 32) for each element
+static FORCEINLINE __m256i mulhi_epi32(__m256i a, __m256i b) {
+
+    __m256i even = _mm256_mul_epi32(a, b);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+    return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xaa);
+}
+
+//
+// -log2(x) for 8 absolute peak values, as integer bits
+// x < 2^(31-LOG2_HEADROOM) returns 0x7fffffff
+// x > 2^LOG2_HEADROOM undefined
+//
+static FORCEINLINE __m256i log2_8(__m256i peak) {
+
+    // split into e and x - 1.0
+    __m256i e = _mm256_sub_epi32(_mm256_set1_epi32(IEEE754_EXPN_BIAS + LOG2_HEADROOM), _mm256_srli_epi32(peak, IEEE754_MANT_BITS));
+    __m256i x = _mm256_and_si256(_mm256_slli_epi32(peak, 31 - IEEE754_MANT_BITS), _mm256_set1_epi32(0x7fffffff));
+
+    // table index, scaled by row size
+    __m256i k = _mm256_srli_epi32(x, 31 - LOG2_TABBITS);
+    k = _mm256_add_epi32(k, _mm256_add_epi32(k, k));
+
+    // polynomial for log2(1+x) over x=[0,1]
+    __m256i c0 = _mm256_i32gather_epi32(&log2Table[0][0], k, 4);
+    __m256i c1 = _mm256_i32gather_epi32(&log2Table[0][1], k, 4);
+    __m256i c2 = _mm256_i32gather_epi32(&log2Table[0][2], k, 4);
+
+    c1 = _mm256_add_epi32(c1, mulhi_epi32(c0, x));
+    c2 = _mm256_add_epi32(c2, mulhi_epi32(c1, x));
+
+    // reconstruct result in Q26
+    __m256i result = _mm256_sub_epi32(_mm256_slli_epi32(e, LOG2_FRACBITS), _mm256_srai_epi32(c2, 3));
+
+    // saturate
+    __m256i saturate = _mm256_cmpgt_epi32(e, _mm256_set1_epi32(31));
+    return _mm256_blendv_epi8(result, _mm256_set1_epi32(0x7fffffff), saturate);
+}
+
+// absolute peak of 8 frames (mono)
+static FORCEINLINE __m256i peak_1x8(const float* input) {
+
+    __m256i u = _mm256_loadu_si256((__m256i*)&input[0]);
+
+    return _mm256_and_si256(u, _mm256_set1_epi32(IEEE754_FABS_MASK));
+}
+
+// absolute peak of 8 frames (stereo)
+static FORCEINLINE __m256i peak_2x8(const float* input) {
+
+    __m256 u0 = _mm256_loadu_ps(&input[0]);
+    __m256 u1 = _mm256_loadu_ps(&input[8]);
+
+    // deinterleave, in frame order 0,1,4,5,2,3,6,7
+    __m256i x0 = _mm256_castps_si256(_mm256_shuffle_ps(u0, u1, _MM_SHUFFLE(2,0,2,0)));
+    __m256i x1 = _mm256_castps_si256(_mm256_shuffle_ps(u0, u1, _MM_SHUFFLE(3,1,3,1)));
+
+    // max absolute value
+    x0 = _mm256_and_si256(x0, _mm256_set1_epi32(IEEE754_FABS_MASK));
+    x1 = _mm256_and_si256(x1, _mm256_set1_epi32(IEEE754_FABS_MASK));
+    x0 = _mm256_max_epi32(x0, x1);
+
+    // restore frame order
+    return _mm256_permute4x64_epi64(x0, _MM_SHUFFLE(3,1,2,0));
+}
+
+// absolute peak of 8 frames (quad)
+static FORCEINLINE __m256i peak_4x8(const float* input) {
+
+    __m256i x0 = _mm256_loadu_si256((__m256i*)&input[0]);
+    __m256i x1 = _mm256_loadu_si256((__m256i*)&input[8]);
+    __m256i x2 = _mm256_loadu_si256((__m256i*)&input[16]);
+    __m256i x3 = _mm256_loadu_si256((__m256i*)&input[24]);
+
+    x0 = _mm256_and_si256(x0, _mm256_set1_epi32(IEEE754_FABS_MASK));
+    x1 = _mm256_and_si256(x1, _mm256_set1_epi32(IEEE754_FABS_MASK));
+    x2 = _mm256_and_si256(x2, _mm256_set1_epi32(IEEE754_FABS_MASK));
+    x3 = _mm256_and_si256(x3, _mm256_set1_epi32(IEEE754_FABS_MASK));
+
+    // max absolute value, broadcast across each frame
+    x0 = _mm256_max_epi32(x0, _mm256_shuffle_epi32(x0, _MM_SHUFFLE(1,0,3,2)));
+    x1 = _mm256_max_epi32(x1, _mm256_shuffle_epi32(x1, _MM_SHUFFLE(1,0,3,2)));
+    x2 = _mm256_max_epi32(x2, _mm256_shuffle_epi32(x2, _MM_SHUFFLE(1,0,3,2)));
+    x3 = _mm256_max_epi32(x3, _mm256_shuffle_epi32(x3, _MM_SHUFFLE(1,0,3,2)));
+
+    x0 = _mm256_max_epi32(x0, _mm256_shuffle_epi32(x0, _MM_SHUFFLE(2,3,0,1)));
+    x1 = _mm256_max_epi32(x1, _mm256_shuffle_epi32(x1, _MM_SHUFFLE(2,3,0,1)));
+    x2 = _mm256_max_epi32(x2, _mm256_shuffle_epi32(x2, _MM_SHUFFLE(2,3,0,1)));
+    x3 = _mm256_max_epi32(x3, _mm256_shuffle_epi32(x3, _MM_SHUFFLE(2,3,0,1)));
+
+    // gather, in frame order 0,2,4,6,1,3,5,7
+    x0 = _mm256_blend_epi32(x0, x1, 0x22);
+    x2 = _mm256_blend_epi32(x2, x3, 0x88);
+    x0 = _mm256_blend_epi32(x0, x2, 0xcc);
+
+    // restore frame order
+    return _mm256_permutevar8x32_epi32(x0, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+static FORCEINLINE __m256i peak_8(const float* input, int numChannels) {
+    switch (numChannels) {
+    case 1: return peak_1x8(input);
+    case 2: return peak_2x8(input);
+    default: return peak_4x8(input);
+    }
+}
+
+void limiterPeak_AVX2(const float* input, int32_t* output, int numChannels, int numFrames) {
+
+    assert(numChannels == 1 || numChannels == 2 || numChannels == 4);
+
+    int n = 0;
+    for (; n < numFrames - 7; n += 8) {
+
+        __m256i peak = peak_8(&input[numChannels * n], numChannels);
+
+        _mm256_storeu_si256((__m256i*)&output[n], log2_8(peak));
+    }
+
+    // remaining frames, zero-padded
+    if (n < numFrames) {
+
+        ALIGN32 float x[4 * 8] = {};
+        ALIGN32 int32_t y[8];
+
+        memcpy(x, &input[numChannels * n], numChannels * (numFrames - n) * sizeof(float));
+
+        __m256i peak = peak_8(x, numChannels);
+
+        _mm256_store_si256((__m256i*)y, log2_8(peak));
+
+        memcpy(&output[n], y, (numFrames - n) * sizeof(int32_t));
+    }
+
+    _mm256_zeroupper();
+}
+
+// apply gain and dither to 8 samples, and round
+// NOTE: fused multiply-add can differ from the reference by 1 LSB
+static FORCEINLINE __m256i gain_8(const float* input, __m256 g, __m256 d) {
+
+    __m256 x = _mm256_loadu_ps(input);
+
+    x = _mm256_fmadd_ps(x, g, d);
+
+    return _mm256_cvtps_epi32(x);
+}
+
+// broadcast per-frame values to 8 interleaved samples
+static FORCEINLINE __m256 expand_8(const float* src, int numChannels) {
+    switch (numChannels) {
+    case 1:
+        return _mm256_loadu_ps(src);
+    case 2:
+        return _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)), _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3));
+    default:
+        return _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_castpd_ps(_mm_load_sd((const double*)src))), _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1));
+    }
+}
+
+void limiterOutput_AVX2(const float* input, const float* gain, const float* dither, int16_t* output,
+                        int numChannels, int numFrames) {
+
+    assert(numChannels == 1 || numChannels == 2 || numChannels == 4);
+
+    const int framesPerVector = 8 / numChannels;
+
+    int n = 0;
+    for (; n < numFrames - (2 * framesPerVector - 1); n += 2 * framesPerVector) {
+
+        int m = n + framesPerVector;
+
+        __m256i a0 = gain_8(&input[numChannels * n], expand_8(&gain[n], numChannels), expand_8(&dither[n], numChannels));
+        __m256i a1 = gain_8(&input[numChannels * m], expand_8(&gain[m], numChannels), expand_8(&dither[m], numChannels));
+
+        // saturate to 16-bit, restore order
+        a0 = _mm256_packs_epi32(a0, a1);
+        a0 = _mm256_permute4x64_epi64(a0, _MM_SHUFFLE(3,1,2,0));
+
+        _mm256_storeu_si256((__m256i*)&output[numChannels * n], a0);
+    }
+
+    // remaining frames
+    for (; n < numFrames; n++) {
+        for (int c = 0; c < numChannels; c++) {
+
+            __m128 x = _mm_load_ss(&input[numChannels * n + c]);
+
+            x = _mm_fmadd_ss(x, _mm_load_ss(&gain[n]), _mm_load_ss(&dither[n]));
+
+            output[numChannels * n + c] = (int16_t)_mm_cvt_ss2si(x);
+        }
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
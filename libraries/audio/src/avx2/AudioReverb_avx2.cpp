@@ -0,0 +1,48 @@
+//
+//  AudioReverb_avx2.cpp
+//  libraries/audio/src
+//
+//  Created by Ken Cooke on 10/11/15.
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <immintrin.h>  // AVX2
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+//
+// Allpass over a contiguous run, numFrames <= delay
+// src and dst may be the same buffer, since each vector is loaded before it is stored.
+// NOTE: fused multiply-add can differ from the reference by 1 ULP
+//
+void allpass_AVX2(const float* src, float* dst, const float* input, float* output, float coef, int numFrames) {
+
+    __m256 c = _mm256_set1_ps(coef);
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+        __m256 x = _mm256_loadu_ps(&input[i]);
+        __m256 y = _mm256_fnmadd_ps(c, x, _mm256_loadu_ps(&src[i]));   // feedforward path
+
+        _mm256_storeu_ps(&dst[i], _mm256_fmadd_ps(c, y, x));            // feedback path
+        _mm256_storeu_ps(&output[i], y);
+    }
+    for (; i < numFrames; i++) {
+        __m128 x = _mm_load_ss(&input[i]);
+        __m128 y = _mm_fnmadd_ss(_mm256_castps256_ps128(c), x, _mm_load_ss(&src[i]));
+
+        _mm_store_ss(&dst[i], _mm_fmadd_ss(_mm256_castps256_ps128(c), y, x));
+        _mm_store_ss(&output[i], y);
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -272,6 +272,8 @@ public:
         { _domainMinimumScale = glm::clamp(domainMinimumScale, MIN_AVATAR_SCALE, MAX_AVATAR_SCALE); }
     void setDomainMaximumScale(float domainMaximumScale)
         { _domainMaximumScale = glm::clamp(domainMaximumScale, MIN_AVATAR_SCALE, MAX_AVATAR_SCALE); }
+    float getDomainMinScale() const { return _domainMinimumScale; }
+    float getDomainMaxScale() const { return _domainMaximumScale; }
 
     //  Hand State
     Q_INVOKABLE void setHandState(char s) { _handState = s; }
@@ -337,6 +337,12 @@ public:
     QString getModelNameOfMesh(int meshIndex) const;
     
     QList<QString> blendshapeChannelNames;
+
+    /// Appends the geometry, as readFBX left it, to a blob that unserialize can rebuild it from
+    static bool serialize(const FBXGeometry& geometry, QByteArray& blob);
+
+    /// Rebuilds a geometry from a serialized blob, returns nullptr if the blob is invalid or from another version
+    static FBXGeometry* unserialize(const char* data, size_t size, const QString& url);
 };
 
 Q_DECLARE_METATYPE(FBXGeometry)
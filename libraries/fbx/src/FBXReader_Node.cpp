@@ -11,6 +11,7 @@
 
 #include "FBXReader.h"
 
+#include <climits>
 #include <iostream>
 #include <QtCore/QBuffer>
 #include <QtCore/QDataStream>
@@ -21,155 +22,183 @@
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
+#include <zlib.h>
+
 #include <shared/NsightHelpers.h>
 #include "ModelFormatLogging.h"
 
-template<class T> int streamSize() {
-    return sizeof(T);
-}
+// Reads the binary format straight from the file data, which is little endian like every platform we run on.
+class BinaryFBXReader {
+public:
+    BinaryFBXReader(const char* data, qint64 size, qint64 position) : _data(data), _size(size), _position(position) { }
 
-template<bool> int streamSize() {
-    return 1;
-}
+    qint64 getPosition() const { return _position; }
+
+    void seek(qint64 position) {
+        if (position < 0 || position > _size) {
+            throw QString("corrupt fbx file");
+        }
+        _position = position;
+    }
+
+    template<class T> T read() {
+        T value;
+        memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    const char* readBytes(qint64 length) {
+        if (length < 0 || _size - _position < length) {
+            throw QString("truncated fbx file");
+        }
+        const char* bytes = _data + _position;
+        _position += length;
+        return bytes;
+    }
+
+private:
+    const char* _data;
+    qint64 _size;
+    qint64 _position;
+};
 
-template<class T> QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
+// the top level nodes that extractFBXGeometry reads, the others (Definitions, Takes...) are skipped unparsed
+static const QList<QByteArray> TOP_LEVEL_NODES_READ = { "FBXHeaderExtension", "GlobalSettings", "Objects", "Connections" };
 
-    in >> arrayLength;
-    in >> encoding;
-    in >> compressedLength;
-    position += sizeof(quint32) * 3;
+// deflate can't expand data more than this, so larger arrays can only come from a corrupt length
+static const quint64 MAX_DEFLATE_RATIO = 1032;
+
+// the data of an array as it is in the file, read and checked before the array is allocated
+struct BinaryArrayData {
+    const char* bytes;
+    quint32 length;
+    bool deflated;
+};
+
+// checks that the file holds the data of an array of size bytes, so that corrupt lengths throw instead of allocating
+static BinaryArrayData readBinaryArrayData(BinaryFBXReader& in, quint64 size) {
+    quint32 encoding = in.read<quint32>();
+    quint32 compressedLength = in.read<quint32>();
 
-    QVector<T> values;
     const unsigned int DEFLATE_ENCODING = 1;
-    if (encoding == DEFLATE_ENCODING) {
-        // preface encoded data with uncompressed length
-        QByteArray compressed(sizeof(quint32) + compressedLength, 0);
-        *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-        in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-        position += compressedLength;
-        QByteArray uncompressed = qUncompress(compressed);
-        if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
+    BinaryArrayData data;
+    data.deflated = (encoding == DEFLATE_ENCODING);
+    data.length = data.deflated ? compressedLength : (quint32)size;
+    data.bytes = in.readBytes(data.deflated ? (qint64)compressedLength : (qint64)size);
+    if (data.deflated && size > compressedLength * MAX_DEFLATE_RATIO) {
+        throw QString("corrupt fbx file");
+    }
+    return data;
+}
+
+// copies the data of an array straight into its final buffer, inflating it if need be
+static void copyBinaryArrayData(const BinaryArrayData& data, char* destination, quint64 size) {
+    if (size == 0) {
+        return;
+    }
+    if (data.deflated) {
+        uLongf uncompressedLength = (uLongf)size;
+        if (uncompress((Bytef*)destination, &uncompressedLength, (const Bytef*)data.bytes, data.length) != Z_OK ||
+                uncompressedLength != size) {
             throw QString("corrupt fbx file");
         }
-        QDataStream uncompressedIn(uncompressed);
-        uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-        uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-        for (quint32 i = 0; i < arrayLength; i++) {
-            T value;
-            uncompressedIn >> value;
-            values.append(value);
-        }
     } else {
-        for (quint32 i = 0; i < arrayLength; i++) {
-            T value;
-            in >> value;
-            position += streamSize<T>();
-            values.append(value);
-        }
+        memcpy(destination, data.bytes, size);
+    }
+}
+
+// reads the length of an array, which has to fit a QVector
+template<class T> quint32 readBinaryArrayLength(BinaryFBXReader& in) {
+    quint32 arrayLength = in.read<quint32>();
+    if (arrayLength > (quint32)(INT_MAX / sizeof(T))) {
+        throw QString("corrupt fbx file");
     }
+    return arrayLength;
+}
+
+template<class T> QVariant readBinaryArray(BinaryFBXReader& in) {
+    quint32 arrayLength = readBinaryArrayLength<T>(in);
+    quint64 size = (quint64)arrayLength * sizeof(T);
+    BinaryArrayData data = readBinaryArrayData(in, size);
+    QVector<T> values(arrayLength);
+    copyBinaryArrayData(data, (char*)values.data(), size);
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+// bools are stored as bytes, which may hold other values than 0 and 1
+template<> QVariant readBinaryArray<bool>(BinaryFBXReader& in) {
+    quint32 arrayLength = readBinaryArrayLength<char>(in);
+    BinaryArrayData data = readBinaryArrayData(in, arrayLength);
+    QByteArray bytes(arrayLength, 0);
+    copyBinaryArrayData(data, bytes.data(), arrayLength);
+    QVector<bool> values(arrayLength);
+    for (quint32 i = 0; i < arrayLength; i++) {
+        values[i] = (bytes.at(i) != 0);
+    }
+    return QVariant::fromValue(values);
+}
+
+QVariant parseBinaryFBXProperty(BinaryFBXReader& in) {
+    char ch = in.read<char>();
     switch (ch) {
         case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint16>());
         }
         case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<quint8>() != 0);
         }
         case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint32>());
         }
         case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<float>());
         }
         case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<double>());
         }
         case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint64>());
         }
         case 'f': {
-            return readBinaryArray<float>(in, position);
+            return readBinaryArray<float>(in);
         }
         case 'd': {
-            return readBinaryArray<double>(in, position);
+            return readBinaryArray<double>(in);
         }
         case 'l': {
-            return readBinaryArray<qint64>(in, position);
+            return readBinaryArray<qint64>(in);
         }
         case 'i': {
-            return readBinaryArray<qint32>(in, position);
+            return readBinaryArray<qint32>(in);
         }
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            return readBinaryArray<bool>(in);
         }
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = in.read<quint32>();
+            return QVariant::fromValue(QByteArray(in.readBytes(length), length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode parseBinaryFBXNode(BinaryFBXReader& in, bool has64BitPositions, bool isTopLevel = false) {
     qint64 endOffset;
     quint64 propertyCount;
-    quint64 propertyListLength;
-    quint8 nameLength;
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
-    // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit 
-    // values and then assign to our actual 64bit values.
     if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+        endOffset = in.read<qint64>();
+        propertyCount = in.read<quint64>();
+        in.read<quint64>(); // property list length
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = in.read<qint32>();
+        propertyCount = in.read<quint32>();
+        in.read<quint32>(); // property list length
+    }
+    quint8 nameLength = in.read<quint8>();
 
     FBXNode node;
     const int MIN_VALID_OFFSET = 40;
@@ -177,15 +206,23 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    node.name = QByteArray(in.readBytes(nameLength), nameLength);
+
+    if (isTopLevel && !TOP_LEVEL_NODES_READ.contains(node.name)) {
+        // a node can't end before its name, nor send the top level loop back over it
+        if (endOffset <= in.getPosition()) {
+            throw QString("corrupt fbx file");
+        }
+        in.seek(endOffset);
+        return node;
+    }
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseBinaryFBXProperty(in));
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > in.getPosition()) {
+        FBXNode child = parseBinaryFBXNode(in, has64BitPositions);
         if (child.name.isNull()) {
             return node;
 
@@ -339,9 +376,16 @@ FBXNode FBXReader::parseFBX(QIODevice* device) {
         }
         return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
+    // parse in place when the file is already in memory
+    QByteArray data;
+    qint64 start = 0;
+    QBuffer* buffer = qobject_cast<QBuffer*>(device);
+    if (buffer) {
+        data = buffer->data();
+        start = buffer->pos();
+    } else {
+        data = device->readAll();
+    }
 
     // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
     // of the FBX binary format
@@ -352,18 +396,15 @@ FBXNode FBXReader::parseFBX(QIODevice* device) {
     //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
     const int HEADER_BEFORE_VERSION = 23;
     const quint32 VERSION_FBX2016 = 7500;
-    in.skipRawData(HEADER_BEFORE_VERSION);
-    int position = HEADER_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
+    BinaryFBXReader in(data.constData() + start, data.size() - start, HEADER_BEFORE_VERSION);
+    quint32 fileVersion = in.read<quint32>();
     qCDebug(modelformat) << "fileVersion:" << fileVersion;
     bool has64BitPositions = (fileVersion >= VERSION_FBX2016);
 
     // parse the top-level node
     FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (in.getPosition() < data.size() - start) {
+        FBXNode next = parseBinaryFBXNode(in, has64BitPositions, true);
         if (next.name.isNull()) {
             return top;
 
@@ -383,6 +424,7 @@ glm::vec3 FBXReader::getVec3(const QVariantList& properties, int index) {
 
 QVector<glm::vec4> FBXReader::createVec4Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -396,6 +438,7 @@ QVector<glm::vec4> FBXReader::createVec4Vector(const QVector<double>& doubleVect
 
 QVector<glm::vec4> FBXReader::createVec4VectorRGBA(const QVector<double>& doubleVector, glm::vec4& average) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -413,6 +456,7 @@ QVector<glm::vec4> FBXReader::createVec4VectorRGBA(const QVector<double>& double
 
 QVector<glm::vec3> FBXReader::createVec3Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec3> values;
+    values.reserve(doubleVector.size() / 3);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -424,6 +468,7 @@ QVector<glm::vec3> FBXReader::createVec3Vector(const QVector<double>& doubleVect
 
 QVector<glm::vec2> FBXReader::createVec2Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec2> values;
+    values.reserve(doubleVector.size() / 2);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
         float s = *it++;
         float t = *it++;
@@ -0,0 +1,518 @@
+//
+//  FBXReader_Serialization.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXReader.h"
+
+#include <string.h>
+#include <memory>
+
+#include "ModelFormatLogging.h"
+
+static const quint32 BAKED_GEOMETRY_MAGIC = 0x47424648; // "HFBG"
+
+// bump whenever FBXGeometry, or the way readFBX builds it, changes: geometry baked before is then processed again
+static const quint32 BAKED_GEOMETRY_VERSION = 1;
+
+// Geometry is baked in the layout of the platform that baked it, which is also the one that reads it back
+class BakedGeometryWriter {
+public:
+    BakedGeometryWriter(QByteArray& data) : _data(data) { }
+
+    template<class T> void write(const T& value) {
+        _data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<class T> void writeVector(const QVector<T>& values) {
+        write<quint32>(values.size());
+        _data.append(reinterpret_cast<const char*>(values.constData()), values.size() * sizeof(T));
+    }
+
+    void writeBytes(const QByteArray& bytes) {
+        write<quint32>(bytes.size());
+        _data.append(bytes);
+    }
+
+    void writeString(const QString& string) { writeBytes(string.toUtf8()); }
+
+    void writeTexture(const FBXTexture& texture);
+    void writeMaterial(const FBXMaterial& material);
+    void writeMesh(const FBXMesh& mesh);
+    void writeJoint(const FBXJoint& joint);
+
+private:
+    QByteArray& _data;
+};
+
+class BakedGeometryReader {
+public:
+    BakedGeometryReader(const char* data, size_t size) : _data(data), _size(size) { }
+
+    template<class T> T read() {
+        T value;
+        memcpy(&value, readRaw(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template<class T> QVector<T> readVector() {
+        quint32 count = read<quint32>();
+        const char* raw = readRaw((size_t)count * sizeof(T));
+        QVector<T> values(count);
+        memcpy(values.data(), raw, (size_t)count * sizeof(T));
+        return values;
+    }
+
+    QByteArray readBytes() {
+        quint32 size = read<quint32>();
+        return QByteArray(readRaw(size), size);
+    }
+
+    QString readString() { return QString::fromUtf8(readBytes()); }
+
+    FBXTexture readTexture();
+    FBXMaterial readMaterial();
+    FBXMesh readMesh(const QString& url);
+    FBXJoint readJoint();
+
+private:
+    const char* readRaw(size_t size) {
+        if (size > _size - _position) {
+            throw QString("truncated baked geometry");
+        }
+        const char* raw = _data + _position;
+        _position += size;
+        return raw;
+    }
+
+    const char* _data;
+    size_t _size;
+    size_t _position { 0 };
+};
+
+void BakedGeometryWriter::writeTexture(const FBXTexture& texture) {
+    writeString(texture.name);
+    writeBytes(texture.filename);
+    writeBytes(texture.content);
+    write(texture.transform.isIdentity());
+    if (!texture.transform.isIdentity()) {
+        write(texture.transform.getTranslation());
+        write(texture.transform.getRotation());
+        write(texture.transform.getScale());
+    }
+    write<qint32>(texture.texcoordSet);
+    writeString(texture.texcoordSetName);
+    write(texture.isBumpmap);
+}
+
+FBXTexture BakedGeometryReader::readTexture() {
+    FBXTexture texture;
+    texture.name = readString();
+    texture.filename = readBytes();
+    texture.content = readBytes();
+    if (!read<bool>()) {
+        texture.transform.setTranslation(read<glm::vec3>());
+        texture.transform.setRotation(read<glm::quat>());
+        texture.transform.setScale(read<glm::vec3>());
+    }
+    texture.texcoordSet = read<qint32>();
+    texture.texcoordSetName = readString();
+    texture.isBumpmap = read<bool>();
+    return texture;
+}
+
+void BakedGeometryWriter::writeMaterial(const FBXMaterial& material) {
+    write(material.diffuseColor);
+    write(material.diffuseFactor);
+    write(material.specularColor);
+    write(material.specularFactor);
+    write(material.emissiveColor);
+    write(material.emissiveFactor);
+    write(material.shininess);
+    write(material.opacity);
+    write(material.metallic);
+    write(material.roughness);
+    write(material.emissiveIntensity);
+    write(material.ambientFactor);
+
+    writeString(material.materialID);
+    writeString(material.name);
+    writeString(material.shadingModel);
+
+    // the values consolidateFBXMaterials settled on, in linear space so they come back exactly
+    write((bool)material._material);
+    if (material._material) {
+        write(material._material->getEmissive(false));
+        write(material._material->getAlbedo(false));
+        write(material._material->getRoughness());
+        write(material._material->getMetallic());
+        write(material._material->getScattering());
+        write(material._material->getOpacity());
+        write(material._material->isUnlit());
+    }
+
+    for (auto texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+            &material.glossTexture, &material.roughnessTexture, &material.specularTexture, &material.metallicTexture,
+            &material.emissiveTexture, &material.occlusionTexture, &material.scatteringTexture,
+            &material.lightmapTexture }) {
+        writeTexture(*texture);
+    }
+    write(material.lightmapParams);
+
+    write(material.isPBSMaterial);
+    write(material.useNormalMap);
+    write(material.useAlbedoMap);
+    write(material.useOpacityMap);
+    write(material.useRoughnessMap);
+    write(material.useSpecularMap);
+    write(material.useMetallicMap);
+    write(material.useEmissiveMap);
+    write(material.useOcclusionMap);
+}
+
+FBXMaterial BakedGeometryReader::readMaterial() {
+    FBXMaterial material;
+    material.diffuseColor = read<glm::vec3>();
+    material.diffuseFactor = read<float>();
+    material.specularColor = read<glm::vec3>();
+    material.specularFactor = read<float>();
+    material.emissiveColor = read<glm::vec3>();
+    material.emissiveFactor = read<float>();
+    material.shininess = read<float>();
+    material.opacity = read<float>();
+    material.metallic = read<float>();
+    material.roughness = read<float>();
+    material.emissiveIntensity = read<float>();
+    material.ambientFactor = read<float>();
+
+    material.materialID = readString();
+    material.name = readString();
+    material.shadingModel = readString();
+
+    if (read<bool>()) {
+        material._material = std::make_shared<model::Material>();
+        material._material->setEmissive(read<glm::vec3>(), false);
+        material._material->setAlbedo(read<glm::vec3>(), false);
+        material._material->setRoughness(read<float>());
+        material._material->setMetallic(read<float>());
+        float scattering = read<float>();
+        if (scattering > 0.0f) {
+            material._material->setScattering(scattering);
+        }
+        material._material->setOpacity(read<float>());
+        material._material->setUnlit(read<bool>());
+    }
+
+    for (auto texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+            &material.glossTexture, &material.roughnessTexture, &material.specularTexture, &material.metallicTexture,
+            &material.emissiveTexture, &material.occlusionTexture, &material.scatteringTexture,
+            &material.lightmapTexture }) {
+        *texture = readTexture();
+    }
+    material.lightmapParams = read<glm::vec2>();
+
+    material.isPBSMaterial = read<bool>();
+    material.useNormalMap = read<bool>();
+    material.useAlbedoMap = read<bool>();
+    material.useOpacityMap = read<bool>();
+    material.useRoughnessMap = read<bool>();
+    material.useSpecularMap = read<bool>();
+    material.useMetallicMap = read<bool>();
+    material.useEmissiveMap = read<bool>();
+    material.useOcclusionMap = read<bool>();
+    return material;
+}
+
+void BakedGeometryWriter::writeMesh(const FBXMesh& mesh) {
+    write<quint32>(mesh.parts.size());
+    for (auto& part : mesh.parts) {
+        writeVector(part.quadIndices);
+        writeVector(part.quadTrianglesIndices);
+        writeVector(part.triangleIndices);
+        writeString(part.materialID);
+    }
+
+    writeVector(mesh.vertices);
+    writeVector(mesh.normals);
+    writeVector(mesh.tangents);
+    writeVector(mesh.colors);
+    writeVector(mesh.texCoords);
+    writeVector(mesh.texCoords1);
+    writeVector(mesh.clusterIndices);
+    writeVector(mesh.clusterWeights);
+
+    write<quint32>(mesh.clusters.size());
+    for (auto& cluster : mesh.clusters) {
+        write<qint32>(cluster.jointIndex);
+        write(cluster.inverseBindMatrix);
+    }
+
+    write(mesh.meshExtents.minimum);
+    write(mesh.meshExtents.maximum);
+    write(mesh.modelTransform);
+    write(mesh.isEye);
+
+    write<quint32>(mesh.blendshapes.size());
+    for (auto& blendshape : mesh.blendshapes) {
+        writeVector(blendshape.indices);
+        writeVector(blendshape.vertices);
+        writeVector(blendshape.normals);
+    }
+
+    write<quint32>(mesh.meshIndex);
+}
+
+FBXMesh BakedGeometryReader::readMesh(const QString& url) {
+    FBXMesh mesh;
+    mesh.parts.resize(read<quint32>());
+    for (auto& part : mesh.parts) {
+        part.quadIndices = readVector<int>();
+        part.quadTrianglesIndices = readVector<int>();
+        part.triangleIndices = readVector<int>();
+        part.materialID = readString();
+    }
+
+    mesh.vertices = readVector<glm::vec3>();
+    mesh.normals = readVector<glm::vec3>();
+    mesh.tangents = readVector<glm::vec3>();
+    mesh.colors = readVector<glm::vec3>();
+    mesh.texCoords = readVector<glm::vec2>();
+    mesh.texCoords1 = readVector<glm::vec2>();
+    mesh.clusterIndices = readVector<glm::vec4>();
+    mesh.clusterWeights = readVector<glm::vec4>();
+
+    mesh.clusters.resize(read<quint32>());
+    for (auto& cluster : mesh.clusters) {
+        cluster.jointIndex = read<qint32>();
+        cluster.inverseBindMatrix = read<glm::mat4>();
+    }
+
+    mesh.meshExtents.minimum = read<glm::vec3>();
+    mesh.meshExtents.maximum = read<glm::vec3>();
+    mesh.modelTransform = read<glm::mat4>();
+    mesh.isEye = read<bool>();
+
+    mesh.blendshapes.resize(read<quint32>());
+    for (auto& blendshape : mesh.blendshapes) {
+        blendshape.indices = readVector<int>();
+        blendshape.vertices = readVector<glm::vec3>();
+        blendshape.normals = readVector<glm::vec3>();
+    }
+
+    mesh.meshIndex = read<quint32>();
+
+    // only the packing into gpu buffers is left to do
+    FBXReader::buildModelMesh(mesh, url);
+    return mesh;
+}
+
+void BakedGeometryWriter::writeJoint(const FBXJoint& joint) {
+    writeVector(joint.shapeInfo.points);
+    writeVector(joint.freeLineage);
+    write(joint.isFree);
+    write<qint32>(joint.parentIndex);
+    write(joint.distanceToParent);
+    write(joint.translation);
+    write(joint.preTransform);
+    write(joint.preRotation);
+    write(joint.rotation);
+    write(joint.postRotation);
+    write(joint.postTransform);
+    write(joint.transform);
+    write(joint.rotationMin);
+    write(joint.rotationMax);
+    write(joint.inverseDefaultRotation);
+    write(joint.inverseBindRotation);
+    write(joint.bindTransform);
+    writeString(joint.name);
+    write(joint.isSkeletonJoint);
+    write(joint.bindTransformFoundInCluster);
+    write(joint.hasGeometricOffset);
+    write(joint.geometricTranslation);
+    write(joint.geometricRotation);
+    write(joint.geometricScaling);
+}
+
+FBXJoint BakedGeometryReader::readJoint() {
+    FBXJoint joint;
+    joint.shapeInfo.points = readVector<glm::vec3>();
+    joint.freeLineage = readVector<int>();
+    joint.isFree = read<bool>();
+    joint.parentIndex = read<qint32>();
+    joint.distanceToParent = read<float>();
+    joint.translation = read<glm::vec3>();
+    joint.preTransform = read<glm::mat4>();
+    joint.preRotation = read<glm::quat>();
+    joint.rotation = read<glm::quat>();
+    joint.postRotation = read<glm::quat>();
+    joint.postTransform = read<glm::mat4>();
+    joint.transform = read<glm::mat4>();
+    joint.rotationMin = read<glm::vec3>();
+    joint.rotationMax = read<glm::vec3>();
+    joint.inverseDefaultRotation = read<glm::quat>();
+    joint.inverseBindRotation = read<glm::quat>();
+    joint.bindTransform = read<glm::mat4>();
+    joint.name = readString();
+    joint.isSkeletonJoint = read<bool>();
+    joint.bindTransformFoundInCluster = read<bool>();
+    joint.hasGeometricOffset = read<bool>();
+    joint.geometricTranslation = read<glm::vec3>();
+    joint.geometricRotation = read<glm::quat>();
+    joint.geometricScaling = read<glm::vec3>();
+    return joint;
+}
+
+bool FBXGeometry::serialize(const FBXGeometry& geometry, QByteArray& blob) {
+    BakedGeometryWriter out(blob);
+    out.write(BAKED_GEOMETRY_MAGIC);
+    out.write(BAKED_GEOMETRY_VERSION);
+
+    out.writeString(geometry.author);
+    out.writeString(geometry.applicationName);
+
+    out.write<quint32>(geometry.joints.size());
+    for (auto& joint : geometry.joints) {
+        out.writeJoint(joint);
+    }
+    out.write<quint32>(geometry.jointIndices.size());
+    for (auto it = geometry.jointIndices.constBegin(); it != geometry.jointIndices.constEnd(); it++) {
+        out.writeString(it.key());
+        out.write<qint32>(it.value());
+    }
+    out.write(geometry.hasSkeletonJoints);
+
+    out.write<quint32>(geometry.meshes.size());
+    for (auto& mesh : geometry.meshes) {
+        out.writeMesh(mesh);
+    }
+
+    out.write<quint32>(geometry.materials.size());
+    for (auto it = geometry.materials.constBegin(); it != geometry.materials.constEnd(); it++) {
+        out.writeString(it.key());
+        out.writeMaterial(it.value());
+    }
+
+    out.write(geometry.offset);
+    for (int index : { geometry.leftEyeJointIndex, geometry.rightEyeJointIndex, geometry.neckJointIndex,
+            geometry.rootJointIndex, geometry.leanJointIndex, geometry.headJointIndex, geometry.leftHandJointIndex,
+            geometry.rightHandJointIndex, geometry.leftToeJointIndex, geometry.rightToeJointIndex }) {
+        out.write<qint32>(index);
+    }
+    out.write(geometry.leftEyeSize);
+    out.write(geometry.rightEyeSize);
+    out.writeVector(geometry.humanIKJointIndices);
+    out.write(geometry.palmDirection);
+
+    out.write<quint32>(geometry.sittingPoints.size());
+    for (auto& sittingPoint : geometry.sittingPoints) {
+        out.writeString(sittingPoint.name);
+        out.write(sittingPoint.position);
+        out.write(sittingPoint.rotation);
+    }
+
+    out.write(geometry.neckPivot);
+    out.write(geometry.bindExtents.minimum);
+    out.write(geometry.bindExtents.maximum);
+    out.write(geometry.meshExtents.minimum);
+    out.write(geometry.meshExtents.maximum);
+
+    out.write<quint32>(geometry.animationFrames.size());
+    for (auto& frame : geometry.animationFrames) {
+        out.writeVector(frame.rotations);
+        out.writeVector(frame.translations);
+    }
+
+    out.write<quint32>(geometry.meshIndicesToModelNames.size());
+    for (auto it = geometry.meshIndicesToModelNames.constBegin(); it != geometry.meshIndicesToModelNames.constEnd(); it++) {
+        out.write<qint32>(it.key());
+        out.writeString(it.value());
+    }
+
+    out.write<quint32>(geometry.blendshapeChannelNames.size());
+    for (auto& name : geometry.blendshapeChannelNames) {
+        out.writeString(name);
+    }
+    return true;
+}
+
+FBXGeometry* FBXGeometry::unserialize(const char* data, size_t size, const QString& url) {
+    std::unique_ptr<FBXGeometry> geometry(new FBXGeometry());
+    try {
+        BakedGeometryReader in(data, size);
+        if (in.read<quint32>() != BAKED_GEOMETRY_MAGIC || in.read<quint32>() != BAKED_GEOMETRY_VERSION) {
+            return nullptr;
+        }
+
+        geometry->author = in.readString();
+        geometry->applicationName = in.readString();
+
+        geometry->joints.resize(in.read<quint32>());
+        for (auto& joint : geometry->joints) {
+            joint = in.readJoint();
+        }
+        for (quint32 i = 0, count = in.read<quint32>(); i < count; i++) {
+            QString name = in.readString();
+            geometry->jointIndices.insert(name, in.read<qint32>());
+        }
+        geometry->hasSkeletonJoints = in.read<bool>();
+
+        geometry->meshes.resize(in.read<quint32>());
+        for (auto& mesh : geometry->meshes) {
+            mesh = in.readMesh(url);
+        }
+
+        for (quint32 i = 0, count = in.read<quint32>(); i < count; i++) {
+            QString materialID = in.readString();
+            geometry->materials.insert(materialID, in.readMaterial());
+        }
+
+        geometry->offset = in.read<glm::mat4>();
+        for (int* index : { &geometry->leftEyeJointIndex, &geometry->rightEyeJointIndex, &geometry->neckJointIndex,
+                &geometry->rootJointIndex, &geometry->leanJointIndex, &geometry->headJointIndex,
+                &geometry->leftHandJointIndex, &geometry->rightHandJointIndex, &geometry->leftToeJointIndex,
+                &geometry->rightToeJointIndex }) {
+            *index = in.read<qint32>();
+        }
+        geometry->leftEyeSize = in.read<float>();
+        geometry->rightEyeSize = in.read<float>();
+        geometry->humanIKJointIndices = in.readVector<int>();
+        geometry->palmDirection = in.read<glm::vec3>();
+
+        geometry->sittingPoints.resize(in.read<quint32>());
+        for (auto& sittingPoint : geometry->sittingPoints) {
+            sittingPoint.name = in.readString();
+            sittingPoint.position = in.read<glm::vec3>();
+            sittingPoint.rotation = in.read<glm::quat>();
+        }
+
+        geometry->neckPivot = in.read<glm::vec3>();
+        geometry->bindExtents.minimum = in.read<glm::vec3>();
+        geometry->bindExtents.maximum = in.read<glm::vec3>();
+        geometry->meshExtents.minimum = in.read<glm::vec3>();
+        geometry->meshExtents.maximum = in.read<glm::vec3>();
+
+        geometry->animationFrames.resize(in.read<quint32>());
+        for (auto& frame : geometry->animationFrames) {
+            frame.rotations = in.readVector<glm::quat>();
+            frame.translations = in.readVector<glm::vec3>();
+        }
+
+        for (quint32 i = 0, count = in.read<quint32>(); i < count; i++) {
+            int meshIndex = in.read<qint32>();
+            geometry->meshIndicesToModelNames.insert(meshIndex, in.readString());
+        }
+
+        for (quint32 i = 0, count = in.read<quint32>(); i < count; i++) {
+            geometry->blendshapeChannelNames.append(in.readString());
+        }
+    } catch (const QString& error) {
+        qCDebug(modelformat) << "Error reading baked geometry for" << url << ":" << error;
+        return nullptr;
+    }
+    return geometry.release();
+}
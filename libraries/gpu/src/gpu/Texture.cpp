@@ -20,6 +20,7 @@
 #include <Trace.h>
 
 #include <NumericalConstants.h>
+#include <shared/ParallelFor.h>
 
 #include "GPULogging.h"
 #include "Context.h"
@@ -777,8 +778,6 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
         resultG[i] = 0;
         resultB[i] = 0;
     }
-    std::vector<float> shBuff(sqOrder);
-    std::vector<float> shBuffB(sqOrder);
 
     // We trade accuracy for speed by breaking the image into 32x32 parts
     // and approximating the distance for all the pixels in each part to be
@@ -789,17 +788,44 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
     }
     int stride = width / numDivisionsPerSide;
     int halfStride = stride / 2;
+    int numRows = (width - 2 * halfStride + stride - 1) / stride;
 
-    // for each face of cube texture
+    struct FaceData {
+        const Byte* data;
+        int numComponents;
+    };
+    std::vector<FaceData> faces(gpu::Texture::NUM_CUBE_FACES);
     for(int face=0; face < gpu::Texture::NUM_CUBE_FACES; face++) {
-        PROFILE_RANGE(render_gpu, "ProcessFace");
+        faces[face].numComponents = cubeTexture.accessStoredMipFace(0,face)->getFormat().getScalarCount();
+        faces[face].data = cubeTexture.accessStoredMipFace(0,face)->readData();
+    }
+
+    // Each row of parts of each face is projected on its own, and the partial sums are added in order
+    // so that the result does not depend on the scheduling
+    struct Partial {
+        std::vector<float> R, G, B;
+        float weight { 0.0f };
+    };
+    std::vector<Partial> partials(gpu::Texture::NUM_CUBE_FACES * numRows);
+
+    parallelFor((int)partials.size(), [&](int task) {
+        int face = task / numRows;
+        int y = halfStride + (task % numRows) * stride;
 
-        auto numComponents = cubeTexture.accessStoredMipFace(0,face)->getFormat().getScalarCount();
-        auto data = cubeTexture.accessStoredMipFace(0,face)->readData();
+        auto numComponents = faces[face].numComponents;
+        auto data = faces[face].data;
         if (data == nullptr) {
-            continue;
+            return;
         }
 
+        Partial& partial = partials[task];
+        partial.R.assign(sqOrder, 0.0f);
+        partial.G.assign(sqOrder, 0.0f);
+        partial.B.assign(sqOrder, 0.0f);
+
+        std::vector<float> shBuff(sqOrder);
+        std::vector<float> shBuffB(sqOrder);
+
         // step between two texels for range [0, 1]
         float invWidth = 1.0f / float(width);
         // initial negative bound for range [-1, 1]
@@ -807,100 +833,105 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
         // step between two texels for range [-1, 1]
         float invWidthBy2 = 2.0f / float(width);
 
-        for(int y=halfStride; y < width-halfStride; y += stride) {
-            // texture coordinate V in range [-1 to 1]
-            const float fV = negativeBound + float(y) * invWidthBy2;
-
-            for(int x=halfStride; x < width - halfStride; x += stride) {
-                // texture coordinate U in range [-1 to 1]
-                const float fU = negativeBound + float(x) * invWidthBy2;
-
-                // determine direction from center of cube texture to current texel
-                glm::vec3 dir;
-                switch(face) {
-                case gpu::Texture::CUBE_FACE_RIGHT_POS_X: {
-                    dir.x = 1.0f;
-                    dir.y = 1.0f - (invWidthBy2 * float(y) + invWidth);
-                    dir.z = 1.0f - (invWidthBy2 * float(x) + invWidth);
-                    dir = -dir;
-                    break;
-                }
-                case gpu::Texture::CUBE_FACE_LEFT_NEG_X: {
-                    dir.x = -1.0f;
-                    dir.y = 1.0f - (invWidthBy2 * float(y) + invWidth);
-                    dir.z = -1.0f + (invWidthBy2 * float(x) + invWidth);
-                    dir = -dir;
-                    break;
-                }
-                case gpu::Texture::CUBE_FACE_TOP_POS_Y: {
-                    dir.x = - 1.0f + (invWidthBy2 * float(x) + invWidth);
-                    dir.y = 1.0f;
-                    dir.z = - 1.0f + (invWidthBy2 * float(y) + invWidth);
-                    dir = -dir;
-                    break;
-                }
-                case gpu::Texture::CUBE_FACE_BOTTOM_NEG_Y: {
-                    dir.x = - 1.0f + (invWidthBy2 * float(x) + invWidth);
-                    dir.y = - 1.0f;
-                    dir.z = 1.0f - (invWidthBy2 * float(y) + invWidth);
-                    dir = -dir;
-                    break;
-                }
-                case gpu::Texture::CUBE_FACE_BACK_POS_Z: {
-                    dir.x = - 1.0f + (invWidthBy2 * float(x) + invWidth);
-                    dir.y = 1.0f - (invWidthBy2 * float(y) + invWidth);
-                    dir.z = 1.0f;
-                    break;
-                }
-                case gpu::Texture::CUBE_FACE_FRONT_NEG_Z: {
-                    dir.x = 1.0f - (invWidthBy2 * float(x) + invWidth);
-                    dir.y = 1.0f - (invWidthBy2 * float(y) + invWidth);
-                    dir.z = - 1.0f;
-                    break;
-                }
-                default:
-                    return false;
-                }
+        // texture coordinate V in range [-1 to 1]
+        const float fV = negativeBound + float(y) * invWidthBy2;
+
+        for(int x=halfStride; x < width - halfStride; x += stride) {
+            // texture coordinate U in range [-1 to 1]
+            const float fU = negativeBound + float(x) * invWidthBy2;
+
+            // determine direction from center of cube texture to current texel
+            glm::vec3 dir;
+            switch(face) {
+            case gpu::Texture::CUBE_FACE_RIGHT_POS_X: {
+                dir.x = 1.0f;
+                dir.y = 1.0f - (invWidthBy2 * float(y) + invWidth);
+                dir.z = 1.0f - (invWidthBy2 * float(x) + invWidth);
+                dir = -dir;
+                break;
+            }
+            case gpu::Texture::CUBE_FACE_LEFT_NEG_X: {
+                dir.x = -1.0f;
+                dir.y = 1.0f - (invWidthBy2 * float(y) + invWidth);
+                dir.z = -1.0f + (invWidthBy2 * float(x) + invWidth);
+                dir = -dir;
+                break;
+            }
+            case gpu::Texture::CUBE_FACE_TOP_POS_Y: {
+                dir.x = - 1.0f + (invWidthBy2 * float(x) + invWidth);
+                dir.y = 1.0f;
+                dir.z = - 1.0f + (invWidthBy2 * float(y) + invWidth);
+                dir = -dir;
+                break;
+            }
+            case gpu::Texture::CUBE_FACE_BOTTOM_NEG_Y: {
+                dir.x = - 1.0f + (invWidthBy2 * float(x) + invWidth);
+                dir.y = - 1.0f;
+                dir.z = 1.0f - (invWidthBy2 * float(y) + invWidth);
+                dir = -dir;
+                break;
+            }
+            case gpu::Texture::CUBE_FACE_BACK_POS_Z: {
+                dir.x = - 1.0f + (invWidthBy2 * float(x) + invWidth);
+                dir.y = 1.0f - (invWidthBy2 * float(y) + invWidth);
+                dir.z = 1.0f;
+                break;
+            }
+            case gpu::Texture::CUBE_FACE_FRONT_NEG_Z:
+            default: {
+                dir.x = 1.0f - (invWidthBy2 * float(x) + invWidth);
+                dir.y = 1.0f - (invWidthBy2 * float(y) + invWidth);
+                dir.z = - 1.0f;
+                break;
+            }
+            }
 
-                // normalize direction
-                dir = glm::normalize(dir);
-
-                // scale factor depending on distance from center of the face
-                const float fDiffSolid = 4.0f / ((1.0f + fU*fU + fV*fV) *
-                                            sqrtf(1.0f + fU*fU + fV*fV));
-                fWt += fDiffSolid;
-
-                // calculate coefficients of spherical harmonics for current direction
-                sphericalHarmonicsEvaluateDirection(shBuff.data(), order, dir);
-
-                // index of texel in texture
-
-                // get color from texture and map to range [0, 1]
-                float red { 0.0f };
-                float green { 0.0f };
-                float blue { 0.0f };
-                for (int i = 0; i < stride; ++i) {
-                    for (int j = 0; j < stride; ++j) {
-                        int k = (int)(x + i - halfStride + (y + j - halfStride) * width) * numComponents;
-                        red += ColorUtils::sRGB8ToLinearFloat(data[k]);
-                        green += ColorUtils::sRGB8ToLinearFloat(data[k + 1]);
-                        blue += ColorUtils::sRGB8ToLinearFloat(data[k + 2]);
-                    }
+            // normalize direction
+            dir = glm::normalize(dir);
+
+            // scale factor depending on distance from center of the face
+            const float fDiffSolid = 4.0f / ((1.0f + fU*fU + fV*fV) *
+                                        sqrtf(1.0f + fU*fU + fV*fV));
+            partial.weight += fDiffSolid;
+
+            // calculate coefficients of spherical harmonics for current direction
+            sphericalHarmonicsEvaluateDirection(shBuff.data(), order, dir);
+
+            // get color from texture and map to range [0, 1]
+            float red { 0.0f };
+            float green { 0.0f };
+            float blue { 0.0f };
+            for (int i = 0; i < stride; ++i) {
+                for (int j = 0; j < stride; ++j) {
+                    int k = (int)(x + i - halfStride + (y + j - halfStride) * width) * numComponents;
+                    red += ColorUtils::sRGB8ToLinearFloat(data[k]);
+                    green += ColorUtils::sRGB8ToLinearFloat(data[k + 1]);
+                    blue += ColorUtils::sRGB8ToLinearFloat(data[k + 2]);
                 }
-                glm::vec3 clr(red, green, blue);
-
-                // scale color and add to previously accumulated coefficients
-                // red
-                sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.r * fDiffSolid);
-                sphericalHarmonicsAdd(resultR.data(), order, resultR.data(), shBuffB.data());
-                // green
-                sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.g * fDiffSolid);
-                sphericalHarmonicsAdd(resultG.data(), order, resultG.data(), shBuffB.data());
-                // blue
-                sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.b * fDiffSolid);
-                sphericalHarmonicsAdd(resultB.data(), order, resultB.data(), shBuffB.data());
             }
+            glm::vec3 clr(red, green, blue);
+
+            // scale color and add to previously accumulated coefficients
+            // red
+            sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.r * fDiffSolid);
+            sphericalHarmonicsAdd(partial.R.data(), order, partial.R.data(), shBuffB.data());
+            // green
+            sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.g * fDiffSolid);
+            sphericalHarmonicsAdd(partial.G.data(), order, partial.G.data(), shBuffB.data());
+            // blue
+            sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.b * fDiffSolid);
+            sphericalHarmonicsAdd(partial.B.data(), order, partial.B.data(), shBuffB.data());
+        }
+    });
+
+    for (auto& partial : partials) {
+        if (partial.R.empty()) {
+            continue;
         }
+        fWt += partial.weight;
+        sphericalHarmonicsAdd(resultR.data(), order, resultR.data(), partial.R.data());
+        sphericalHarmonicsAdd(resultG.data(), order, resultG.data(), partial.G.data());
+        sphericalHarmonicsAdd(resultB.data(), order, resultB.data(), partial.B.data());
     }
 
     // final scale for coefficients
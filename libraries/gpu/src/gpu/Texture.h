@@ -135,6 +135,8 @@ public:
     uint8 getMinMip() const { return _desc._minMip; }
     uint8 getMaxMip() const { return _desc._maxMip; }
 
+    const Desc& getDesc() const { return _desc; }
+
 protected:
     Desc _desc;
 };
@@ -475,6 +477,14 @@ public:
 
     ExternalUpdates getUpdates() const;
 
+    // Flatten the sysmem version of the texture (stored mips, sampler, usage and irradiance) into a blob
+    // Each mip face is aligned in the blob so it can be assigned straight from a memory mapped file
+    // Must be called before the mips are uploaded, since the backend releases the sysmem
+    static bool serialize(const Texture& texture, std::vector<Byte>& blob);
+
+    // Rebuild a texture from a serialized blob, returns nullptr if the blob is invalid or from another version
+    static Texture* unserialize(const Byte* data, Size size);
+
 protected:
     // Should only be accessed internally or by the backend sync function
     mutable Mutex _externalMutex;
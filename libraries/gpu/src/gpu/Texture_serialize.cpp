@@ -0,0 +1,204 @@
+//
+//  Texture_serialize.cpp
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Texture.h"
+
+#include <string.h>
+
+using namespace gpu;
+
+namespace {
+
+const uint32 BLOB_MAGIC = 0x58544648;   // "HFTX"
+const uint32 BLOB_VERSION = 1;
+
+// mip faces are aligned for direct upload
+const Size BLOB_ALIGNMENT = 16;
+
+struct BlobHeader {
+    uint32 magic;
+    uint32 version;
+    uint32 headerSize;      // catches any change to the layout of the structs below
+
+    uint8 type;
+    uint8 formatSemantic;
+    uint8 formatDimension;
+    uint8 formatType;
+
+    uint16 width;
+    uint16 height;
+    uint16 depth;
+    uint16 numSamples;
+    uint16 numSlices;
+    uint16 maxMip;
+    uint16 numMips;         // number of entries per face in the mip table
+    uint8 numFaces;
+    uint8 autoGenerateMips;
+
+    uint8 hasIrradiance;
+    uint8 isIrradianceValid;
+    uint8 spare[2];
+    uint32 usage;
+
+    Sampler::Desc sampler;
+    SphericalHarmonics irradiance;
+};
+
+// one entry per (mip, face), mip major
+struct BlobMipFace {
+    uint8 formatSemantic;
+    uint8 formatDimension;
+    uint8 formatType;
+    uint8 spare;
+    uint32 size;            // 0 if the mip face is not stored
+    uint64_t offset;        // from the start of the blob
+};
+
+Size alignBlob(Size offset) {
+    return (offset + BLOB_ALIGNMENT - 1) & ~(BLOB_ALIGNMENT - 1);
+}
+
+}
+
+bool Texture::serialize(const Texture& texture, std::vector<Byte>& blob) {
+    if (!texture._storage || texture.getUsage().isExternal()) {
+        return false;
+    }
+
+    BlobHeader header;
+    memset(&header, 0, sizeof(header));
+
+    header.magic = BLOB_MAGIC;
+    header.version = BLOB_VERSION;
+    header.headerSize = sizeof(BlobHeader);
+
+    header.type = texture.getType();
+    header.formatSemantic = texture.getTexelFormat().getSemantic();
+    header.formatDimension = texture.getTexelFormat().getDimension();
+    header.formatType = texture.getTexelFormat().getType();
+
+    header.width = texture.getWidth();
+    header.height = texture.getHeight();
+    header.depth = texture.getDepth();
+    header.numSamples = texture.getNumSamples();
+    header.numSlices = texture.getNumSlices();
+    header.maxMip = texture.maxMip();
+    header.numMips = texture.maxMip() + 1;
+    header.numFaces = texture.getNumFaces();
+    header.autoGenerateMips = texture.isAutogenerateMips();
+
+    header.hasIrradiance = (texture._irradiance != nullptr);
+    header.isIrradianceValid = texture.isIrradianceValid();
+    header.usage = (uint32)texture.getUsage()._flags.to_ulong();
+
+    header.sampler = texture.getSampler().getDesc();
+    if (texture._irradiance) {
+        header.irradiance = *texture._irradiance;
+    }
+
+    // lay out the mip table, then the aligned mip faces
+    std::vector<BlobMipFace> table(header.numMips * header.numFaces);
+    memset(table.data(), 0, table.size() * sizeof(BlobMipFace));
+
+    Size offset = alignBlob(sizeof(BlobHeader) + table.size() * sizeof(BlobMipFace));
+    for (uint16 level = 0; level < header.numMips; level++) {
+        for (uint8 face = 0; face < header.numFaces; face++) {
+            auto& entry = table[level * header.numFaces + face];
+            auto mipFace = texture.accessStoredMipFace(level, face);
+            if (mipFace && mipFace->getSize() && mipFace->readData()) {
+                entry.formatSemantic = mipFace->getFormat().getSemantic();
+                entry.formatDimension = mipFace->getFormat().getDimension();
+                entry.formatType = mipFace->getFormat().getType();
+                entry.size = (uint32)mipFace->getSize();
+                entry.offset = offset;
+                offset = alignBlob(offset + entry.size);
+            }
+        }
+    }
+
+    blob.assign(offset, 0);
+    memcpy(blob.data(), &header, sizeof(BlobHeader));
+    memcpy(blob.data() + sizeof(BlobHeader), table.data(), table.size() * sizeof(BlobMipFace));
+
+    for (uint16 level = 0; level < header.numMips; level++) {
+        for (uint8 face = 0; face < header.numFaces; face++) {
+            const auto& entry = table[level * header.numFaces + face];
+            if (entry.size) {
+                auto mipFace = texture.accessStoredMipFace(level, face);
+                memcpy(blob.data() + entry.offset, mipFace->readData(), entry.size);
+            }
+        }
+    }
+
+    return true;
+}
+
+Texture* Texture::unserialize(const Byte* data, Size size) {
+    if (!data || size < sizeof(BlobHeader)) {
+        return nullptr;
+    }
+
+    BlobHeader header;
+    memcpy(&header, data, sizeof(BlobHeader));
+
+    if (header.magic != BLOB_MAGIC || header.version != BLOB_VERSION || header.headerSize != sizeof(BlobHeader)) {
+        return nullptr;
+    }
+    if (header.type >= NUM_TYPES || header.numFaces != NUM_FACES_PER_TYPE[header.type] ||
+        header.numMips == 0 || header.maxMip >= header.numMips) {
+        return nullptr;
+    }
+
+    Size tableSize = header.numMips * header.numFaces * sizeof(BlobMipFace);
+    if (size < sizeof(BlobHeader) + tableSize) {
+        return nullptr;
+    }
+    const BlobMipFace* table = reinterpret_cast<const BlobMipFace*>(data + sizeof(BlobHeader));
+
+    Element texelFormat((gpu::Dimension)header.formatDimension, (gpu::Type)header.formatType,
+                        (gpu::Semantic)header.formatSemantic);
+
+    std::unique_ptr<Texture> texture(create((Type)header.type, texelFormat, header.width, header.height, header.depth,
+                                            header.numSamples, header.numSlices, Sampler(header.sampler)));
+    if (header.numMips > texture->evalNumMips()) {
+        return nullptr;
+    }
+
+    texture->setUsage(Usage(Usage::Flags(header.usage)));
+
+    // assign through the storage, so that the sub mips are accepted regardless of the auto mips mode
+    for (uint16 level = 0; level < header.numMips; level++) {
+        for (uint8 face = 0; face < header.numFaces; face++) {
+            BlobMipFace entry;
+            memcpy(&entry, &table[level * header.numFaces + face], sizeof(BlobMipFace));
+            if (entry.size == 0) {
+                continue;
+            }
+            if (entry.offset > size || entry.size > size - entry.offset) {
+                return nullptr;
+            }
+
+            Element mipFormat((gpu::Dimension)entry.formatDimension, (gpu::Type)entry.formatType,
+                              (gpu::Semantic)entry.formatSemantic);
+            texture->_storage->assignMipFaceData(level, mipFormat, entry.size, data + entry.offset, face);
+        }
+    }
+
+    texture->_maxMip = header.maxMip;
+    texture->_autoGenerateMips = (header.autoGenerateMips != 0);
+    texture->_stamp++;
+
+    if (header.hasIrradiance) {
+        texture->_irradiance = std::make_shared<SphericalHarmonics>(header.irradiance);
+        texture->_isIrradianceValid = (header.isIrradianceValid != 0);
+    }
+
+    return texture.release();
+}
@@ -0,0 +1,134 @@
+//
+//  DiskCache.cpp
+//  libraries/model-networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DiskCache.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+#ifdef Q_OS_WIN
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include "ModelNetworkingLogging.h"
+
+// once full, evict down to this fraction of the maximum size
+static const float EVICTION_RATIO = 0.9f;
+
+// sets the modification time to now, which is what eviction orders the entries by
+// (QFile::setFileTime needs Qt 5.10)
+static void touch(const QString& path) {
+#ifdef Q_OS_WIN
+    _wutime(reinterpret_cast<const wchar_t*>(path.utf16()), nullptr);
+#else
+    utime(QFile::encodeName(path).constData(), nullptr);
+#endif
+}
+
+DiskCache::DiskCache(const QString& directory, const QString& extension, qint64 maximumSize) :
+    _directory(directory),
+    _extension(extension),
+    _maximumSize(maximumSize)
+{
+    QDir().mkpath(_directory);
+}
+
+QString DiskCache::pathFor(const QString& key) const {
+    return _directory + "/" + key + _extension;
+}
+
+bool DiskCache::load(const QString& key, const Reader& reader) {
+    QFile file(pathFor(key));
+    if (!file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    qint64 size = file.size();
+    uchar* data = (size > 0) ? file.map(0, size) : nullptr;
+    if (!data) {
+        return false;
+    }
+
+    bool isValid = reader(data, size);
+    file.unmap(data);
+    file.close();
+
+    if (!isValid) {
+        // stale or corrupt entry, it will be replaced by the next store
+        qCDebug(modelnetworking) << "Discarding invalid cache entry" << file.fileName();
+        file.remove();
+        return false;
+    }
+
+    // keep recently used entries from being evicted
+    touch(file.fileName());
+    return true;
+}
+
+bool DiskCache::store(const QString& key, const Writer& writer) {
+    // written aside and renamed on commit, so concurrent readers never map a partial entry
+    QSaveFile file(pathFor(key));
+    if (!file.open(QFile::WriteOnly)) {
+        qCWarning(modelnetworking) << "Could not open cache entry" << file.fileName();
+        return false;
+    }
+    if (!writer(file)) {
+        file.cancelWriting();
+        return false;
+    }
+
+    // committed under the lock, so that the size of an entry it replaces is the one accounted for
+    std::lock_guard<std::mutex> lock(_mutex);
+    QFileInfo replaced(file.fileName());
+    qint64 replacedSize = replaced.exists() ? replaced.size() : 0;
+    if (!file.commit()) {
+        qCWarning(modelnetworking) << "Could not write cache entry" << file.fileName();
+        return false;
+    }
+
+    if (_size < 0) {
+        // first store, account for the existing entries (including this one)
+        _size = entriesSize();
+    } else {
+        _size += QFileInfo(file.fileName()).size() - replacedSize;
+    }
+
+    if (_size > _maximumSize) {
+        evict();
+    }
+    return true;
+}
+
+qint64 DiskCache::entriesSize() const {
+    qint64 size = 0;
+    for (auto& info : QDir(_directory).entryInfoList({ "*" + _extension }, QDir::Files)) {
+        size += info.size();
+    }
+    return size;
+}
+
+void DiskCache::evict() {
+    // least recently stored or loaded entries first
+    auto entries = QDir(_directory).entryInfoList({ "*" + _extension }, QDir::Files, QDir::Time | QDir::Reversed);
+
+    qint64 targetSize = (qint64)(EVICTION_RATIO * _maximumSize);
+    for (auto& info : entries) {
+        if (_size <= targetSize) {
+            break;
+        }
+        if (QFile::remove(info.absoluteFilePath())) {
+            _size -= info.size();
+        }
+    }
+}
@@ -0,0 +1,52 @@
+//
+//  DiskCache.h
+//  libraries/model-networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DiskCache_h
+#define hifi_DiskCache_h
+
+#include <functional>
+#include <mutex>
+
+#include <QtCore/QIODevice>
+#include <QtCore/QString>
+
+/// A directory of cache entries, one file per key, evicted least recently used first once they pass a maximum size.
+/// Entries are written aside and renamed into place, and memory mapped to be read, so readers never see a partial one.
+/// Safe to use from any thread; the baked caches (textures, models) each keep one.
+class DiskCache {
+public:
+    using Reader = std::function<bool(const uchar* data, qint64 size)>;
+    using Writer = std::function<bool(QIODevice& file)>;
+
+    DiskCache(const QString& directory, const QString& extension, qint64 maximumSize);
+
+    /// Maps the entry for the key and reads it. Returns false if there is none, or if the reader rejects it,
+    /// in which case the entry is removed.
+    bool load(const QString& key, const Reader& reader);
+
+    /// Writes the entry for the key, replacing any previous one
+    bool store(const QString& key, const Writer& writer);
+
+    const QString& getDirectory() const { return _directory; }
+
+private:
+    QString pathFor(const QString& key) const;
+    qint64 entriesSize() const;
+    void evict();
+
+    QString _directory;
+    QString _extension;
+    qint64 _maximumSize;
+
+    std::mutex _mutex;
+    qint64 _size { -1 };    // unknown until the first store
+};
+
+#endif // hifi_DiskCache_h
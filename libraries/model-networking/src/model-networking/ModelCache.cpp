@@ -19,6 +19,7 @@
 #include <gpu/Stream.h>
 
 #include <QThreadPool>
+#include <QtCore/QStandardPaths>
 
 #include "ModelNetworkingLogging.h"
 #include <Trace.h>
@@ -26,6 +27,14 @@
 
 Q_LOGGING_CATEGORY(trace_resource_parse_geometry, "trace.resource.parse.geometry")
 
+static const qint64 MAXIMUM_MODEL_DISK_CACHE_SIZE = BYTES_PER_GIGABYTES;
+
+static QString modelDiskCacheDirectory() {
+    QString cachePath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    cachePath = !cachePath.isEmpty() ? cachePath : "interfaceCache";
+    return cachePath + "/models";
+}
+
 class GeometryReader;
 
 class GeometryExtra {
@@ -95,6 +104,7 @@ void GeometryMappingResource::downloadFinished(const QByteArray& data) {
         _geometryResource = modelCache->getResource(url, QUrl(), &extra).staticCast<GeometryResource>();
         // Avoid caching nested resources - their references will be held by the parent
         _geometryResource->_isCacheable = false;
+        _geometryResource->setLoadPriorities(_loadPriorities);
 
         if (_geometryResource->isLoaded()) {
             onGeometryMappingLoaded(!_geometryResource->getURL().isEmpty());
@@ -173,9 +183,19 @@ void GeometryReader::run() {
             FBXGeometry::Pointer fbxGeometry;
 
             if (_url.path().toLower().endsWith(".fbx")) {
-                fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
-                if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
-                    throw QString("empty geometry, possibly due to an unsupported FBX version");
+                auto& diskCache = DependencyManager::get<ModelCache>()->getDiskCache();
+                QString cacheKey = ModelDiskCache::keyFor(_data, _mapping, _url.path());
+                {
+                    PROFILE_RANGE_EX(resource_parse_geometry, "loadFromDiskCache", 0xff00ff00, 0);
+                    fbxGeometry.reset(diskCache.load(cacheKey, _url.path()));
+                }
+                if (!fbxGeometry) {
+                    fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
+                    if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
+                        throw QString("empty geometry, possibly due to an unsupported FBX version");
+                    }
+                    PROFILE_RANGE_EX(resource_parse_geometry, "storeToDiskCache", 0xff00ff00, 0);
+                    diskCache.store(cacheKey, *fbxGeometry);
                 }
             } else if (_url.path().toLower().endsWith(".obj")) {
                 fbxGeometry.reset(OBJReader().readOBJ(_data, _mapping, _url));
@@ -255,10 +275,15 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
     _meshes = meshes;
     _meshParts = parts;
 
+    // before finishing, which clears them
+    setTextureLoadPriorities(_loadPriorities);
+
     finishedLoading(true);
 }
 
-ModelCache::ModelCache() {
+ModelCache::ModelCache() :
+    _diskCache(modelDiskCacheDirectory(), MAXIMUM_MODEL_DISK_CACHE_SIZE)
+{
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
@@ -317,6 +342,16 @@ Geometry::Geometry(const Geometry& geometry) {
     _animGraphOverrideUrl = geometry._animGraphOverrideUrl;
 }
 
+void Geometry::setTextureLoadPriorities(const QHash<QPointer<QObject>, float>& priorities) {
+    for (auto& material : _materials) {
+        for (auto& texture : material->_textures) {
+            if (texture.texture) {
+                texture.texture->setLoadPriorities(priorities);
+            }
+        }
+    }
+}
+
 void Geometry::setTextures(const QVariantMap& textureMap) {
     if (_meshes->size() > 0) {
         for (auto& material : _materials) {
@@ -19,6 +19,7 @@
 #include <model/Asset.h>
 
 #include "FBXReader.h"
+#include "ModelDiskCache.h"
 #include "TextureCache.h"
 
 // Alias instead of derive to avoid copying
@@ -57,6 +58,9 @@ public:
 protected:
     friend class GeometryMappingResource;
 
+    // Textures load with the priority of the models using this geometry
+    void setTextureLoadPriorities(const QHash<QPointer<QObject>, float>& priorities);
+
     // Shared across all geometries, constant throughout lifetime
     std::shared_ptr<const FBXGeometry> _fbxGeometry;
     std::shared_ptr<const GeometryMeshes> _meshes;
@@ -136,6 +140,8 @@ public:
     GeometryResource::Pointer getGeometryResource(const QUrl& url,
         const QVariantHash& mapping = QVariantHash(), const QUrl& textureBaseUrl = QUrl());
 
+    ModelDiskCache& getDiskCache() { return _diskCache; }
+
 protected:
     friend class GeometryMappingResource;
 
@@ -145,6 +151,8 @@ protected:
 private:
     ModelCache();
     virtual ~ModelCache() = default;
+
+    ModelDiskCache _diskCache;
 };
 
 class NetworkMaterial : public model::Material {
@@ -0,0 +1,53 @@
+//
+//  ModelDiskCache.cpp
+//  libraries/model-networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelDiskCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <FBXReader.h>
+
+static const QString CACHE_EXTENSION = ".geom";
+
+ModelDiskCache::ModelDiskCache(const QString& directory, qint64 maximumSize) :
+    _entries(directory, CACHE_EXTENSION, maximumSize)
+{
+}
+
+QString ModelDiskCache::keyFor(const QByteArray& content, const QVariantHash& mapping, const QString& url) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(content);
+    // the mapping picks joints and scales the geometry, and the url path resolves its texture filenames
+    hash.addData(QJsonDocument(QJsonObject::fromVariantHash(mapping)).toJson(QJsonDocument::Compact));
+    hash.addData(url.toUtf8());
+    return hash.result().toHex();
+}
+
+FBXGeometry* ModelDiskCache::load(const QString& key, const QString& url) {
+    FBXGeometry* geometry = nullptr;
+    _entries.load(key, [&](const uchar* data, qint64 size) {
+        geometry = FBXGeometry::unserialize(reinterpret_cast<const char*>(data), size, url);
+        return geometry != nullptr;
+    });
+    return geometry;
+}
+
+void ModelDiskCache::store(const QString& key, const FBXGeometry& geometry) {
+    QByteArray blob;
+    if (!FBXGeometry::serialize(geometry, blob)) {
+        return;
+    }
+
+    _entries.store(key, [&](QIODevice& file) {
+        return file.write(blob) == blob.size();
+    });
+}
@@ -0,0 +1,44 @@
+//
+//  ModelDiskCache.h
+//  libraries/model-networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelDiskCache_h
+#define hifi_ModelDiskCache_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QVariantHash>
+
+#include "DiskCache.h"
+
+class FBXGeometry;
+
+/// Persistent cache of baked FBX geometry (joints, meshes and materials as readFBX leaves them),
+/// keyed by a hash of the source content and of everything else that changes what readFBX makes of it.
+/// Entries are memory mapped on load, so a hit skips the parsing and the geometry processing.
+/// Safe to use from the geometry reader threads.
+class ModelDiskCache {
+public:
+    ModelDiskCache(const QString& directory, qint64 maximumSize);
+
+    /// Returns the cache key of a model; the same content read with a different mapping is a different entry
+    static QString keyFor(const QByteArray& content, const QVariantHash& mapping, const QString& url);
+
+    /// Returns the cached geometry, or nullptr if there is no valid entry for the key
+    FBXGeometry* load(const QString& key, const QString& url);
+
+    void store(const QString& key, const FBXGeometry& geometry);
+
+    const QString& getDirectory() const { return _entries.getDirectory(); }
+
+private:
+    DiskCache _entries;
+};
+
+#endif // hifi_ModelDiskCache_h
@@ -20,6 +20,7 @@
 #include <QImageReader>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QStandardPaths>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/random.hpp>
@@ -38,7 +39,17 @@
 
 Q_LOGGING_CATEGORY(trace_resource_parse_image, "trace.resource.parse.image")
 
-TextureCache::TextureCache() {
+static const qint64 MAXIMUM_TEXTURE_DISK_CACHE_SIZE = 4 * BYTES_PER_GIGABYTES;
+
+static QString textureDiskCacheDirectory() {
+    QString cachePath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    cachePath = !cachePath.isEmpty() ? cachePath : "interfaceCache";
+    return cachePath + "/textures";
+}
+
+TextureCache::TextureCache() :
+    _diskCache(textureDiskCacheDirectory(), MAXIMUM_TEXTURE_DISK_CACHE_SIZE)
+{
     setUnusedResourceCacheSize(0);
     setObjectName("TextureCache");
 
@@ -297,6 +308,8 @@ public:
 private:
     static void listSupportedImageFormats();
 
+    void finish(const gpu::TexturePointer& texture, int originalWidth, int originalHeight);
+
     QWeakPointer<Resource> _resource;
     QUrl _url;
     QByteArray _content;
@@ -361,10 +374,34 @@ void ImageReader::run() {
         QThread::currentThread()->setPriority(originalPriority);
     });
 
-    if (!_resource.data()) {
-        qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
-        return;
+    // Processed textures are cached on disk by content, skip the decoding and processing on a hit
+    auto textureCache = DependencyManager::get<TextureCache>();
+    QString cacheKey;
+    {
+        auto resource = _resource.toStrongRef();
+        if (!resource) {
+            qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
+            return;
+        }
+
+        auto type = resource.staticCast<NetworkTexture>()->getTextureType();
+        if (textureCache && type != NetworkTexture::CUSTOM_TEXTURE) {
+            cacheKey = TextureDiskCache::keyFor(_content, type);
+        }
+    }
+
+    if (!cacheKey.isEmpty()) {
+        PROFILE_RANGE_EX(resource_parse_image, "loadFromDiskCache", 0xff00ff00, 0);
+        int originalWidth = 0;
+        int originalHeight = 0;
+        auto texture = textureCache->getDiskCache().load(cacheKey, originalWidth, originalHeight);
+        if (texture) {
+            texture->setSource(_url.toString().toStdString());
+            finish(texture, originalWidth, originalHeight);
+            return;
+        }
     }
+
     listSupportedImageFormats();
 
     // Help the QImage loader by extracting the image file format from the url filename ext.
@@ -401,6 +438,16 @@ void ImageReader::run() {
         texture.reset(resource.dynamicCast<NetworkTexture>()->getTextureLoader()(image, url));
     }
 
+    // Store before handing the texture over, as the upload releases its sysmem mips
+    if (texture && !cacheKey.isEmpty()) {
+        PROFILE_RANGE_EX(resource_parse_image, "storeToDiskCache", 0xff00ff00, 0);
+        textureCache->getDiskCache().store(cacheKey, texture, originalWidth, originalHeight);
+    }
+
+    finish(texture, originalWidth, originalHeight);
+}
+
+void ImageReader::finish(const gpu::TexturePointer& texture, int originalWidth, int originalHeight) {
     // Ensure the resource has not been deleted
     auto resource = _resource.toStrongRef();
     if (!resource) {
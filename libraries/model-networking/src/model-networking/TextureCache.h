@@ -23,6 +23,8 @@
 #include <ResourceCache.h>
 #include <model/TextureMap.h>
 
+#include "TextureDiskCache.h"
+
 namespace gpu {
 class Batch;
 }
@@ -131,6 +133,9 @@ public:
     NetworkTexturePointer getTexture(const QUrl& url, Type type = Type::DEFAULT_TEXTURE,
         const QByteArray& content = QByteArray());
 
+    /// Returns the on-disk cache of processed textures.
+    TextureDiskCache& getDiskCache() { return _diskCache; }
+
 protected:
     // Overload ResourceCache::prefetch to allow specifying texture type for loads
     Q_INVOKABLE ScriptableResource* prefetch(const QUrl& url, int type);
@@ -149,6 +154,8 @@ private:
     gpu::TexturePointer _blueTexture;
     gpu::TexturePointer _blackTexture;
     gpu::TexturePointer _normalFittingTexture;
+
+    TextureDiskCache _diskCache;
 };
 
 #endif // hifi_TextureCache_h
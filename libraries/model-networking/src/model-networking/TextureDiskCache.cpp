@@ -0,0 +1,71 @@
+//
+//  TextureDiskCache.cpp
+//  libraries/model-networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureDiskCache.h"
+
+#include <string.h>
+
+#include <QtCore/QCryptographicHash>
+
+static const QString CACHE_EXTENSION = ".tex";
+static const uint32_t CACHE_MAGIC = 0x43544648;    // "HFTC"
+
+// keeps the gpu blob that follows it aligned
+struct CacheEntryHeader {
+    uint32_t magic;
+    int32_t originalWidth;
+    int32_t originalHeight;
+    uint32_t spare;
+};
+
+TextureDiskCache::TextureDiskCache(const QString& directory, qint64 maximumSize) :
+    _entries(directory, CACHE_EXTENSION, maximumSize)
+{
+}
+
+QString TextureDiskCache::keyFor(const QByteArray& content, int type) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(content);
+    return QString(hash.result().toHex()) + "-" + QString::number(type);
+}
+
+gpu::TexturePointer TextureDiskCache::load(const QString& key, int& originalWidth, int& originalHeight) {
+    gpu::TexturePointer texture;
+    CacheEntryHeader header;
+    _entries.load(key, [&](const uchar* data, qint64 size) {
+        if (size <= (qint64)sizeof(CacheEntryHeader)) {
+            return false;
+        }
+        memcpy(&header, data, sizeof(CacheEntryHeader));
+        if (header.magic == CACHE_MAGIC) {
+            texture.reset(gpu::Texture::unserialize(data + sizeof(CacheEntryHeader), size - sizeof(CacheEntryHeader)));
+        }
+        return texture != nullptr;
+    });
+
+    if (texture) {
+        originalWidth = header.originalWidth;
+        originalHeight = header.originalHeight;
+    }
+    return texture;
+}
+
+void TextureDiskCache::store(const QString& key, const gpu::TexturePointer& texture, int originalWidth, int originalHeight) {
+    std::vector<gpu::Byte> blob;
+    if (!texture || !gpu::Texture::serialize(*texture, blob)) {
+        return;
+    }
+
+    CacheEntryHeader header = { CACHE_MAGIC, originalWidth, originalHeight, 0 };
+    _entries.store(key, [&](QIODevice& file) {
+        return file.write(reinterpret_cast<const char*>(&header), sizeof(CacheEntryHeader)) == sizeof(CacheEntryHeader) &&
+            file.write(reinterpret_cast<const char*>(blob.data()), blob.size()) == (qint64)blob.size();
+    });
+}
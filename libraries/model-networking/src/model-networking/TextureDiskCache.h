@@ -0,0 +1,43 @@
+//
+//  TextureDiskCache.h
+//  libraries/model-networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureDiskCache_h
+#define hifi_TextureDiskCache_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <gpu/Texture.h>
+
+#include "DiskCache.h"
+
+/// Persistent cache of fully processed textures (all stored mips and irradiance), keyed by a hash of the source content.
+/// Entries are memory mapped on load, so a hit skips both the image decoding and the texture processing.
+/// Safe to use from the image reader threads.
+class TextureDiskCache {
+public:
+    TextureDiskCache(const QString& directory, qint64 maximumSize);
+
+    /// Returns the cache key of a texture; the same content processed as a different type is a different entry
+    static QString keyFor(const QByteArray& content, int type);
+
+    /// Returns the cached texture, or nullptr if there is no valid entry for the key
+    gpu::TexturePointer load(const QString& key, int& originalWidth, int& originalHeight);
+
+    /// Stores the texture, which must still have its sysmem mips (before it is uploaded)
+    void store(const QString& key, const gpu::TexturePointer& texture, int originalWidth, int originalHeight);
+
+    const QString& getDirectory() const { return _entries.getDirectory(); }
+
+private:
+    DiskCache _entries;
+};
+
+#endif // hifi_TextureDiskCache_h
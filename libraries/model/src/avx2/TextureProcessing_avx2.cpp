@@ -0,0 +1,129 @@
+//
+//  TextureProcessing_avx2.cpp
+//  libraries/model/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <stdint.h>
+#include <immintrin.h>  // AVX2
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+void downsampleRow_ref(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                       int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB);
+
+//
+// Sum the 2x2 footprints of two destination texels, from 4 source texels (padded to 4 bytes) of one row.
+// Color channels are converted to linear when toLinear is set, alpha is kept as is.
+//
+static inline __m256i sumPairs(__m128i texels, const uint16_t* toLinear) {
+
+    __m256i a = _mm256_cvtepu8_epi32(texels);                       // t0 | t1
+    __m256i b = _mm256_cvtepu8_epi32(_mm_srli_si128(texels, 8));    // t2 | t3
+
+    if (toLinear) {
+        __m256i mask = _mm256_set1_epi32(0xffff);
+        __m256i la = _mm256_and_si256(_mm256_i32gather_epi32((const int*)toLinear, a, 2), mask);
+        __m256i lb = _mm256_and_si256(_mm256_i32gather_epi32((const int*)toLinear, b, 2), mask);
+        a = _mm256_blend_epi32(la, a, 0x88);
+        b = _mm256_blend_epi32(lb, b, 0x88);
+    }
+
+    // (t0 + t1) | (t2 + t3)
+    return _mm256_add_epi32(_mm256_permute2x128_si256(a, b, 0x20), _mm256_permute2x128_si256(a, b, 0x31));
+}
+
+//
+// Single channel, linear: 16 destination texels per iteration
+//
+static int downsampleRow1_AVX2(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth) {
+
+    __m256i ones = _mm256_set1_epi8(1);
+    __m256i round = _mm256_set1_epi16(2);
+
+    int x = 0;
+    for (; (2 * x + 32 <= srcWidth) && (x + 16 <= dstWidth); x += 16) {
+        __m256i s0 = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*)&row0[2 * x]), ones);
+        __m256i s1 = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*)&row1[2 * x]), ones);
+
+        __m256i sum = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(s0, s1), round), 2);
+
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+        _mm_storeu_si128((__m128i*)&dst[x], _mm256_castsi256_si128(packed));
+    }
+    return x;
+}
+
+//
+// Three or four channels: 2 destination texels per iteration
+//
+static int downsampleRow34_AVX2(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                                int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB) {
+
+    const int C = numComponents;
+
+    // RGB texels are padded to 4 bytes, and compacted again on output
+    __m128i expand = (C == 3) ? _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)
+                              : _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i compact = (C == 3) ? _mm_setr_epi8(0, 1, 2, 4, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)
+                               : _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    __m256i round = _mm256_set1_epi32(2);
+    __m256i mask = _mm256_set1_epi32(0xff);
+    __m256i select = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+
+    int x = 0;
+    for (; (2 * x * C + 16 <= srcWidth * C) && (2 * x + 4 <= srcWidth) && (x * C + 8 <= dstWidth * C); x += 2) {
+
+        __m128i t0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&row0[2 * x * C]), expand);
+        __m128i t1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&row1[2 * x * C]), expand);
+
+        __m256i sum = _mm256_add_epi32(sumPairs(t0, toLinear), sumPairs(t1, toLinear));
+        sum = _mm256_srli_epi32(_mm256_add_epi32(sum, round), 2);
+
+        if (toLinear) {
+            __m256i srgb = _mm256_and_si256(_mm256_i32gather_epi32((const int*)toSRGB, sum, 1), mask);
+            sum = _mm256_blend_epi32(srgb, sum, 0x88);
+        }
+
+        // 8 x int32 -> 8 bytes, one texel from each lane
+        __m256i packed = _mm256_packus_epi32(sum, sum);
+        packed = _mm256_packus_epi16(packed, packed);
+        packed = _mm256_permutevar8x32_epi32(packed, select);
+
+        _mm_storel_epi64((__m128i*)&dst[x * C], _mm_shuffle_epi8(_mm256_castsi256_si128(packed), compact));
+    }
+    return x;
+}
+
+//
+// Same results as the reference, which finishes the row
+//
+void downsampleRow_AVX2(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                        int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB) {
+
+    int x = 0;
+    if (numComponents == 1 && !toLinear) {
+        x = downsampleRow1_AVX2(row0, row1, srcWidth, dst, dstWidth);
+    } else if (numComponents == 3 || numComponents == 4) {
+        x = downsampleRow34_AVX2(row0, row1, srcWidth, dst, dstWidth, numComponents, toLinear, toSRGB);
+    }
+
+    if (x < dstWidth) {
+        int offset = 2 * x * numComponents;
+        downsampleRow_ref(row0 + offset, row1 + offset, srcWidth - 2 * x, dst + x * numComponents, dstWidth - x,
+                          numComponents, toLinear, toSRGB);
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include <Profile.h>
 
 #include "ModelLogging.h"
+#include "TextureProcessing.h"
 
 using namespace model;
 using namespace gpu;
@@ -197,29 +198,20 @@ const QImage& image, bool isLinear, bool doCompress) {
     }
 }
 
-#define CPU_MIPMAPS 0
+// Mips are generated on the CPU, so that they are part of the cached texture
+#define CPU_MIPMAPS 1
 
-void generateMips(gpu::Texture* texture, QImage& image, gpu::Element formatMip) {
+void generateMips(gpu::Texture* texture, const QImage& image, gpu::Element formatMip) {
 #if CPU_MIPMAPS
-    auto numMips = texture->evalNumMips();
-    for (uint16 level = 1; level < numMips; ++level) {
-        QSize mipSize(texture->evalMipWidth(level), texture->evalMipHeight(level));
-        image = image.scaled(mipSize);
-        texture->assignStoredMip(level, formatMip, image.byteCount(), image.constBits());
-    }
+    TextureProcessing::generateMips(texture, image.constBits(), image.bytesPerLine(), formatMip);
 #else
     texture->autoGenerateMips(-1);
 #endif
 }
 
-void generateFaceMips(gpu::Texture* texture, QImage& image, gpu::Element formatMip, uint8 face) {
+void generateFaceMips(gpu::Texture* texture, const QImage& image, gpu::Element formatMip, uint8 face) {
 #if CPU_MIPMAPS
-    auto numMips = texture->evalNumMips();
-    for (uint16 level = 1; level < numMips; ++level) {
-        QSize mipSize(texture->evalMipWidth(level), texture->evalMipHeight(level));
-        image = image.scaled(mipSize);
-        texture->assignStoredMipFace(level, formatMip, image.byteCount(), image.constBits(), face);
-    }
+    TextureProcessing::generateFaceMips(texture, image.constBits(), image.bytesPerLine(), formatMip, face);
 #else
     texture->autoGenerateMips(-1);
 #endif
@@ -804,11 +796,6 @@ gpu::Texture* TextureUsage::processCubeTextureColorFromImage(const QImage& srcIm
                 f++;
             }
 
-            if (generateMips) {
-                PROFILE_RANGE(resource_parse, "generateMips");
-                theTexture->autoGenerateMips(-1);
-            }
-
             // Generate irradiance while we are at it
             if (generateIrradiance) {
                 PROFILE_RANGE(resource_parse, "generateIrradiance");
@@ -0,0 +1,180 @@
+//
+//  TextureProcessing.cpp
+//  libraries/model/src/model
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "TextureProcessing.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <ColorUtils.h>
+#include <CPUDetect.h>
+#include <Profile.h>
+#include <shared/ParallelFor.h>
+
+using namespace model;
+using namespace gpu;
+
+//
+// Gamma correct averaging uses 16 bit linear values.
+// The inverse table is built from the forward one, so that a uniform area keeps its exact sRGB value.
+//
+static uint16_t sRGBToLinearTable[256 + 2];     // padded, for 32 bit gathers
+static uint8_t linearToSRGBTable[65536 + 4];
+
+static void initSRGBTables() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        for (int i = 0; i < 256; i++) {
+            sRGBToLinearTable[i] = (uint16_t)(ColorUtils::sRGB8ToLinearFloat((uint8_t)i) * 65535.0f + 0.5f);
+        }
+
+        // each linear value maps to the sRGB value with the nearest linear value
+        int code = 0;
+        for (int v = 0; v < 65536; v++) {
+            while (code < 255 && 2 * v > sRGBToLinearTable[code] + sRGBToLinearTable[code + 1]) {
+                code++;
+            }
+            linearToSRGBTable[v] = (uint8_t)code;
+        }
+    });
+}
+
+//
+// Downsample one row of the destination from two rows of the source.
+// toLinear is nullptr for linear images, otherwise both tables must be padded for 32 bit reads.
+//
+void downsampleRow_ref(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                       int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB) {
+
+    for (int x = 0; x < dstWidth; x++) {
+
+        const uint8_t* p0 = &row0[2 * x * numComponents];
+        const uint8_t* p1 = &row0[std::min(2 * x + 1, srcWidth - 1) * numComponents];
+        const uint8_t* p2 = &row1[2 * x * numComponents];
+        const uint8_t* p3 = &row1[std::min(2 * x + 1, srcWidth - 1) * numComponents];
+
+        for (int c = 0; c < numComponents; c++) {
+            if (toLinear && c < 3) {
+                int sum = toLinear[p0[c]] + toLinear[p1[c]] + toLinear[p2[c]] + toLinear[p3[c]];
+                dst[c] = toSRGB[(sum + 2) >> 2];
+            } else {
+                int sum = p0[c] + p1[c] + p2[c] + p3[c];
+                dst[c] = (uint8_t)((sum + 2) >> 2);
+            }
+        }
+        dst += numComponents;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+void downsampleRow_AVX2(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                        int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB);
+
+static void downsampleRow(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                          int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB) {
+
+    static auto f = cpuSupportsAVX2() ? downsampleRow_AVX2 : downsampleRow_ref;
+    (*f)(row0, row1, srcWidth, dst, dstWidth, numComponents, toLinear, toSRGB);   // dispatch
+}
+
+#else
+
+static void downsampleRow(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                          int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB) {
+
+    downsampleRow_ref(row0, row1, srcWidth, dst, dstWidth, numComponents, toLinear, toSRGB);
+}
+
+#endif
+
+static void downsampleRows(const Byte* src, int srcWidth, int srcHeight, int srcPitch, int numComponents, bool isSRGB,
+                           Byte* dst, int dstPitch, int rowBegin, int rowEnd) {
+
+    const uint16_t* toLinear = isSRGB ? sRGBToLinearTable : nullptr;
+    int dstWidth = std::max(srcWidth >> 1, 1);
+
+    for (int y = rowBegin; y < rowEnd; y++) {
+        const Byte* row0 = src + (2 * y) * srcPitch;
+        const Byte* row1 = src + std::min(2 * y + 1, srcHeight - 1) * srcPitch;
+        downsampleRow(row0, row1, srcWidth, dst + y * dstPitch, dstWidth, numComponents,
+                      toLinear, linearToSRGBTable);
+    }
+}
+
+bool TextureProcessing::isSRGB(const Element& format) {
+    auto semantic = format.getSemantic();
+    return (semantic == SRGB || semantic == SRGBA || semantic == SBGRA);
+}
+
+void TextureProcessing::downsample(const Byte* src, int srcWidth, int srcHeight, int srcPitch, int numComponents, bool isSRGB,
+                                   Byte* dst) {
+    initSRGBTables();
+    int dstPitch = std::max(srcWidth >> 1, 1) * numComponents;
+    downsampleRows(src, srcWidth, srcHeight, srcPitch, numComponents, isSRGB, dst, dstPitch, 0, std::max(srcHeight >> 1, 1));
+}
+
+// below this, a level is not worth splitting
+static const int MIN_TEXELS_PER_TASK = 64 * 1024;
+
+// mip rows are padded to 4 bytes, as QImage rows are, since the backends upload with the default GL_UNPACK_ALIGNMENT
+static const int MIP_ROW_ALIGNMENT = 4;
+
+static void generateMipChain(Texture* texture, const Byte* image, int srcPitch, const Element& formatMip, int face) {
+    PROFILE_RANGE(resource_parse, "generateMips");
+    initSRGBTables();
+
+    int numComponents = formatMip.getScalarCount();
+    bool isSRGB = TextureProcessing::isSRGB(formatMip);
+
+    std::vector<Byte> previous;
+    std::vector<Byte> current;
+
+    const Byte* src = image;
+    int srcWidth = texture->getWidth();
+    int srcHeight = texture->getHeight();
+
+    auto numMips = texture->evalNumMips();
+    for (uint16 level = 1; level < numMips; ++level) {
+        int dstWidth = texture->evalMipWidth(level);
+        int dstHeight = texture->evalMipHeight(level);
+        int dstPitch = (dstWidth * numComponents + MIP_ROW_ALIGNMENT - 1) & ~(MIP_ROW_ALIGNMENT - 1);
+        current.resize(dstPitch * dstHeight);
+
+        int numTasks = std::max(std::min(dstHeight, dstWidth * dstHeight / MIN_TEXELS_PER_TASK), 1);
+        parallelFor(numTasks, [&](int task) {
+            int rowBegin = dstHeight * task / numTasks;
+            int rowEnd = dstHeight * (task + 1) / numTasks;
+            downsampleRows(src, srcWidth, srcHeight, srcPitch, numComponents, isSRGB, current.data(), dstPitch,
+                           rowBegin, rowEnd);
+        });
+
+        if (face < 0) {
+            texture->assignStoredMip(level, formatMip, current.size(), current.data());
+        } else {
+            texture->assignStoredMipFace(level, formatMip, current.size(), current.data(), face);
+        }
+
+        // the next level reads this one
+        previous.swap(current);
+        src = previous.data();
+        srcWidth = dstWidth;
+        srcHeight = dstHeight;
+        srcPitch = dstPitch;
+    }
+}
+
+void TextureProcessing::generateMips(Texture* texture, const Byte* image, int srcPitch, const Element& formatMip) {
+    generateMipChain(texture, image, srcPitch, formatMip, -1);
+}
+
+void TextureProcessing::generateFaceMips(Texture* texture, const Byte* image, int srcPitch, const Element& formatMip,
+                                         uint8 face) {
+    generateMipChain(texture, image, srcPitch, formatMip, face);
+}
@@ -0,0 +1,38 @@
+//
+//  TextureProcessing.h
+//  libraries/model/src/model
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_model_TextureProcessing_h
+#define hifi_model_TextureProcessing_h
+
+#include "gpu/Texture.h"
+
+namespace model {
+
+// CPU image processing used to prepare textures
+class TextureProcessing {
+public:
+    // Downsample an 8 bit image by 2 in each dimension with a 2x2 box filter.
+    // Color channels are averaged in linear space when isSRGB, alpha (the 4th channel) is always averaged as is.
+    // An odd last row or column of the source is dropped, a source dimension of 1 is kept.
+    // numComponents is 1, 3 or 4; srcPitch is in bytes and the destination is tightly packed.
+    static void downsample(const gpu::Byte* src, int srcWidth, int srcHeight, int srcPitch, int numComponents, bool isSRGB,
+        gpu::Byte* dst);
+
+    // Generate and assign the mips below level 0, each level downsampled from the previous one
+    // The rows of each level are processed in parallel, and padded to a multiple of 4 bytes
+    static void generateMips(gpu::Texture* texture, const gpu::Byte* image, int srcPitch, const gpu::Element& formatMip);
+    static void generateFaceMips(gpu::Texture* texture, const gpu::Byte* image, int srcPitch, const gpu::Element& formatMip,
+        gpu::uint8 face);
+
+    static bool isSRGB(const gpu::Element& format);
+};
+
+};
+
+#endif // hifi_model_TextureProcessing_h
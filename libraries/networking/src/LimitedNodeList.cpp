@@ -49,8 +49,7 @@ const std::set<NodeType_t> SOLO_NODE_TYPES = {
 
 LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     _sessionUUID(),
-    _nodeHash(),
-    _nodeMutex(QReadWriteLock::Recursive),
+    _nodeSnapshot(std::make_shared<NodeSnapshot>()),
     _nodeSocket(this),
     _dtlsSocket(NULL),
     _localSockAddr(),
@@ -270,11 +269,8 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
         if (matchingNode) {
             if (!NON_VERIFIED_PACKETS.contains(headerType)) {
 
-                QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
-                QByteArray expectedHash = NLPacket::hashForPacketAndSecret(packet, matchingNode->getConnectionSecret());
-
-                // check if the md5 hash in the header matches the hash we would expect
-                if (packetHeaderHash != expectedHash) {
+                // check if the hash in the header matches the hash we would expect
+                if (!NLPacket::verificationHashMatches(packet, matchingNode->getVerificationKey())) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
@@ -314,15 +310,15 @@ void LimitedNodeList::collectPacketStats(const NLPacket& packet) {
     _numCollectedBytes += packet.getDataSize();
 }
 
-void LimitedNodeList::fillPacketHeader(const NLPacket& packet, const QUuid& connectionSecret) {
+void LimitedNodeList::fillPacketHeader(const NLPacket& packet, const PacketVerificationKey& verificationKey) {
     if (!NON_SOURCED_PACKETS.contains(packet.getType())) {
         packet.writeSourceID(getSessionUUID());
     }
 
-    if (!connectionSecret.isNull()
+    if (!verificationKey.isNull()
         && !NON_SOURCED_PACKETS.contains(packet.getType())
         && !NON_VERIFIED_PACKETS.contains(packet.getType())) {
-        packet.writeVerificationHashGivenSecret(connectionSecret);
+        packet.writeVerificationHash(verificationKey);
     }
 }
 
@@ -338,17 +334,22 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node&
     emit dataSent(destinationNode.getType(), packet.getDataSize());
     destinationNode.recordBytesSent(packet.getDataSize());
 
-    return sendUnreliablePacket(packet, *destinationNode.getActiveSocket(), destinationNode.getConnectionSecret());
+    return sendUnreliablePacket(packet, *destinationNode.getActiveSocket(), destinationNode.getVerificationKey());
 }
 
 qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr,
                                              const QUuid& connectionSecret) {
+    return sendUnreliablePacket(packet, sockAddr, PacketVerificationKey(connectionSecret));
+}
+
+qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr,
+                                             const PacketVerificationKey& verificationKey) {
     Q_ASSERT(!packet.isPartOfMessage());
     Q_ASSERT_X(!packet.isReliable(), "LimitedNodeList::sendUnreliablePacket",
                "Trying to send a reliable packet unreliably.");
 
     collectPacketStats(packet);
-    fillPacketHeader(packet, connectionSecret);
+    fillPacketHeader(packet, verificationKey);
 
     return _nodeSocket.writePacket(packet, sockAddr);
 }
@@ -361,7 +362,7 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
         emit dataSent(destinationNode.getType(), packet->getDataSize());
         destinationNode.recordBytesSent(packet->getDataSize());
 
-        return sendPacket(std::move(packet), *activeSocket, destinationNode.getConnectionSecret());
+        return sendPacket(std::move(packet), *activeSocket, destinationNode.getVerificationKey());
     } else {
         qCDebug(networking) << "LimitedNodeList::sendPacket called without active socket for node" << destinationNode << "- not sending";
         return ERROR_SENDING_PACKET_BYTES;
@@ -370,17 +371,22 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
 
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
                                    const QUuid& connectionSecret) {
+    return sendPacket(std::move(packet), sockAddr, PacketVerificationKey(connectionSecret));
+}
+
+qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
+                                   const PacketVerificationKey& verificationKey) {
     Q_ASSERT(!packet->isPartOfMessage());
     if (packet->isReliable()) {
         collectPacketStats(*packet);
-        fillPacketHeader(*packet, connectionSecret);
+        fillPacketHeader(*packet, verificationKey);
 
         auto size = packet->getDataSize();
         _nodeSocket.writePacket(std::move(packet), sockAddr);
 
         return size;
     } else {
-        return sendUnreliablePacket(*packet, sockAddr, connectionSecret);
+        return sendUnreliablePacket(*packet, sockAddr, verificationKey);
     }
 }
 
@@ -389,13 +395,13 @@ qint64 LimitedNodeList::sendPacketList(NLPacketList& packetList, const Node& des
 
     if (activeSocket) {
         qint64 bytesSent = 0;
-        auto connectionSecret = destinationNode.getConnectionSecret();
+        auto& verificationKey = destinationNode.getVerificationKey();
 
         // close the last packet in the list
         packetList.closeCurrentPacket();
 
         while (!packetList._packets.empty()) {
-            bytesSent += sendPacket(packetList.takeFront<NLPacket>(), *activeSocket, connectionSecret);
+            bytesSent += sendPacket(packetList.takeFront<NLPacket>(), *activeSocket, verificationKey);
         }
 
         emit dataSent(destinationNode.getType(), bytesSent);
@@ -410,12 +416,13 @@ qint64 LimitedNodeList::sendPacketList(NLPacketList& packetList, const Node& des
 qint64 LimitedNodeList::sendPacketList(NLPacketList& packetList, const HifiSockAddr& sockAddr,
                                        const QUuid& connectionSecret) {
     qint64 bytesSent = 0;
+    PacketVerificationKey verificationKey(connectionSecret);
 
     // close the last packet in the list
     packetList.closeCurrentPacket();
 
     while (!packetList._packets.empty()) {
-        bytesSent += sendPacket(packetList.takeFront<NLPacket>(), sockAddr, connectionSecret);
+        bytesSent += sendPacket(packetList.takeFront<NLPacket>(), sockAddr, verificationKey);
     }
 
     return bytesSent;
@@ -443,7 +450,7 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
         for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
             NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
             collectPacketStats(*nlPacket);
-            fillPacketHeader(*nlPacket, destinationNode.getConnectionSecret());
+            fillPacketHeader(*nlPacket, destinationNode.getVerificationKey());
         }
 
         return _nodeSocket.writePacketList(std::move(packetList), *activeSocket);
@@ -464,7 +471,7 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
     auto& destinationSockAddr = (overridenSockAddr.isNull()) ? *destinationNode.getActiveSocket()
                                                              : overridenSockAddr;
 
-    return sendPacket(std::move(packet), destinationSockAddr, destinationNode.getConnectionSecret());
+    return sendPacket(std::move(packet), destinationSockAddr, destinationNode.getVerificationKey());
 }
 
 int LimitedNodeList::updateNodeWithDataFromPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -491,33 +498,53 @@ NodeData* LimitedNodeList::getOrCreateLinkedData(SharedNodePointer node) {
 }
 
 SharedNodePointer LimitedNodeList::nodeWithUUID(const QUuid& nodeUUID) {
-    QReadLocker readLocker(&_nodeMutex);
+    auto snapshot = getNodeSnapshot();
 
-    NodeHash::const_iterator it = _nodeHash.find(nodeUUID);
-    return it == _nodeHash.cend() ? SharedNodePointer() : it->second;
+    NodeHash::const_iterator it = snapshot->nodeHash.find(nodeUUID);
+    return it == snapshot->nodeHash.cend() ? SharedNodePointer() : it->second;
  }
 
+void LimitedNodeList::publishNodes(NodeHash nodeHash) {
+    auto snapshot = std::make_shared<NodeSnapshot>();
+
+    snapshot->nodes.reserve(nodeHash.size());
+    for (const auto& pair : nodeHash) {
+        snapshot->nodes.push_back(pair.second);
+
+        if (auto activeSocket = pair.second->getActiveSocket()) {
+            snapshot->nodesByActiveSocket[*activeSocket] = pair.second;
+        }
+    }
+    snapshot->nodeHash = std::move(nodeHash);
+
+    // readers holding the previous snapshot keep it, and its nodes, alive until they let go of it
+    std::atomic_store(&_nodeSnapshot, NodeSnapshotPointer(std::move(snapshot)));
+}
+
+void LimitedNodeList::nodeSocketActivated() {
+    QMutexLocker writeLocker(&_nodeWriteMutex);
+
+    // the same nodes, indexed by their new active sockets
+    publishNodes(getNodeSnapshot()->nodeHash);
+}
+
 void LimitedNodeList::eraseAllNodes() {
-    QSet<SharedNodePointer> killedNodes;
+    std::vector<SharedNodePointer> killedNodes;
 
     {
-        // iterate the current nodes - grab them so we can emit that they are dying
-        // and then remove them from the hash
-        QWriteLocker writeLocker(&_nodeMutex);
+        // grab the current nodes so we can emit that they are dying, and then publish that there are none
+        QMutexLocker writeLocker(&_nodeWriteMutex);
 
-        if (_nodeHash.size() > 0) {
-            qCDebug(networking) << "LimitedNodeList::eraseAllNodes() removing all nodes from NodeList.";
+        killedNodes = getNodeSnapshot()->nodes;
 
-            auto it = _nodeHash.begin();
+        if (killedNodes.size() > 0) {
+            qCDebug(networking) << "LimitedNodeList::eraseAllNodes() removing all nodes from NodeList.";
 
-            while (it != _nodeHash.end())  {
-                killedNodes.insert(it->second);
-                it = _nodeHash.unsafe_erase(it);
-            }
+            publishNodes(NodeHash());
         }
     }
 
-    foreach(const SharedNodePointer& killedNode, killedNodes) {
+    for (const SharedNodePointer& killedNode : killedNodes) {
         handleNodeKill(killedNode);
     }
 }
@@ -530,24 +557,26 @@ void LimitedNodeList::reset() {
 }
 
 bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID) {
-    QReadLocker readLocker(&_nodeMutex);
-
-    NodeHash::iterator it = _nodeHash.find(nodeUUID);
-    if (it != _nodeHash.end()) {
-        SharedNodePointer matchingNode = it->second;
+    SharedNodePointer matchingNode;
 
-        readLocker.unlock();
+    {
+        QMutexLocker writeLocker(&_nodeWriteMutex);
 
-        {
-            QWriteLocker writeLocker(&_nodeMutex);
-            _nodeHash.unsafe_erase(it);
+        auto snapshot = getNodeSnapshot();
+        NodeHash::const_iterator it = snapshot->nodeHash.find(nodeUUID);
+        if (it == snapshot->nodeHash.cend()) {
+            return false;
         }
 
-        handleNodeKill(matchingNode);
-        return true;
+        matchingNode = it->second;
+
+        NodeHash nodeHash = snapshot->nodeHash;
+        nodeHash.erase(nodeUUID);
+        publishNodes(std::move(nodeHash));
     }
 
-    return false;
+    handleNodeKill(matchingNode);
+    return true;
 }
 
 void LimitedNodeList::processKillNode(ReceivedMessage& message) {
@@ -572,19 +601,27 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
                                                    const HifiSockAddr& publicSocket, const HifiSockAddr& localSocket,
                                                    const NodePermissions& permissions,
                                                    const QUuid& connectionSecret) {
-    QReadLocker readLocker(&_nodeMutex);
-    NodeHash::const_iterator it = _nodeHash.find(uuid);
-
-    if (it != _nodeHash.end()) {
-        SharedNodePointer& matchingNode = it->second;
-        
+    auto updateNode = [&](const SharedNodePointer& matchingNode) {
         matchingNode->setPublicSocket(publicSocket);
         matchingNode->setLocalSocket(localSocket);
         matchingNode->setPermissions(permissions);
         matchingNode->setConnectionSecret(connectionSecret);
+    };
 
+    if (auto matchingNode = nodeWithUUID(uuid)) {
+        updateNode(matchingNode);
         return matchingNode;
     } else {
+        QMutexLocker writeLocker(&_nodeWriteMutex);
+
+        // check again now that we are the only writer, it may have been added since
+        auto snapshot = getNodeSnapshot();
+        NodeHash::const_iterator it = snapshot->nodeHash.find(uuid);
+        if (it != snapshot->nodeHash.cend()) {
+            updateNode(it->second);
+            return it->second;
+        }
+
         // we didn't have this node, so add them
         Node* newNode = new Node(uuid, nodeType, publicSocket, localSocket, permissions, connectionSecret, this);
 
@@ -594,33 +631,34 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
 
         SharedNodePointer newNodePointer(newNode, &QObject::deleteLater);
 
+        // index the node by its active socket as soon as it has one, from whichever thread activated it
+        connect(newNode, &NetworkPeer::socketActivated, newNode, [this] {
+            nodeSocketActivated();
+        }, Qt::DirectConnection);
+
+        NodeHash nodeHash = snapshot->nodeHash;
+        SharedNodePointer oldSoloNode;
+
         // if this is a solo node type, we assume that the DS has replaced its assignment and we should kill the previous node
         if (SOLO_NODE_TYPES.count(newNode->getType())) {
-            // while we still have the read lock, see if there is a previous solo node we'll need to remove
-            auto previousSoloIt = std::find_if(_nodeHash.cbegin(), _nodeHash.cend(), [newNode](const UUIDNodePair& nodePair){
+            auto previousSoloIt = std::find_if(nodeHash.cbegin(), nodeHash.cend(), [newNode](const UUIDNodePair& nodePair){
                 return nodePair.second->getType() == newNode->getType();
             });
 
-            if (previousSoloIt != _nodeHash.cend()) {
-                // we have a previous solo node, switch to a write lock so we can remove it
-                readLocker.unlock();
-
-                QWriteLocker writeLocker(&_nodeMutex);
-
-                auto oldSoloNode = previousSoloIt->second;
-
-                _nodeHash.unsafe_erase(previousSoloIt);
-                handleNodeKill(oldSoloNode);
-
-                // convert the current lock back to a read lock for insertion of new node
-                writeLocker.unlock();
-                readLocker.relock();
+            if (previousSoloIt != nodeHash.cend()) {
+                oldSoloNode = previousSoloIt->second;
+                nodeHash.erase(previousSoloIt);
             }
         }
 
-        // insert the new node and release our read lock
-        _nodeHash.insert(UUIDNodePair(newNode->getUUID(), newNodePointer));
-        readLocker.unlock();
+        // publish the nodes with the new one and let go of the write lock
+        nodeHash.insert(UUIDNodePair(newNode->getUUID(), newNodePointer));
+        publishNodes(std::move(nodeHash));
+        writeLocker.unlock();
+
+        if (oldSoloNode) {
+            handleNodeKill(oldSoloNode);
+        }
 
         qCDebug(networking) << "Added" << *newNode;
 
@@ -730,26 +768,33 @@ void LimitedNodeList::resetPacketStats() {
 
 void LimitedNodeList::removeSilentNodes() {
 
-    QSet<SharedNodePointer> killedNodes;
+    std::vector<SharedNodePointer> killedNodes;
 
-    eachNodeHashIterator([&](NodeHash::iterator& it){
-        SharedNodePointer node = it->second;
-        node->getMutex().lock();
+    {
+        QMutexLocker writeLocker(&_nodeWriteMutex);
 
-        if ((usecTimestampNow() - node->getLastHeardMicrostamp()) > (NODE_SILENCE_THRESHOLD_MSECS * USECS_PER_MSEC)) {
-            // call the NodeHash erase to get rid of this node
-            it = _nodeHash.unsafe_erase(it);
+        auto snapshot = getNodeSnapshot();
+        auto now = usecTimestampNow();
 
-            killedNodes.insert(node);
-        } else {
-            // we didn't erase this node, push the iterator forwards
-            ++it;
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            QMutexLocker nodeLocker(&node->getMutex());
+
+            if ((now - node->getLastHeardMicrostamp()) > (NODE_SILENCE_THRESHOLD_MSECS * USECS_PER_MSEC)) {
+                killedNodes.push_back(node);
+            }
         }
 
-        node->getMutex().unlock();
-    });
+        if (!killedNodes.empty()) {
+            // only publish new nodes when some are gone, so readers keep the snapshot they have otherwise
+            NodeHash nodeHash = snapshot->nodeHash;
+            for (const SharedNodePointer& killedNode : killedNodes) {
+                nodeHash.erase(killedNode->getUUID());
+            }
+            publishNodes(std::move(nodeHash));
+        }
+    }
 
-    foreach(const SharedNodePointer& killedNode, killedNodes) {
+    for (const SharedNodePointer& killedNode : killedNodes) {
         handleNodeKill(killedNode);
     }
 }
@@ -1054,11 +1099,15 @@ void LimitedNodeList::sendPeerQueryToIceServer(const HifiSockAddr& iceServerSock
 }
 
 SharedNodePointer LimitedNodeList::findNodeWithAddr(const HifiSockAddr& addr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&](const UUIDNodePair& pair) {
-        return pair.second->getActiveSocket() ? (*pair.second->getActiveSocket() == addr) : false;
-    });
-    return (it != std::end(_nodeHash)) ? it->second : SharedNodePointer();
+    auto snapshot = getNodeSnapshot();
+    auto it = snapshot->nodesByActiveSocket.find(addr);
+    if (it == snapshot->nodesByActiveSocket.cend()) {
+        return SharedNodePointer();
+    }
+
+    // a socket change deactivates the node's socket without publishing, check that it is still the active one
+    auto activeSocket = it->second->getActiveSocket();
+    return (activeSocket && *activeSocket == addr) ? it->second : SharedNodePointer();
 }
 
 void LimitedNodeList::sendPacketToIceServer(PacketType packetType, const HifiSockAddr& iceServerSockAddr,
@@ -18,12 +18,14 @@
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <unistd.h> // not on windows, not needed for mac or windows
 #endif
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
 #include <QtCore/QPointer>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QSet>
@@ -65,9 +67,27 @@ const QHostAddress DEFAULT_ASSIGNMENT_CLIENT_MONITOR_HOSTNAME = QHostAddress::Lo
 
 const QString USERNAME_UUID_REPLACEMENT_STATS_KEY = "$username";
 
+// The entries of a DomainList, which is either the full list or only the changes since an epoch the node holds
+enum class DomainListEntry : quint8 {
+    Node = 0,       // followed by the node and its connection secret
+    RemovedNode     // followed by the node UUID
+};
+
 using namespace tbb;
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
-typedef concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
+typedef std::unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
+
+// The nodes at one point in time. It is never changed once published - adding or removing a node publishes a new one,
+// so readers can iterate and look up nodes without a lock, and keep using the one they took while nodes come and go.
+struct NodeSnapshot {
+    NodeHash nodeHash;
+    std::vector<SharedNodePointer> nodes; // the values of nodeHash, to iterate contiguously
+
+    // nodes by the socket they had active when this was published - also published again when a node activates one,
+    // since a node is only ever heard from on its active socket
+    std::unordered_map<HifiSockAddr, SharedNodePointer> nodesByActiveSocket;
+};
+using NodeSnapshotPointer = std::shared_ptr<const NodeSnapshot>;
 
 typedef quint8 PingType_t;
 namespace PingType {
@@ -137,7 +157,7 @@ public:
 
     std::function<void(Node*)> linkedDataCreateCallback;
 
-    size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
+    size_t size() const { return getNodeSnapshot()->nodes.size(); }
 
     SharedNodePointer nodeWithUUID(const QUuid& nodeUUID);
 
@@ -177,48 +197,42 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // Cede control of iteration over one snapshot of the nodes (e.g. for use by thread pools)
+    // Use this for nested loops, so that every level sees the same nodes
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
-
-        std::vector<SharedNodePointer> nodes(_nodeHash.size());
-        std::transform(_nodeHash.cbegin(), _nodeHash.cend(), nodes.begin(), [](const NodeHash::value_type& it) {
-            return it.second;
-        });
-
-        functor(nodes.cbegin(), nodes.cend());
+        auto snapshot = getNodeSnapshot();
+        functor(snapshot->nodes.cbegin(), snapshot->nodes.cend());
     }
 
+    // The functors below may add or kill nodes, which the iteration in progress will not see
+
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -226,11 +240,11 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
@@ -245,8 +259,10 @@ public:
     void flagTimeForConnectionStep(ConnectionStep connectionStep);
 
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
+    QJsonObject takeSendSchedulerStats() { return _nodeSocket.getSendScheduler().takeLagStats(); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    bool setCongestionControl(const QString& name) { return _nodeSocket.setCongestionControl(name); }
 
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
@@ -310,15 +326,22 @@ protected:
                       const HifiSockAddr& overridenSockAddr);
     qint64 writePacket(const NLPacket& packet, const HifiSockAddr& destinationSockAddr,
                        const QUuid& connectionSecret = QUuid());
+
+    // sends to nodes use the verification key precomputed for their connection secret
+    qint64 sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr,
+                                const PacketVerificationKey& verificationKey);
+    qint64 sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
+                      const PacketVerificationKey& verificationKey);
+
     void collectPacketStats(const NLPacket& packet);
-    void fillPacketHeader(const NLPacket& packet, const QUuid& connectionSecret = QUuid());
+    void fillPacketHeader(const NLPacket& packet, const PacketVerificationKey& verificationKey = PacketVerificationKey());
 
     void setLocalSocket(const HifiSockAddr& sockAddr);
 
     bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet);
     void processSTUNResponse(std::unique_ptr<udt::BasePacket> packet);
 
-    void handleNodeKill(const SharedNodePointer& node);
+    virtual void handleNodeKill(const SharedNodePointer& node);
 
     void stopInitialSTUNUpdate(bool success);
 
@@ -327,9 +350,16 @@ protected:
 
     bool sockAddrBelongsToNode(const HifiSockAddr& sockAddr) { return findNodeWithAddr(sockAddr) != SharedNodePointer(); }
 
+    NodeSnapshotPointer getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
+
+    // for writers only, which hold _nodeWriteMutex from taking the snapshot they change until they publish it
+    void publishNodes(NodeHash nodeHash);
+
+    void nodeSocketActivated();
+
     QUuid _sessionUUID;
-    NodeHash _nodeHash;
-    mutable QReadWriteLock _nodeMutex;
+    NodeSnapshotPointer _nodeSnapshot; // only accessed with std::atomic_load and std::atomic_store
+    QMutex _nodeWriteMutex;
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket;
     HifiSockAddr _localSockAddr;
@@ -356,16 +386,6 @@ protected:
     QMap<quint64, ConnectionStep> _lastConnectionTimes;
     bool _areConnectionTimesComplete = false;
 
-    template<typename IteratorLambda>
-    void eachNodeHashIterator(IteratorLambda functor) {
-        QWriteLocker writeLock(&_nodeMutex);
-        NodeHash::iterator it = _nodeHash.begin();
-
-        while (it != _nodeHash.end()) {
-            functor(it);
-        }
-    }
-
 private slots:
     void flagTimeForConnectionStep(ConnectionStep connectionStep, quint64 timestamp);
     void possiblyTimeoutSTUNAddressLookup();
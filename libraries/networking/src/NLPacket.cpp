@@ -14,7 +14,7 @@
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = NON_SOURCED_PACKETS.contains(type);
     bool nonVerified = NON_VERIFIED_PACKETS.contains(type);
-    qint64 optionalSize = (nonSourced ? 0 : NUM_BYTES_RFC4122_UUID) + ((nonSourced || nonVerified) ? 0 : NUM_BYTES_MD5_HASH);
+    qint64 optionalSize = (nonSourced ? 0 : NUM_BYTES_RFC4122_UUID) + ((nonSourced || nonVerified) ? 0 : NUM_BYTES_VERIFICATION_HASH);
     return sizeof(PacketType) + sizeof(PacketVersion) + optionalSize;
 }
 int NLPacket::totalHeaderSize(PacketType type, bool isPartOfMessage) {
@@ -144,23 +144,13 @@ QUuid NLPacket::sourceIDInHeader(const udt::Packet& packet) {
     return QUuid::fromRfc4122(QByteArray::fromRawData(packet.getData() + offset, NUM_BYTES_RFC4122_UUID));
 }
 
-QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
-    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_RFC4122_UUID;
-    return QByteArray(packet.getData() + offset, NUM_BYTES_MD5_HASH);
-}
-
-QByteArray NLPacket::hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret) {
-    QCryptographicHash hash(QCryptographicHash::Md5);
-    
+bool NLPacket::verificationHashMatches(const udt::Packet& packet, const PacketVerificationKey& key) {
     int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
-        + NUM_BYTES_RFC4122_UUID + NUM_BYTES_MD5_HASH;
-    
-    // add the packet payload and the connection UUID
-    hash.addData(packet.getData() + offset, packet.getDataSize() - offset);
-    hash.addData(connectionSecret.toRfc4122());
-    
-    // return the hash
-    return hash.result();
+        + NUM_BYTES_RFC4122_UUID;
+    int payloadOffset = offset + NUM_BYTES_VERIFICATION_HASH;
+
+    // the hash covers the packet payload
+    return key.matches(packet.getData() + payloadOffset, packet.getDataSize() - payloadOffset, packet.getData() + offset);
 }
 
 void NLPacket::writeTypeAndVersion() {
@@ -212,12 +202,12 @@ void NLPacket::writeSourceID(const QUuid& sourceID) const {
     _sourceID = sourceID;
 }
 
-void NLPacket::writeVerificationHashGivenSecret(const QUuid& connectionSecret) const {
+void NLPacket::writeVerificationHash(const PacketVerificationKey& key) const {
     Q_ASSERT(!NON_SOURCED_PACKETS.contains(_type) && !NON_VERIFIED_PACKETS.contains(_type));
     
     auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
                 + NUM_BYTES_RFC4122_UUID;
-    QByteArray verificationHash = hashForPacketAndSecret(*this, connectionSecret);
-    
-    memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
+    auto payloadOffset = offset + NUM_BYTES_VERIFICATION_HASH;
+
+    key.hash(_packet.get() + payloadOffset, getDataSize() - payloadOffset, _packet.get() + offset);
 }
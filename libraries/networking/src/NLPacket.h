@@ -17,6 +17,7 @@
 #include <UUID.h>
 
 #include "udt/Packet.h"
+#include "PacketVerificationKey.h"
 
 class NLPacket : public udt::Packet {
     Q_OBJECT
@@ -35,7 +36,7 @@ public:
     // this is used by the Octree classes - must be known at compile time
     static const int MAX_PACKET_HEADER_SIZE =
         sizeof(udt::Packet::SequenceNumberAndBitField) + sizeof(udt::Packet::MessageNumberAndBitField) +
-        sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_RFC4122_UUID + NUM_BYTES_MD5_HASH;
+        sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_RFC4122_UUID + NUM_BYTES_VERIFICATION_HASH;
     
     static std::unique_ptr<NLPacket> create(PacketType type, qint64 size = -1,
                     bool isReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
@@ -58,8 +59,7 @@ public:
     static PacketVersion versionInHeader(const udt::Packet& packet);
     
     static QUuid sourceIDInHeader(const udt::Packet& packet);
-    static QByteArray verificationHashInHeader(const udt::Packet& packet);
-    static QByteArray hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret);
+    static bool verificationHashMatches(const udt::Packet& packet, const PacketVerificationKey& key);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -70,7 +70,7 @@ public:
     const QUuid& getSourceID() const { return _sourceID; }
     
     void writeSourceID(const QUuid& sourceID) const;
-    void writeVerificationHashGivenSecret(const QUuid& connectionSecret) const;
+    void writeVerificationHash(const PacketVerificationKey& key) const;
 
 protected:
     
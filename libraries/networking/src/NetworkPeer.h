@@ -18,6 +18,7 @@
 #include <QtCore/QTimer>
 #include <QtCore/QUuid>
 
+#include "BandwidthRecorder.h"
 #include "HifiSockAddr.h"
 
 const QString ICE_SERVER_HOSTNAME = "localhost";
@@ -103,6 +104,9 @@ protected:
     QTimer* _pingTimer = NULL;
 
     int _connectionAttempts;
+
+    // kept on the peer so recording a packet does not look the peer up in a shared table
+    mutable BandwidthRecorder::Channel _bandwidth;
 };
 
 QDebug operator<<(QDebug debug, const NetworkPeer &peer);
@@ -55,6 +55,7 @@ Node::Node(const QUuid& uuid, NodeType_t type, const HifiSockAddr& publicSocket,
     NetworkPeer(uuid, publicSocket, localSocket, parent),
     _type(type),
     _connectionSecret(connectionSecret),
+    _verificationKey(connectionSecret),
     _isAlive(true),
     _pingMs(-1),  // "Uninitialized"
     _clockSkewUsec(0),
@@ -76,6 +77,11 @@ void Node::setType(char type) {
     _symmetricSocket.setObjectName(typeString);
 }
 
+void Node::setConnectionSecret(const QUuid& connectionSecret) {
+    _connectionSecret = connectionSecret;
+    _verificationKey = PacketVerificationKey(connectionSecret);
+}
+
 void Node::updateClockSkewUsec(qint64 clockSkewSample) {
     _clockSkewMovingPercentile.updatePercentile(clockSkewSample);
     _clockSkewUsec = (quint64)_clockSkewMovingPercentile.getValueAtPercentile();
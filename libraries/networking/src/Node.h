@@ -33,6 +33,7 @@
 #include "SimpleMovingAverage.h"
 #include "MovingPercentile.h"
 #include "NodePermissions.h"
+#include "PacketVerificationKey.h"
 
 class Node : public NetworkPeer {
     Q_OBJECT
@@ -49,7 +50,8 @@ public:
     void setType(char type);
 
     const QUuid& getConnectionSecret() const { return _connectionSecret; }
-    void setConnectionSecret(const QUuid& connectionSecret) { _connectionSecret = connectionSecret; }
+    void setConnectionSecret(const QUuid& connectionSecret);
+    const PacketVerificationKey& getVerificationKey() const { return _verificationKey; }
 
     NodeData* getLinkedData() const { return _linkedData.get(); }
     void setLinkedData(std::unique_ptr<NodeData> linkedData) { _linkedData = std::move(linkedData); }
@@ -71,6 +73,7 @@ public:
     bool getCanRezTmp() const { return _permissions.can(NodePermissions::Permission::canRezTemporaryEntities); }
     bool getCanWriteToAssetServer() const { return _permissions.can(NodePermissions::Permission::canWriteToAssetServer); }
     bool getCanKick() const { return _permissions.can(NodePermissions::Permission::canKick); }
+    bool getCanHostAvatars() const { return _permissions.can(NodePermissions::Permission::canHostAvatars); }
 
     void parseIgnoreRequestMessage(QSharedPointer<ReceivedMessage> message);
     void addIgnoredNode(const QUuid& otherNodeID);
@@ -91,6 +94,7 @@ private:
     NodeType_t _type;
 
     QUuid _connectionSecret;
+    PacketVerificationKey _verificationKey;
     std::unique_ptr<NodeData> _linkedData;
     bool _isAlive;
     int _pingMs;
@@ -237,6 +237,7 @@ void NodeList::reset() {
     LimitedNodeList::reset();
 
     _numNoReplyDomainCheckIns = 0;
+    _domainListEpoch = 0;
 
     // lock and clear our set of radius ignored IDs
     _radiusIgnoredSetLock.lockForWrite();
@@ -391,6 +392,11 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // the domain-server only sends what changed since this list
+            packetStream << _domainListEpoch.load();
+        }
+
         if (!_domainHandler.isConnected()) {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -620,10 +626,36 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
-    // pull each node in the packet
+    // the epoch of this list, and the one it is a delta from (zero for a full list)
+    quint32 listEpoch;
+    quint32 baseEpoch;
+    packetStream >> listEpoch >> baseEpoch;
+
+    quint32 heldEpoch = _domainListEpoch;
+    if (baseEpoch != 0 && listEpoch < heldEpoch) {
+        // a late reply to an earlier check-in, what it holds is already out of date
+        return;
+    }
+
+    // pull each entry in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        quint8 entry;
+        packetStream >> entry;
+
+        if ((DomainListEntry)entry == DomainListEntry::RemovedNode) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            _isApplyingDomainServerRemovals = true;
+            killNodeWithUUID(nodeUUID);
+            _isApplyingDomainServerRemovals = false;
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
     }
+
+    // changes are applied whatever list they are based on, but if it isn't one we have had
+    // some changes are missing, so ask for the full list next time (as a node killed meanwhile already did)
+    _domainListEpoch.compare_exchange_strong(heldEpoch, (baseEpoch <= heldEpoch) ? listEpoch : 0);
 }
 
 void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
@@ -638,7 +670,20 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+    _isApplyingDomainServerRemovals = true;
     killNodeWithUUID(nodeUUID);
+    _isApplyingDomainServerRemovals = false;
+}
+
+void NodeList::handleNodeKill(const SharedNodePointer& node) {
+    // a node killed here (gone silent, or on request) is still in the list the domain-server thinks we hold,
+    // and deltas only carry changes, so it would never be sent again - ask for the full list at the next check-in
+    bool isDomainServerRemoval = QThread::currentThread() == thread() && _isApplyingDomainServerRemovals;
+    if (!isDomainServerRemoval) {
+        _domainListEpoch = 0;
+    }
+
+    LimitedNodeList::handleNodeKill(node);
 }
 
 void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
@@ -94,6 +94,8 @@ public slots:
     void sendDomainServerCheckIn();
     void handleDSPathQuery(const QString& newPath);
 
+    void handleNodeKill(const SharedNodePointer& node) override;
+
     void processDomainServerList(QSharedPointer<ReceivedMessage> message);
     void processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message);
     void processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message);
@@ -156,6 +158,8 @@ private:
     NodeSet _nodeTypesOfInterest;
     DomainHandler _domainHandler;
     int _numNoReplyDomainCheckIns;
+    std::atomic<quint32> _domainListEpoch { 0 };
+    bool _isApplyingDomainServerRemovals { false }; // only used on the node list thread
     HifiSockAddr _assignmentServerSocket;
     bool _isShuttingDown { false };
     QTimer _keepAlivePingTimer;
@@ -45,6 +45,7 @@ NodePermissions::NodePermissions(QMap<QString, QVariant> perms) {
     permissions |= perms["id_can_connect_past_max_capacity"].toBool() ?
         Permission::canConnectPastMaxCapacity : Permission::none;
     permissions |= perms["id_can_kick"].toBool() ? Permission::canKick : Permission::none;
+    permissions |= perms["id_can_host_avatars"].toBool() ? Permission::canHostAvatars : Permission::none;
 }
 
 QVariant NodePermissions::toVariant(QHash<QUuid, GroupRank> groupRanks) {
@@ -65,6 +66,7 @@ QVariant NodePermissions::toVariant(QHash<QUuid, GroupRank> groupRanks) {
     values["id_can_write_to_asset_server"] = can(Permission::canWriteToAssetServer);
     values["id_can_connect_past_max_capacity"] = can(Permission::canConnectPastMaxCapacity);
     values["id_can_kick"] = can(Permission::canKick);
+    values["id_can_host_avatars"] = can(Permission::canHostAvatars);
     return QVariant(values);
 }
 
@@ -128,6 +130,9 @@ QDebug operator<<(QDebug debug, const NodePermissions& perms) {
     if (perms.can(NodePermissions::Permission::canKick)) {
         debug << " kick";
     }
+    if (perms.can(NodePermissions::Permission::canHostAvatars)) {
+        debug << " host-avatars";
+    }
     debug.nospace() << "]";
     return debug.nospace();
 }
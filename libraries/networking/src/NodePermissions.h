@@ -64,7 +64,8 @@ public:
         canRezTemporaryEntities = 8,
         canWriteToAssetServer = 16,
         canConnectPastMaxCapacity = 32,
-        canKick = 64
+        canKick = 64,
+        canHostAvatars = 128
     };
     Q_DECLARE_FLAGS(Permissions, Permission)
     Permissions permissions;
@@ -12,14 +12,20 @@
 
 #include "PacketReceiver.h"
 
+#include <QMetaEnum>
 #include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
 
 #include "DependencyManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "SharedUtil.h"
 
-PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
+PacketReceiver::PacketReceiver(QObject* parent) :
+    QObject(parent),
+    _handlers((int)PacketType::LAST_PACKET_TYPE + 1)
+{
     qRegisterMetaType<QSharedPointer<NLPacket>>();
     qRegisterMetaType<QSharedPointer<NLPacketList>>();
     qRegisterMetaType<QSharedPointer<ReceivedMessage>>();
@@ -178,8 +184,42 @@ void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object,
     _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending };
 }
 
+bool PacketReceiver::registerHandlerForTypes(PacketTypeList types, QObject* owner, MessageHandler handler,
+                                             HandlerExecutor executor) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerHandlerForTypes", "No types to register");
+    Q_ASSERT_X(owner, "PacketReceiver::registerHandlerForTypes", "No owner to register");
+    Q_ASSERT_X(handler, "PacketReceiver::registerHandlerForTypes", "No handler to register");
+
+    if (!owner || !handler || types.empty()) {
+        return false;
+    }
+
+    QWriteLocker locker(&_handlerLock);
+    for (PacketType type : types) {
+        auto& entry = _handlers[(int)type];
+        if (entry) {
+            qCWarning(networking) << "Registering a packet handler for packet type" << type
+                << "that will remove a previously registered handler";
+        }
+        qCDebug(networking) << "Registering a packet handler for packet type" << type;
+        entry = std::make_shared<Handler>(type, owner, handler, executor);
+    }
+    return true;
+}
+
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
+
+    {
+        // also waits for any inline handler of this listener to return
+        QWriteLocker handlerLocker(&_handlerLock);
+        for (auto& handler : _handlers) {
+            if (handler && handler->owner == listener) {
+                handler->isRegistered = false;
+                handler.reset();
+            }
+        }
+    }
     
     {
         QMutexLocker packetListenerLocker(&_packetListenerLock);
@@ -200,6 +240,107 @@ void PacketReceiver::unregisterListener(QObject* listener) {
     _directlyConnectedObjects.remove(listener);
 }
 
+QJsonObject PacketReceiver::takeHandlerLatencyStats() {
+    static const QMetaEnum metaEnum =
+        PacketTypeEnum::staticMetaObject.enumerator(PacketTypeEnum::staticMetaObject.enumeratorOffset());
+
+    QJsonObject stats;
+
+    QReadLocker locker(&_handlerLock);
+    for (auto& handler : _handlers) {
+        if (!handler) {
+            continue;
+        }
+        quint64 numMessages = handler->numMessages.exchange(0);
+        quint64 totalLatencyUsecs = handler->totalLatencyUsecs.exchange(0);
+        quint64 maxLatencyUsecs = handler->maxLatencyUsecs.exchange(0);
+
+        QJsonObject typeStats;
+        typeStats["messages"] = (double)numMessages;
+        typeStats["avg_latency_usecs"] = numMessages > 0 ? (double)totalLatencyUsecs / numMessages : 0.0;
+        typeStats["max_latency_usecs"] = (double)maxLatencyUsecs;
+        stats[metaEnum.valueToKey((int)handler->type)] = typeStats;
+    }
+    return stats;
+}
+
+void PacketReceiver::runHandler(const QueuedMessage& queuedMessage) {
+    auto& handler = *queuedMessage.handler;
+
+    // queued handlers run after the dispatch, by which time they may have been unregistered
+    if (!handler.isRegistered || !handler.owner) {
+        return;
+    }
+
+    quint64 latencyUsecs = usecTimestampNow() - queuedMessage.dispatchedUsecs;
+    handler.numMessages++;
+    handler.totalLatencyUsecs += latencyUsecs;
+    quint64 maxLatencyUsecs = handler.maxLatencyUsecs;
+    while (latencyUsecs > maxLatencyUsecs && !handler.maxLatencyUsecs.compare_exchange_weak(maxLatencyUsecs, latencyUsecs)) {
+    }
+
+    handler.function(queuedMessage.message, queuedMessage.sendingNode);
+}
+
+int PacketReceiver::HandlerQueue::process() {
+    int numProcessed = 0;
+    QueuedMessage queuedMessage;
+    while (_messages.try_pop(queuedMessage)) {
+        runHandler(queuedMessage);
+        ++numProcessed;
+    }
+    return numProcessed;
+}
+
+namespace {
+
+class HandlerRunnable : public QRunnable {
+public:
+    HandlerRunnable(std::function<void()> function) : _function(std::move(function)) {}
+    void run() override { _function(); }
+
+private:
+    std::function<void()> _function;
+};
+
+}
+
+bool PacketReceiver::dispatchToHandler(const QSharedPointer<ReceivedMessage>& message,
+                                       const SharedNodePointer& matchingNode) {
+    QReadLocker locker(&_handlerLock);
+
+    auto& handler = _handlers[(int)message->getType()];
+    if (!handler) {
+        return false;
+    }
+
+    // the message is ours, but is not delivered until complete, and never from an unknown node
+    if (!message->isComplete() || (!message->getSourceID().isNull() && !matchingNode) || !handler->owner) {
+        return true;
+    }
+
+    if (matchingNode) {
+        matchingNode->recordBytesReceived(message->getSize());
+    }
+
+    QueuedMessage queuedMessage { handler, message, matchingNode, usecTimestampNow() };
+
+    switch (handler->executor.type) {
+        case HandlerExecutor::Inline:
+            runHandler(queuedMessage);
+            break;
+        case HandlerExecutor::Queue:
+            handler->executor.queue->_messages.push(std::move(queuedMessage));
+            break;
+        case HandlerExecutor::ThreadPool:
+            QThreadPool::globalInstance()->start(new HandlerRunnable([queuedMessage] {
+                runHandler(queuedMessage);
+            }));
+            break;
+    }
+    return true;
+}
+
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     // if we're supposed to drop this packet then break out here
     if (_shouldDropPackets) {
@@ -264,6 +405,10 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
     if (!receivedMessage->getSourceID().isNull()) {
         matchingNode = nodeList->nodeWithUUID(receivedMessage->getSourceID());
     }
+
+    if (dispatchToHandler(receivedMessage, matchingNode)) {
+        return;
+    }
     
     QMutexLocker packetListenerLocker(&_packetListenerLock);
     
@@ -13,18 +13,26 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QMap>
 #include <QtCore/QMetaMethod>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QSet>
 
+#include <tbb/concurrent_queue.h>
+
 #include "NLPacket.h"
 #include "NLPacketList.h"
+#include "Node.h"
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
@@ -42,8 +50,40 @@ namespace std {
 
 class PacketReceiver : public QObject {
     Q_OBJECT
+    struct Handler;
+    struct QueuedMessage {
+        std::shared_ptr<Handler> handler;
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer sendingNode;
+        quint64 dispatchedUsecs;
+    };
+
 public:
     using PacketTypeList = std::vector<PacketType>;
+    using MessageHandler = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+
+    // Messages for the handlers of a worker thread, which runs them by calling process().
+    // Pushing from the network thread does not take a lock.
+    class HandlerQueue {
+    public:
+        // run the queued handlers on the calling thread, returns how many ran
+        int process();
+
+    private:
+        friend class PacketReceiver;
+        tbb::concurrent_queue<QueuedMessage> _messages;
+    };
+
+    // Where a typed handler runs: inline on the network thread, from a HandlerQueue, or on the global thread pool
+    struct HandlerExecutor {
+        enum Type { Inline, Queue, ThreadPool };
+
+        HandlerExecutor(Type type = Inline) : type(type) { Q_ASSERT(type != Queue); }
+        HandlerExecutor(HandlerQueue& queue) : type(Queue), queue(&queue) {}
+
+        Type type;
+        HandlerQueue* queue { nullptr };
+    };
     
     PacketReceiver(QObject* parent = 0);
     PacketReceiver(const PacketReceiver&) = delete;
@@ -62,7 +102,28 @@ public:
     // for the message is received.
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
+
+    // Typed handlers are called directly, without going through the meta-object system or the owner's event loop.
+    // They take complete messages, and sourced messages only from known nodes. A handler registered for a type
+    // replaces any listener for it until the owner is unregistered; unregistering waits for running inline handlers,
+    // so it must not be called from one.
+    bool registerHandlerForTypes(PacketTypeList types, QObject* owner, MessageHandler handler,
+                                 HandlerExecutor executor = HandlerExecutor());
+    template <typename T>
+    bool registerHandlerForTypes(PacketTypeList types, T* owner,
+                                 void (T::*method)(QSharedPointer<ReceivedMessage>, SharedNodePointer),
+                                 HandlerExecutor executor = HandlerExecutor()) {
+        return registerHandlerForTypes(std::move(types), static_cast<QObject*>(owner),
+            [owner, method](QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+                (owner->*method)(message, sendingNode);
+            }, executor);
+    }
+
     void unregisterListener(QObject* listener);
+
+    // count, average and maximum time from dispatch to the start of a typed handler, per packet type,
+    // since the last call
+    QJsonObject takeHandlerLatencyStats();
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
@@ -75,8 +136,26 @@ private:
         bool deliverPending;
     };
 
+    struct Handler {
+        Handler(PacketType type, QObject* owner, MessageHandler function, HandlerExecutor executor) :
+            type(type), owner(owner), function(std::move(function)), executor(executor) {}
+
+        const PacketType type;
+        const QPointer<QObject> owner;
+        const MessageHandler function;
+        const HandlerExecutor executor;
+
+        std::atomic<bool> isRegistered { true };
+        std::atomic<quint64> numMessages { 0 };
+        std::atomic<quint64> totalLatencyUsecs { 0 };
+        std::atomic<quint64> maxLatencyUsecs { 0 };
+    };
+
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
 
+    bool dispatchToHandler(const QSharedPointer<ReceivedMessage>& message, const SharedNodePointer& matchingNode);
+    static void runHandler(const QueuedMessage& queuedMessage);
+
     // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
     // should be changed to have a true event loop and be able to handle our QMetaMethod::invoke
     void registerDirectListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
@@ -93,6 +172,10 @@ private:
     QMutex _directConnectSetMutex;
     QSet<QObject*> _directlyConnectedObjects;
 
+    // indexed by packet type
+    QReadWriteLock _handlerLock;
+    std::vector<std::shared_ptr<Handler>> _handlers;
+
     std::unordered_map<std::pair<HifiSockAddr, udt::Packet::MessageNumber>, QSharedPointer<ReceivedMessage>> _pendingMessages;
     
     friend class EntityEditPacketSender;
@@ -0,0 +1,119 @@
+//
+//  PacketVerificationKey.cpp
+//  libraries/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketVerificationKey.h"
+
+// byte order independent, compilers turn these into single loads and stores
+static inline uint64_t load64(const char* p) {
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+    return (uint64_t)b[0] | ((uint64_t)b[1] << 8) | ((uint64_t)b[2] << 16) | ((uint64_t)b[3] << 24) |
+        ((uint64_t)b[4] << 32) | ((uint64_t)b[5] << 40) | ((uint64_t)b[6] << 48) | ((uint64_t)b[7] << 56);
+}
+
+static inline void store64(char* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (char)(v >> (8 * i));
+    }
+}
+
+static inline uint64_t rotl(uint64_t x, int b) {
+    return (x << b) | (x >> (64 - b));
+}
+
+#define SIPROUND                                                        \
+    do {                                                                \
+        v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);       \
+        v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;                          \
+        v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;                          \
+        v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);       \
+    } while (0)
+
+PacketVerificationKey::PacketVerificationKey(uint64_t k0, uint64_t k1) :
+    _v0(k0 ^ 0x736f6d6570736575ULL),
+    _v1(k1 ^ 0x646f72616e646f6dULL ^ 0xee),    // 128 bit output
+    _v2(k0 ^ 0x6c7967656e657261ULL),
+    _v3(k1 ^ 0x7465646279746573ULL),
+    _isNull(k0 == 0 && k1 == 0)
+{
+}
+
+// the key is the secret in RFC 4122 byte order, as sent to the node by the domain-server
+static uint64_t secretWord(const QUuid& secret, int word) {
+    char bytes[16];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (char)(secret.data1 >> (24 - 8 * i));
+    }
+    bytes[4] = (char)(secret.data2 >> 8);
+    bytes[5] = (char)secret.data2;
+    bytes[6] = (char)(secret.data3 >> 8);
+    bytes[7] = (char)secret.data3;
+    for (int i = 0; i < 8; i++) {
+        bytes[8 + i] = (char)secret.data4[i];
+    }
+    return load64(bytes + 8 * word);
+}
+
+PacketVerificationKey::PacketVerificationKey(const QUuid& secret) :
+    PacketVerificationKey(secretWord(secret, 0), secretWord(secret, 1))
+{
+}
+
+void PacketVerificationKey::hash(const char* data, size_t size, char* hashOut) const {
+    uint64_t v0 = _v0;
+    uint64_t v1 = _v1;
+    uint64_t v2 = _v2;
+    uint64_t v3 = _v3;
+
+    const char* end = data + (size & ~(size_t)7);
+    for (; data != end; data += 8) {
+        uint64_t m = load64(data);
+        v3 ^= m;
+        SIPROUND;
+        SIPROUND;
+        v0 ^= m;
+    }
+
+    // last block: remaining bytes, with the length in the top byte
+    uint64_t b = (uint64_t)size << 56;
+    const uint8_t* tail = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < (size & 7); i++) {
+        b |= (uint64_t)tail[i] << (8 * i);
+    }
+    v3 ^= b;
+    SIPROUND;
+    SIPROUND;
+    v0 ^= b;
+
+    v2 ^= 0xee;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    store64(hashOut, v0 ^ v1 ^ v2 ^ v3);
+
+    v1 ^= 0xdd;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    store64(hashOut + 8, v0 ^ v1 ^ v2 ^ v3);
+}
+
+bool PacketVerificationKey::matches(const char* data, size_t size, const char* hash) const {
+    char expected[HASH_SIZE];
+    this->hash(data, size, expected);
+
+    // no early out, so that timing does not tell how much of a forged hash was right
+    uint8_t difference = 0;
+    for (int i = 0; i < HASH_SIZE; i++) {
+        difference |= (uint8_t)(expected[i] ^ hash[i]);
+    }
+    return difference == 0;
+}
@@ -0,0 +1,43 @@
+//
+//  PacketVerificationKey.h
+//  libraries/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketVerificationKey_h
+#define hifi_PacketVerificationKey_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <QtCore/QUuid>
+
+// Keyed MAC (SipHash-2-4, 128 bit output) used to verify sourced packets.
+// The key is the 128 bit connection secret; its initial state is computed once per connection,
+// and hashing works directly over the packet buffer without allocating.
+class PacketVerificationKey {
+public:
+    static const int HASH_SIZE = 16;
+
+    PacketVerificationKey() : PacketVerificationKey(QUuid()) {}
+    explicit PacketVerificationKey(const QUuid& secret);
+    PacketVerificationKey(uint64_t k0, uint64_t k1);
+
+    void hash(const char* data, size_t size, char* hashOut) const;
+    bool matches(const char* data, size_t size, const char* hash) const;
+
+    bool isNull() const { return _isNull; }
+
+private:
+    uint64_t _v0;
+    uint64_t _v1;
+    uint64_t _v2;
+    uint64_t _v3;
+    bool _isNull;
+};
+
+#endif // hifi_PacketVerificationKey_h
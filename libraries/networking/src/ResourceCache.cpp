@@ -9,12 +9,14 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
 #include <QThread>
 #include <QTimer>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <assert.h>
 
@@ -125,6 +127,76 @@ QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
     return highestResource;
 }
 
+// a request is only interrupted before it is halfway through, and not over and over
+static const float MAX_PREEMPTIBLE_PROGRESS = 0.5f;
+static const int MAX_PREEMPTIONS = 2;
+
+QSharedPointer<Resource> ResourceCacheSharedItems::getPreemptibleLoadingRequest(float priority) {
+    float lowestPriority = priority;
+    QSharedPointer<Resource> lowestResource;
+    Lock lock(_mutex);
+
+    foreach(QSharedPointer<Resource> resource, _loadingRequests) {
+        if (!resource || !resource->_request || resource->_preemptions >= MAX_PREEMPTIONS ||
+            resource->getProgress() > MAX_PREEMPTIBLE_PROGRESS) {
+            continue;
+        }
+
+        float loadPriority = resource->getLoadPriority();
+        if (loadPriority < lowestPriority) {
+            lowestPriority = loadPriority;
+            lowestResource = resource;
+        }
+    }
+
+    return lowestResource;
+}
+
+void ResourceCacheSharedItems::addBytesReceived(qint64 bytes) {
+    Lock lock(_mutex);
+    _windowBytes += bytes;
+}
+
+static const quint64 THROUGHPUT_WINDOW_USECS = USECS_PER_SECOND;
+static const float THROUGHPUT_TOLERANCE = 0.1f;
+static const int MIN_REQUEST_LIMIT = 2;
+
+int ResourceCacheSharedItems::updateRequestLimit(int currentLimit, int maximumLimit, bool isSaturated) {
+    Lock lock(_mutex);
+
+    quint64 now = usecTimestampNow();
+    if (_windowStart == 0) {
+        _windowStart = now;
+    }
+    if (now - _windowStart < THROUGHPUT_WINDOW_USECS) {
+        return std::min(currentLimit, maximumLimit);
+    }
+
+    float rate = (float)_windowBytes * USECS_PER_SECOND / (now - _windowStart);
+    _throughputKbps = rate * BITS_IN_BYTE / BYTES_PER_KILOBYTE;
+    _windowStart = now;
+    _windowBytes = 0;
+
+    if (!isSaturated) {
+        // nothing is waiting on the limit, so the throughput says nothing about it
+        _lastWindowRate = 0.0f;
+        return std::min(currentLimit, maximumLimit);
+    }
+
+    // hill climb: keep going while the throughput improves, turn back when it drops,
+    // and drift up towards the maximum otherwise
+    if (_lastWindowRate > 0.0f) {
+        if (rate < (1.0f - THROUGHPUT_TOLERANCE) * _lastWindowRate) {
+            _limitDirection = -_limitDirection;
+        } else if (rate < (1.0f + THROUGHPUT_TOLERANCE) * _lastWindowRate) {
+            _limitDirection = 1;
+        }
+    }
+    _lastWindowRate = rate;
+
+    return std::max(std::min(currentLimit + _limitDirection, maximumLimit), std::min(MIN_REQUEST_LIMIT, maximumLimit));
+}
+
 ScriptableResource::ScriptableResource(const QUrl& url) :
     QObject(nullptr),
     _url(url) { }
@@ -316,9 +388,10 @@ QVariantList ResourceCache::getResourceList() {
  
 void ResourceCache::setRequestLimit(int limit) {
     _requestLimit = limit;
+    _currentRequestLimit = limit;
 
     // Now go fill any new request spots
-    while (attemptHighestPriorityRequest()) {
+    while (_requestsActive < _currentRequestLimit && attemptHighestPriorityRequest()) {
         // just keep looping until we reach the new limit or no more pending requests
     }
 }
@@ -472,13 +545,34 @@ int ResourceCache::getLoadingRequestCount() {
     return DependencyManager::get<ResourceCacheSharedItems>()->getLoadingRequestsCount();
 }
 
+float ResourceCache::getAverageQueueTimeMsecs() {
+    auto& queueTime = DependencyManager::get<ResourceCacheSharedItems>()->queueTime;
+    return queueTime.isAverageValid() ? queueTime.getAverage() : 0.0f;
+}
+
+float ResourceCache::getAverageUsableTimeMsecs() {
+    auto& usableTime = DependencyManager::get<ResourceCacheSharedItems>()->usableTime;
+    return usableTime.isAverageValid() ? usableTime.getAverage() : 0.0f;
+}
+
+float ResourceCache::getThroughputKbps() {
+    return DependencyManager::get<ResourceCacheSharedItems>()->getThroughputKbps();
+}
+
 bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
 
-    if (_requestsActive >= _requestLimit) {
+    if (_requestsActive >= _currentRequestLimit) {
         // wait until a slot becomes available
         sharedItems->appendPendingRequest(resource);
+
+        // unless a loading request has a lower priority, is less than half loaded and has not been preempted
+        // too often already, in which case it gives up its slot
+        auto preempted = sharedItems->getPreemptibleLoadingRequest(resource->getLoadPriority());
+        if (preempted) {
+            preempted->preempt();
+        }
         return false;
     }
     
@@ -493,7 +587,12 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
     sharedItems->removeRequest(resource);
     --_requestsActive;
 
-    attemptHighestPriorityRequest();
+    bool isSaturated = sharedItems->getPendingRequestsCount() > 0;
+    _currentRequestLimit = sharedItems->updateRequestLimit(_currentRequestLimit, _requestLimit, isSaturated);
+
+    // fill the free slots, of which there may be several after the limit increased
+    while (_requestsActive < _currentRequestLimit && attemptHighestPriorityRequest()) {
+    }
 }
 
 bool ResourceCache::attemptHighestPriorityRequest() {
@@ -504,6 +603,7 @@ bool ResourceCache::attemptHighestPriorityRequest() {
 
 const int DEFAULT_REQUEST_LIMIT = 10;
 int ResourceCache::_requestLimit = DEFAULT_REQUEST_LIMIT;
+int ResourceCache::_currentRequestLimit = DEFAULT_REQUEST_LIMIT;
 int ResourceCache::_requestsActive = 0;
 
 static int requestID = 0;
@@ -611,6 +711,9 @@ void Resource::init() {
     _failedToLoad = false;
     _loaded = false;
     _attempts = 0;
+    _preemptions = 0;
+    _queuedTimestamp = 0;
+    _requestTimestamp = 0;
     _activeUrl = _url;
     
     if (_url.isEmpty()) {
@@ -625,6 +728,9 @@ const int MAX_ATTEMPTS = 8;
 
 void Resource::attemptRequest() {
     _startedLoading = true;
+    if (_queuedTimestamp == 0) {
+        _queuedTimestamp = usecTimestampNow();
+    }
 
     if (_attempts > 0) {
         qCDebug(networking).noquote() << "Server unavailable for" << _url
@@ -638,6 +744,10 @@ void Resource::finishedLoading(bool success) {
     if (success) {
         qCDebug(networking).noquote() << "Finished loading:" << _url.toDisplayString();
         _loaded = true;
+        if (_queuedTimestamp != 0) {
+            auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+            sharedItems->usableTime.addSample((float)(usecTimestampNow() - _queuedTimestamp) / USECS_PER_MSEC);
+        }
     } else {
         qCDebug(networking).noquote() << "Failed to load:" << _url.toDisplayString();
         _failedToLoad = true;
@@ -679,6 +789,12 @@ void Resource::makeRequest() {
     qCDebug(resourceLog).noquote() << "Starting request for:" << _url.toDisplayString();
     emit loading();
 
+    if (_requestTimestamp == 0 && _queuedTimestamp != 0) {
+        _requestTimestamp = usecTimestampNow();
+        auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+        sharedItems->queueTime.addSample((float)(_requestTimestamp - _queuedTimestamp) / USECS_PER_MSEC);
+    }
+
     connect(_request, &ResourceRequest::progress, this, &Resource::onProgress);
     connect(this, &Resource::onProgress, this, &Resource::handleDownloadProgress);
 
@@ -689,7 +805,29 @@ void Resource::makeRequest() {
     _request->send();
 }
 
+void Resource::preempt() {
+    if (!_request) {
+        return;
+    }
+
+    qCDebug(networking).noquote() << "Preempting request for" << _url.toDisplayString()
+        << "received" << _bytesReceived << "of" << _bytesTotal;
+    PROFILE_ASYNC_END(resource, "Resource:" + getType(), QString::number(_requestID), { { "preempted", true } });
+
+    _request->disconnect(this);
+    _request->deleteLater();
+    _request = nullptr;
+    _preemptions++;
+
+    // the freed slot goes to the highest priority pending request, and this one waits its turn again
+    ResourceCache::requestCompleted(_self);
+    DependencyManager::get<ResourceCacheSharedItems>()->appendPendingRequest(_self);
+}
+
 void Resource::handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTotal) {
+    if (bytesReceived > (uint64_t)_bytesReceived) {
+        DependencyManager::get<ResourceCacheSharedItems>()->addBytesReceived(bytesReceived - _bytesReceived);
+    }
     _bytesReceived = bytesReceived;
     _bytesTotal = bytesTotal;
 }
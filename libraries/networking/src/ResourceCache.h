@@ -31,6 +31,7 @@
 #include <QScriptEngine>
 
 #include <DependencyManager.h>
+#include <SimpleMovingAverage.h>
 
 #include "ResourceManager.h"
 
@@ -75,12 +76,34 @@ public:
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getLoadingRequestsCount() const;
 
+    /// Returns the loading request of lowest priority below the given one that is worth interrupting, if any
+    QSharedPointer<Resource> getPreemptibleLoadingRequest(float priority);
+
+    void addBytesReceived(qint64 bytes);
+
+    /// Returns the request limit to use next, stepping towards the one with the best throughput
+    /// \param isSaturated whether requests are waiting on the current limit
+    int updateRequestLimit(int currentLimit, int maximumLimit, bool isSaturated);
+
+    float getThroughputKbps() const { return _throughputKbps; }
+
+    // in msecs, from the first attempt to the start of the request, and to the resource being usable
+    ThreadSafeMovingAverage<float, 64> queueTime;
+    ThreadSafeMovingAverage<float, 64> usableTime;
+
 private:
     ResourceCacheSharedItems() = default;
 
     mutable Mutex _mutex;
     QList<QWeakPointer<Resource>> _pendingRequests;
     QList<QWeakPointer<Resource>> _loadingRequests;
+
+    // throughput, measured over windows of the request limit
+    quint64 _windowStart { 0 };
+    qint64 _windowBytes { 0 };
+    float _lastWindowRate { 0.0f };
+    int _limitDirection { 1 };
+    std::atomic<float> _throughputKbps { 0.0f };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -233,7 +256,15 @@ public:
     static void setRequestLimit(int limit);
     static int getRequestLimit() { return _requestLimit; }
 
+    /// Returns the number of concurrent requests currently allowed, adapted to the measured throughput
+    static int getCurrentRequestLimit() { return _currentRequestLimit; }
+
     static int getRequestsActive() { return _requestsActive; }
+
+    /// Download metrics, averaged over recent resources
+    static float getAverageQueueTimeMsecs();
+    static float getAverageUsableTimeMsecs();
+    static float getThroughputKbps();
     
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
     qint64 getUnusedResourceCacheSize() const { return _unusedResourcesMaxSize; }
@@ -314,6 +345,7 @@ private:
     void removeResource(const QUrl& url, qint64 size = 0);
 
     static int _requestLimit;
+    static int _currentRequestLimit;
     static int _requestsActive;
 
     // Resources
@@ -455,11 +487,13 @@ private slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
     
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
     
     void makeRequest();
+    void preempt();
     void retry();
     void reinsert();
 
@@ -474,6 +508,9 @@ private:
     qint64 _bytesTotal{ 0 };
     qint64 _bytes{ 0 };
     int _attempts{ 0 };
+    int _preemptions{ 0 };
+    quint64 _queuedTimestamp{ 0 };
+    quint64 _requestTimestamp{ 0 };
     bool _isInScript{ false };
 };
 
@@ -99,6 +99,13 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     statsObject["packets_per_second"] = packetsPerSecond;
     statsObject["bytes_per_second"] = bytesPerSecond;
 
+    QJsonObject handlerLatencyStats = nodeList->getPacketReceiver().takeHandlerLatencyStats();
+    if (!handlerLatencyStats.isEmpty()) {
+        statsObject["packet_handlers"] = handlerLatencyStats;
+    }
+
+    statsObject["send_scheduler"] = nodeList->takeSendSchedulerStats();
+
     nodeList->sendStatsToDomainServer(statsObject);
 }
 
@@ -0,0 +1,348 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <NumericalConstants.h>
+
+using namespace udt;
+using namespace std::chrono;
+
+// http://queue.acm.org/detail.cfm?id=3022184
+// https://tools.ietf.org/html/draft-cardwell-iccrg-bbr-congestion-control-00
+
+// the smallest gain that can double the delivery rate each round (2 / ln 2)
+static const double HIGH_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / HIGH_GAIN;
+static const double PROBE_BW_CONGESTION_WINDOW_GAIN = 2.0;
+
+// probe for more bandwidth for one phase, drain what that queued for the next, then cruise
+static const int GAIN_CYCLE_LENGTH = 8;
+static const double PACING_GAIN_CYCLE[GAIN_CYCLE_LENGTH] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+// the pipe is full when the bandwidth has not grown by a quarter in three rounds
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int MIN_CONGESTION_WINDOW = 4;
+static const int CONGESTION_WINDOW_QUANTA = 3; // room for delayed and stretched ACKs
+static const int INITIAL_CONGESTION_WINDOW = 16;
+
+static const seconds MIN_RTT_FILTER_WINDOW { 10 };
+static const milliseconds PROBE_RTT_DURATION { 200 };
+
+BBRCC::BBRCC() :
+    _pacingGain(HIGH_GAIN),
+    _congestionWindowGain(HIGH_GAIN)
+{
+    _packetSendPeriod = 0.0; // not paced until there is a bandwidth sample
+    _congestionWindowSize = INITIAL_CONGESTION_WINDOW;
+
+    setAckInterval(1); // the delivery rate and RTT are sampled from an ACK per packet
+
+    _roundMaxBandwidths.fill(0.0);
+
+    // we can't do this as a member initializer until our VS has support for constexpr
+    _minRTT = std::numeric_limits<int>::max();
+}
+
+void BBRCC::setInitialSendSequenceNumber(SequenceNumber seqNum) {
+    // a new send queue starts over from this sequence number - the model of the path is kept,
+    // but nothing sent by the last queue is in flight or will be delivered anymore
+    _sentPackets.clear();
+    _firstSentSequenceNumber = seqNum;
+    _lastACK = seqNum - 1;
+    _lastSendTime = TimePoint();
+
+    _delivered = 0;
+    _deliveredTime = TimePoint();
+    _appLimitedUntil = 0;
+    _nextRoundDelivered = 0;
+    _isRoundStart = false;
+    _isLastSampleAppLimited = false;
+
+    // the sequence numbers start at random, so connections start their gain cycles at different phases
+    _random.seed((SequenceNumber::UType) seqNum);
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPackets.empty()) {
+        _firstSentSequenceNumber = seqNum;
+
+        // nothing is in flight, so the delivery rate is measured from now rather than from before the idle time
+        _deliveredTime = timePoint;
+    }
+
+    int offset = seqoff(_firstSentSequenceNumber, seqNum);
+    if (offset < 0) {
+        // already ACKed
+        return;
+    }
+
+    if (offset >= (int)_sentPackets.size()) {
+        // a new packet - if it went out later than pacing asked for, the queue ran out of packets to send,
+        // so the delivery rate until what is in flight now is delivered shows the app and not the path
+        auto sinceLastSend = duration_cast<microseconds>(timePoint - _lastSendTime).count();
+        if (_sentPackets.empty() || sinceLastSend > std::max(2.0 * _packetSendPeriod, _minRTT / 4.0)) {
+            _appLimitedUntil = _delivered + packetsInFlight() + 1;
+        }
+
+        while ((int)_sentPackets.size() <= offset) {
+            _sentPackets.push_back(SentPacket());
+        }
+
+        _lastSendTime = timePoint;
+    }
+
+    auto& packet = _sentPackets[offset];
+    packet.isRetransmitted = packet.isSent;
+    packet.isSent = true;
+    packet.sendTime = timePoint;
+    packet.delivered = _delivered;
+    packet.deliveredTime = _deliveredTime;
+    packet.isAppLimited = _appLimitedUntil > _delivered;
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    int newlyACKed = seqoff(_lastACK, ack);
+    if (newlyACKed <= 0) {
+        return false;
+    }
+
+    _lastACK = ack;
+    _delivered += newlyACKed;
+    _deliveredTime = receiveTime;
+
+    int offset = seqoff(_firstSentSequenceNumber, ack);
+    if (offset >= 0 && offset < (int)_sentPackets.size()) {
+        // the ACK is for the last packet received in order, sample from when it was sent
+        auto packet = _sentPackets[offset];
+        if (packet.isSent) {
+            updateRTT(packet, receiveTime);
+            updateBandwidth(packet, receiveTime);
+            updateMode(receiveTime);
+        }
+
+        for (int i = 0; i <= offset; ++i) {
+            _sentPackets.pop_front();
+        }
+        _firstSentSequenceNumber = ack + 1;
+    }
+
+    updateCongestionWindowAndPacingRate(newlyACKed);
+
+    // the ACK for the next packet should have come by now if it had been received,
+    // re-send it instead of waiting for the send queue to time out
+    if (!_sentPackets.empty() && _sentPackets.front().isSent && _ewmaRTT != -1) {
+        auto sinceSend = duration_cast<microseconds>(receiveTime - _sentPackets.front().sendTime).count();
+        if (sinceSend > _ewmaRTT + _rttVariance * 4) {
+            // count it as re-sent now, so the ACKs that come before it is don't re-send it again
+            _sentPackets.front().sendTime = receiveTime;
+            _sentPackets.front().isRetransmitted = true;
+            _hasLossInPhase = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BBRCC::onTimeout() {
+    // nothing has been ACKed for a while, start over from a small window - the path model is kept,
+    // so the window grows back to it in a few rounds
+    _congestionWindowSize = MIN_CONGESTION_WINDOW;
+    _hasLossInPhase = true;
+}
+
+void BBRCC::updateRTT(const SentPacket& packet, TimePoint now) {
+    _isMinRTTExpired = _minRTT != std::numeric_limits<int>::max() && now - _minRTTTime > MIN_RTT_FILTER_WINDOW;
+
+    if (packet.isRetransmitted) {
+        // we can't tell which send this ACK is for
+        return;
+    }
+
+    // we do not allow a zero microsecond RTT
+    int rtt = std::max((int)duration_cast<microseconds>(now - packet.sendTime).count(), 1);
+
+    // the smoothed RTT and its variance are for telling loss from queueing, as in TCPVegasCC
+    static const int RTT_ESTIMATION_ALPHA = 8;
+    static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1) + abs(rtt - _ewmaRTT))
+            / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    if (rtt <= _minRTT || _isMinRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTime = now;
+    }
+}
+
+void BBRCC::updateBandwidth(const SentPacket& packet, TimePoint now) {
+    _isRoundStart = false;
+    if (packet.delivered >= _nextRoundDelivered) {
+        // the first packet sent in this round was delivered, start the next
+        _nextRoundDelivered = _delivered;
+        ++_roundCount;
+        _isRoundStart = true;
+
+        _roundMaxBandwidths[_roundCount % BANDWIDTH_FILTER_ROUNDS] = 0.0;
+    }
+
+    _isLastSampleAppLimited = packet.isAppLimited;
+
+    // delivered over the time it took, since this packet was sent - shorter than a round trip would be
+    // ACK compression, and overestimate
+    auto interval = duration_cast<microseconds>(now - packet.deliveredTime).count();
+    if (interval > 0 && interval >= _minRTT) {
+        double bandwidth = (double)(_delivered - packet.delivered) * USECS_PER_SECOND / interval;
+
+        // app limited samples are only below the bottleneck bandwidth, unless they are above our estimate
+        if (!packet.isAppLimited || bandwidth >= _bottleneckBandwidth) {
+            auto& roundMax = _roundMaxBandwidths[_roundCount % BANDWIDTH_FILTER_ROUNDS];
+            roundMax = std::max(roundMax, bandwidth);
+        }
+    }
+
+    _bottleneckBandwidth = *std::max_element(_roundMaxBandwidths.begin(), _roundMaxBandwidths.end());
+}
+
+void BBRCC::updateMode(TimePoint now) {
+    if (_mode == Mode::Startup) {
+        if (_isRoundStart && !_isLastSampleAppLimited) {
+            if (_bottleneckBandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+                _fullBandwidth = _bottleneckBandwidth;
+                _fullBandwidthRounds = 0;
+            } else if (++_fullBandwidthRounds >= FULL_BANDWIDTH_ROUNDS) {
+                _isPipeFull = true;
+            }
+        }
+
+        // without selective ACKs every lost packet costs a round trip to recover,
+        // so we also stop at the first loss instead of overflowing the bottleneck queue
+        if (_hasLossInPhase) {
+            _isPipeFull = true;
+        }
+
+        if (_isPipeFull) {
+            _mode = Mode::Drain;
+            _pacingGain = DRAIN_GAIN;
+            _congestionWindowGain = HIGH_GAIN;
+        }
+    }
+
+    if (_mode == Mode::Drain && packetsInFlight() <= bandwidthDelayProduct(1.0)) {
+        enterProbeBW(now);
+    }
+
+    if (_mode == Mode::ProbeBW) {
+        bool isFullLength = duration_cast<microseconds>(now - _cycleStartTime).count() > _minRTT;
+        bool shouldAdvance;
+
+        if (_pacingGain > 1.0) {
+            // probe until there is more in flight or some of it is lost
+            shouldAdvance = isFullLength && (_hasLossInPhase || packetsInFlight() >= bandwidthDelayProduct(_pacingGain));
+        } else if (_pacingGain < 1.0) {
+            // drain until the queue from probing is gone
+            shouldAdvance = isFullLength || packetsInFlight() <= bandwidthDelayProduct(1.0);
+        } else {
+            shouldAdvance = isFullLength;
+        }
+
+        if (shouldAdvance) {
+            _cycleIndex = (_cycleIndex + 1) % GAIN_CYCLE_LENGTH;
+            _cycleStartTime = now;
+            _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+            _hasLossInPhase = false;
+        }
+    }
+
+    if (_mode != Mode::ProbeRTT && _isMinRTTExpired) {
+        // the min RTT has not been seen in a while, drain the queue so it can be
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _congestionWindowGain = 1.0;
+        _isProbeRTTTimed = false;
+        _priorCongestionWindowSize = _congestionWindowSize;
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        if (!_isProbeRTTTimed && packetsInFlight() <= MIN_CONGESTION_WINDOW) {
+            // the queue is drained, keep it so for a while and at least a round
+            _probeRTTDoneTime = now + PROBE_RTT_DURATION;
+            _probeRTTRoundDone = _roundCount + 1;
+            _isProbeRTTTimed = true;
+        } else if (_isProbeRTTTimed && now >= _probeRTTDoneTime && _roundCount >= _probeRTTRoundDone) {
+            _minRTTTime = now;
+            _congestionWindowSize = std::max(_congestionWindowSize, _priorCongestionWindowSize);
+
+            if (_isPipeFull) {
+                enterProbeBW(now);
+            } else {
+                _mode = Mode::Startup;
+                _pacingGain = HIGH_GAIN;
+                _congestionWindowGain = HIGH_GAIN;
+            }
+        }
+    }
+}
+
+void BBRCC::enterProbeBW(TimePoint now) {
+    _mode = Mode::ProbeBW;
+    _congestionWindowGain = PROBE_BW_CONGESTION_WINDOW_GAIN;
+
+    // start at a random phase, other than the one that drains
+    _cycleIndex = std::uniform_int_distribution<int>(0, GAIN_CYCLE_LENGTH - 2)(_random);
+    if (_cycleIndex >= 1) {
+        ++_cycleIndex;
+    }
+
+    _cycleStartTime = now;
+    _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+    _hasLossInPhase = false;
+}
+
+double BBRCC::bandwidthDelayProduct(double gain) const {
+    if (_bottleneckBandwidth <= 0.0 || _minRTT == std::numeric_limits<int>::max()) {
+        return gain * INITIAL_CONGESTION_WINDOW;
+    }
+
+    return gain * _bottleneckBandwidth * _minRTT / USECS_PER_SECOND;
+}
+
+void BBRCC::updateCongestionWindowAndPacingRate(int newlyACKed) {
+    if (_bottleneckBandwidth > 0.0) {
+        setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth));
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = MIN_CONGESTION_WINDOW;
+    } else {
+        int targetWindowSize = (int)bandwidthDelayProduct(_congestionWindowGain) + CONGESTION_WINDOW_QUANTA;
+
+        if (_isPipeFull) {
+            _congestionWindowSize = std::min(_congestionWindowSize + newlyACKed, targetWindowSize);
+        } else if (_congestionWindowSize < targetWindowSize || _delivered < INITIAL_CONGESTION_WINDOW) {
+            // grow with what is delivered while starting up, like slow start
+            _congestionWindowSize += newlyACKed;
+        }
+    }
+
+    _congestionWindowSize = std::max(std::min(_congestionWindowSize, udt::MAX_PACKETS_IN_FLIGHT), MIN_CONGESTION_WINDOW);
+}
@@ -0,0 +1,121 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <array>
+#include <random>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+#include "RingBuffer.h"
+
+namespace udt {
+
+// Congestion control from a model of the path, in the manner of BBR:
+// the bottleneck bandwidth is the max delivery rate over the last few rounds, and the propagation delay is
+// the min RTT over the last few seconds. It paces at the bottleneck bandwidth and keeps about twice their product
+// in flight, instead of backing off on delay (Vegas) or loss (Reno), which keeps long fat paths full.
+//
+// It asks for the same ACK per packet as TCPVegasCC, so either can run against the other.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) override { _hasLossInPhase = true; }
+    virtual void onTimeout() override;
+
+    virtual bool shouldNAK() override { return false; }
+    virtual bool shouldACK2() override { return false; }
+    virtual bool shouldProbe() override { return false; }
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override;
+
+private:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    enum class Mode {
+        Startup, // doubling the rate each round until the bandwidth stops growing
+        Drain, // draining the queue built up in startup
+        ProbeBW, // cycling the rate around the bottleneck bandwidth
+        ProbeRTT // sending little for a moment, to see the propagation delay again
+    };
+
+    struct SentPacket {
+        TimePoint sendTime;
+        TimePoint deliveredTime; // _deliveredTime when it was sent
+        int64_t delivered { 0 }; // _delivered when it was sent
+        bool isSent { false };
+        bool isRetransmitted { false };
+        bool isAppLimited { false };
+    };
+
+    void updateRTT(const SentPacket& packet, TimePoint now);
+    void updateBandwidth(const SentPacket& packet, TimePoint now);
+    void updateMode(TimePoint now);
+    void enterProbeBW(TimePoint now);
+    void updateCongestionWindowAndPacingRate(int newlyACKed);
+
+    int packetsInFlight() const { return (int)_sentPackets.size(); }
+    double bandwidthDelayProduct(double gain) const;
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    // indexed from _firstSentSequenceNumber, up to the last packet sent
+    RingBuffer<SentPacket> _sentPackets;
+    SequenceNumber _firstSentSequenceNumber;
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+    TimePoint _lastSendTime;
+
+    int64_t _delivered { 0 }; // Packets delivered over the connection
+    TimePoint _deliveredTime; // When _delivered last changed
+    int64_t _appLimitedUntil { 0 }; // Samples of packets sent before this much was delivered are app limited
+
+    int64_t _roundCount { 0 }; // Round trips since the start, a round ends when a packet sent in it is ACKed
+    int64_t _nextRoundDelivered { 0 };
+    bool _isRoundStart { false };
+    bool _isLastSampleAppLimited { false };
+
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _roundMaxBandwidths; // Max delivery rate per round, packets per second
+    double _bottleneckBandwidth { 0.0 }; // Max of _roundMaxBandwidths
+
+    int _minRTT; // Min RTT during the filter window, in microseconds
+    TimePoint _minRTTTime; // When _minRTT was sampled
+    bool _isMinRTTExpired { false };
+    int _ewmaRTT { -1 }; // Exponential weighted moving average RTT
+    int _rttVariance { 0 }; // Variance in collected RTT values
+
+    bool _isPipeFull { false };
+    double _fullBandwidth { 0.0 }; // Bandwidth when it last grew enough in startup
+    int _fullBandwidthRounds { 0 }; // Rounds since then
+
+    int _cycleIndex { 0 }; // Phase in the ProbeBW gain cycle
+    TimePoint _cycleStartTime;
+    bool _hasLossInPhase { false };
+
+    TimePoint _probeRTTDoneTime;
+    bool _isProbeRTTTimed { false };
+    int64_t _probeRTTRoundDone { 0 };
+    int _priorCongestionWindowSize { 0 }; // Restored when leaving ProbeRTT
+
+    std::mt19937 _random;
+};
+
+}
+
+#endif // hifi_BBRCC_h
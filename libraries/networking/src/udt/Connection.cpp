@@ -11,8 +11,6 @@
 
 #include "Connection.h"
 
-#include <QtCore/QThread>
-
 #include <NumericalConstants.h>
 
 #include "../HifiSockAddr.h"
@@ -72,21 +70,13 @@ Connection::~Connection() {
 }
 
 void Connection::stopSendQueue() {
-    if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
-        // tell the send queue to stop and be deleted
-        
-        sendQueue->stop();
-        sendQueue->deleteLater();
+    if (_sendQueue) {
+        // tell the send queue to stop and delete it, which waits if the scheduler is processing it
+        _sendQueue->stop();
+        _sendQueue.reset();
         
         // since we're stopping the send queue we should consider our handshake ACK not receieved
         _hasReceivedHandshakeACK = false;
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
@@ -732,38 +722,34 @@ void Connection::processACK2(ControlPacketPointer controlPacket) {
     SequenceNumber subSequenceNumber;
     controlPacket->readPrimitive(&subSequenceNumber);
 
-    // check if we had that subsequence number in our map
-    auto it = std::find_if_not(_sentACKs.begin(), _sentACKs.end(), [&subSequenceNumber](const ACKListPair& pair){
-        return pair.first < subSequenceNumber;
-    });
-    
-    if (it != _sentACKs.end()) {
-        if (it->first == subSequenceNumber){
-            // update the RTT using the ACK window
-            
-            // calculate the RTT (time now - time ACK sent)
-            auto now = p_high_resolution_clock::now();
-            int rtt = duration_cast<microseconds>(now - it->second.second).count();
-            
-            updateRTT(rtt);
-            // write this RTT to stats
-            _stats.recordRTT(rtt);
-            
-            // set the RTT for congestion control
-            _congestionControl->setRTT(_rtt);
-            
-            // update the last ACKed ACK
-            if (it->second.first > _lastReceivedAcknowledgedACK) {
-                _lastReceivedAcknowledgedACK = it->second.first;
-            }
-        } else if (it->first < subSequenceNumber) {
-            Q_UNREACHABLE();
+    // erase anything below this sub-sequence number, we'll never get timing information for those
+    while (!_sentACKs.empty() && _sentACKs.front().first < subSequenceNumber) {
+        _sentACKs.pop_front();
+    }
+
+    // check if we had that subsequence number in our list
+    if (!_sentACKs.empty() && _sentACKs.front().first == subSequenceNumber) {
+        auto& sentACK = _sentACKs.front();
+
+        // update the RTT using the ACK window
+        
+        // calculate the RTT (time now - time ACK sent)
+        auto now = p_high_resolution_clock::now();
+        int rtt = duration_cast<microseconds>(now - sentACK.second.second).count();
+        
+        updateRTT(rtt);
+        // write this RTT to stats
+        _stats.recordRTT(rtt);
+        
+        // set the RTT for congestion control
+        _congestionControl->setRTT(_rtt);
+        
+        // update the last ACKed ACK
+        if (sentACK.second.first > _lastReceivedAcknowledgedACK) {
+            _lastReceivedAcknowledgedACK = sentACK.second.first;
         }
     }
     
-    // erase this sub-sequence number and anything below it now that we've gotten our timing information
-    _sentACKs.erase(_sentACKs.begin(), it);
-    
     _stats.record(ConnectionStats::Stats::ReceivedACK2);
 }
 
@@ -959,28 +945,42 @@ void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
         _numPackets = packet->getMessagePartNumber() + 1;
     }
 
-    // Insert into the packets list in sorted order. Because we generally expect to receive packets in order, begin
-    // searching from the end of the list.
+    // Place the packet by part number, we generally expect to receive packets in order
     auto messagePartNumber = packet->getMessagePartNumber();
-    auto it = std::find_if(_packets.rbegin(), _packets.rend(),
-        [&](const std::unique_ptr<Packet>& value) { return messagePartNumber >= value->getMessagePartNumber(); });
+    if (messagePartNumber < _nextPartNumber) {
+        qCDebug(networking) << "PendingReceivedMessage::enqueuePacket: This is a duplicate packet";
+        return;
+    }
+
+    // the parts being received are all within the flow window
+    size_t index = messagePartNumber - _nextPartNumber;
+    if (index >= (size_t)MAX_PACKETS_IN_FLIGHT) {
+        qCDebug(networking) << "PendingReceivedMessage::enqueuePacket: Message part number" << messagePartNumber
+            << "is too far ahead of" << _nextPartNumber;
+        return;
+    }
+
+    while (_packets.size() <= index) {
+        _packets.push_back(std::unique_ptr<Packet>());
+    }
 
-    if (it != _packets.rend() && ((*it)->getMessagePartNumber() == messagePartNumber)) {
+    if (_packets[index]) {
         qCDebug(networking) << "PendingReceivedMessage::enqueuePacket: This is a duplicate packet";
         return;
     }
     
-    _packets.insert(it.base(), std::move(packet));
+    _packets[index] = std::move(packet);
+    ++_numBufferedPackets;
 }
 
 bool PendingReceivedMessage::hasAvailablePackets() const {
-    return _packets.size() > 0
-        && _nextPartNumber == _packets.front()->getMessagePartNumber();
+    return !_packets.empty() && _packets.front();
 }
 
 std::unique_ptr<Packet> PendingReceivedMessage::removeNextPacket() {
     if (hasAvailablePackets()) {
         _nextPartNumber++;
+        --_numBufferedPackets;
         auto p = std::move(_packets.front());
         _packets.pop_front();
         return p;
@@ -12,7 +12,6 @@
 #ifndef hifi_Connection_h
 #define hifi_Connection_h
 
-#include <list>
 #include <memory>
 
 #include <QtCore/QObject>
@@ -23,6 +22,7 @@
 #include "Constants.h"
 #include "LossList.h"
 #include "PacketTimeWindow.h"
+#include "RingBuffer.h"
 #include "SendQueue.h"
 #include "../HifiSockAddr.h"
 
@@ -37,16 +37,17 @@ class Socket;
 class PendingReceivedMessage {
 public:
     void enqueuePacket(std::unique_ptr<Packet> packet);
-    bool isComplete() const { return _hasLastPacket && _numPackets == _packets.size(); }
+    bool isComplete() const { return _hasLastPacket && _numPackets == _numBufferedPackets; }
     bool hasAvailablePackets() const;
     std::unique_ptr<Packet> removeNextPacket();
-    
-    std::list<std::unique_ptr<Packet>> _packets;
 
 private:
+    RingBuffer<std::unique_ptr<Packet>> _packets; // indexed by message part number from _nextPartNumber, null if missing
+
     bool _hasLastPacket { false };
     Packet::MessagePartNumber _nextPartNumber = 0;
     unsigned int _numPackets { 0 };
+    unsigned int _numBufferedPackets { 0 };
 };
 
 class Connection : public QObject {
@@ -54,7 +55,7 @@ class Connection : public QObject {
 public:
     using SequenceNumberTimePair = std::pair<SequenceNumber, p_high_resolution_clock::time_point>;
     using ACKListPair = std::pair<SequenceNumber, SequenceNumberTimePair>;
-    using SentACKList = std::list<ACKListPair>;
+    using SentACKList = RingBuffer<ACKListPair>;
     using ControlPacketPointer = std::unique_ptr<ControlPacket>;
     
     Connection(Socket* parentSocket, HifiSockAddr destination, std::unique_ptr<CongestionControl> congestionControl);
@@ -161,7 +162,7 @@ private:
     int _bandwidth { 1 }; // Exponential moving average for estimated bandwidth, in packets per second
     int _deliveryRate { 16 }; // Exponential moving average for receiver's receive rate, in packets per second
     
-    SentACKList _sentACKs; // Map of ACK sub-sequence numbers to ACKed sequence number and sent time
+    SentACKList _sentACKs; // ACK sub-sequence numbers, in order, to ACKed sequence number and sent time
     
     Socket* _parentSocket { nullptr };
     HifiSockAddr _destination;
@@ -43,64 +43,78 @@ void LossList::append(SequenceNumber start, SequenceNumber end) {
     _length += seqlen(start, end);
 }
 
+size_t LossList::findRange(SequenceNumber seq) const {
+    // binary search, the ranges are sorted
+    size_t first = 0;
+    size_t count = _lossList.size();
+    while (count > 0) {
+        size_t step = count / 2;
+        if (_lossList[first + step].second < seq) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
 void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    size_t index = findRange(start);
     
-    if (it == _lossList.end() || end < it->first) {
+    if (index == _lossList.size() || end < _lossList[index].first) {
         // No overlap, simply insert
         _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
+        _lossList.insert(index, make_pair(start, end));
     } else {
+        auto& range = _lossList[index];
+
         // If it starts before segment, extend segment
-        if (start < it->first) {
-            _length += seqlen(start, it->first - 1);
-            it->first = start;
+        if (start < range.first) {
+            _length += seqlen(start, range.first - 1);
+            range.first = start;
         }
         
         // If it ends after segment, extend segment
-        if (end > it->second) {
-            _length += seqlen(it->second + 1, end);
-            it->second = end;
+        if (end > range.second) {
+            _length += seqlen(range.second + 1, end);
+            range.second = end;
         }
         
-        auto it2 = it;
-        ++it2;
         // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
+        size_t next = index + 1;
+        while (next < _lossList.size() && _lossList[index].second >= _lossList[next].first - 1) {
             // extend current range if necessary
-            if (it->second < it2->second) {
-                _length += seqlen(it->second + 1, it2->second);
-                it->second = it2->second;
+            if (_lossList[index].second < _lossList[next].second) {
+                _length += seqlen(_lossList[index].second + 1, _lossList[next].second);
+                _lossList[index].second = _lossList[next].second;
             }
             
             // Remove overlapping range
-            _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+            _length -= seqlen(_lossList[next].first, _lossList[next].second);
+            _lossList.erase(next);
         }
     }
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    size_t index = findRange(seq);
     
-    if (it != end(_lossList)) {
-        if (it->first == it->second) {
-            _lossList.erase(it);
-        } else if (seq == it->first) {
-            ++it->first;
-        } else if (seq == it->second) {
-            --it->second;
+    if (index < _lossList.size() && _lossList[index].first <= seq) {
+        auto& range = _lossList[index];
+        if (range.first == range.second) {
+            _lossList.erase(index);
+        } else if (seq == range.first) {
+            ++range.first;
+        } else if (seq == range.second) {
+            --range.second;
         } else {
-            auto temp = it->second;
-            it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
+            auto temp = range.second;
+            range.second = seq - 1;
+            _lossList.insert(index + 1, make_pair(seq + 1, temp));
         }
         _length -= 1;
         
@@ -116,41 +130,41 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
+    size_t index = findRange(start);
     
     // If we found one
-    if (it != _lossList.end()) {
+    if (index < _lossList.size() && _lossList[index].first <= end) {
         
         // While the end of the current segment is contained, either shorten it (first one only - sometimes)
         // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
+        while (index < _lossList.size() && end >= _lossList[index].second) {
+            auto& range = _lossList[index];
+            if (start <= range.first) {
                 // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
+                _length -= seqlen(range.first, range.second);
+                _lossList.erase(index);
             } else {
                 // Beginning of segment not contained, modify end of segment.
                 // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
+                _length -= seqlen(start, range.second);
+                range.second = start - 1;
+                ++index;
             }
         }
         
         // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
+        if (index < _lossList.size() && _lossList[index].first <= end) {
+            auto& range = _lossList[index];
+            if (start <= range.first) {
                 // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
+                _length -= seqlen(range.first, end);
+                range.first = end + 1;
             } else {
                 // Cut it in half if the range we are removing is contained within one segment
                 _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
+                auto temp = range.second;
+                range.second = start - 1;
+                _lossList.insert(index + 1, make_pair(end + 1, temp));
             }
         }
     }
@@ -170,9 +184,9 @@ SequenceNumber LossList::popFirstSequenceNumber() {
 void LossList::write(ControlPacket& packet, int maxPairs) {
     int writtenPairs = 0;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+    for (size_t i = 0; i < _lossList.size(); ++i) {
+        packet.writePrimitive(_lossList[i].first);
+        packet.writePrimitive(_lossList[i].second);
         
         ++writtenPairs;
         
@@ -12,8 +12,7 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
-
+#include "RingBuffer.h"
 #include "SequenceNumber.h"
 
 namespace udt {
@@ -30,7 +29,7 @@ public:
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere - slower, shifts the following ranges
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -44,7 +43,13 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    using Range = std::pair<SequenceNumber, SequenceNumber>;
+
+    // index of the first range ending at or after seq
+    size_t findRange(SequenceNumber seq) const;
+
+    RingBuffer<Range> _lossList; // sorted, non overlapping ranges
+
     int _length { 0 };
 };
     
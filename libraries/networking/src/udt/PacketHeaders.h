@@ -106,13 +106,19 @@ public:
         ViewFrustum,
         RequestsDomainListData,
         ExitingSpaceBubble,
-        LAST_PACKET_TYPE = ExitingSpaceBubble
+        HostedAvatarData,
+        LAST_PACKET_TYPE = HostedAvatarData
     };
 };
 
 using PacketType = PacketTypeEnum::Value;
 
-const int NUM_BYTES_MD5_HASH = 16;
+const int NUM_BYTES_VERIFICATION_HASH = 16;
+
+// How sourced packets are verified: 1 was an MD5 of the payload and the connection secret,
+// 2 is a SipHash-2-4 of the payload keyed with the connection secret (see PacketVerificationKey).
+// It is part of the protocol signature, so that nodes verifying differently are refused by the domain-server.
+const uint8_t PACKET_VERIFICATION_VERSION = 2;
 
 typedef char PacketVersion;
 
@@ -210,7 +216,8 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     HandControllerJoints,
     HasKillAvatarReason,
     SessionDisplayName,
-    Unignore
+    Unignore,
+    HostedAvatars
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -236,7 +243,13 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    ListEpochDeltas
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreListEpoch = 17,
+    HasListEpoch
 };
 
 enum class AudioVersion : PacketVersion {
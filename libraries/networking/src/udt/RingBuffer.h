@@ -0,0 +1,126 @@
+//
+//  RingBuffer.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RingBuffer_h
+#define hifi_RingBuffer_h
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+namespace udt {
+
+// Double ended queue in one contiguous circular array, that only allocates when it outgrows it.
+// Used for the sequence ordered state of connections (loss lists, sent packets, ACK times),
+// where std::list costs an allocation and a likely cache miss per element.
+template <typename T>
+class RingBuffer {
+public:
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    T& operator[](size_t index) { Q_ASSERT(index < _size); return _data[(_head + index) & _mask]; }
+    const T& operator[](size_t index) const { Q_ASSERT(index < _size); return _data[(_head + index) & _mask]; }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[_size - 1]; }
+    const T& back() const { return (*this)[_size - 1]; }
+
+    void push_back(T value) {
+        reserve(_size + 1);
+        _data[(_head + _size) & _mask] = std::move(value);
+        ++_size;
+    }
+
+    void pop_front() {
+        Q_ASSERT(_size > 0);
+        _data[_head] = T(); // release what the element holds now, not when the slot is reused
+        _head = (_head + 1) & _mask;
+        --_size;
+    }
+
+    void pop_back() {
+        Q_ASSERT(_size > 0);
+        --_size;
+        _data[(_head + _size) & _mask] = T();
+    }
+
+    // shifts the following elements up
+    void insert(size_t index, T value) {
+        Q_ASSERT(index <= _size);
+        reserve(_size + 1);
+        ++_size;
+        for (size_t i = _size - 1; i > index; --i) {
+            (*this)[i] = std::move((*this)[i - 1]);
+        }
+        (*this)[index] = std::move(value);
+    }
+
+    // shifts the elements on the shorter side
+    void erase(size_t index) {
+        Q_ASSERT(index < _size);
+        if (index < _size / 2) {
+            for (size_t i = index; i > 0; --i) {
+                (*this)[i] = std::move((*this)[i - 1]);
+            }
+            pop_front();
+        } else {
+            for (size_t i = index + 1; i < _size; ++i) {
+                (*this)[i - 1] = std::move((*this)[i]);
+            }
+            pop_back();
+        }
+    }
+
+    void clear() {
+        while (_size > 0) {
+            pop_back();
+        }
+        _head = 0;
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity <= _data.size()) {
+            return;
+        }
+
+        size_t newCapacity = _data.size();
+        if (newCapacity == 0) {
+            newCapacity = MIN_CAPACITY;
+        }
+        while (newCapacity < capacity) {
+            newCapacity *= 2;
+        }
+
+        std::vector<T> data(newCapacity);
+        for (size_t i = 0; i < _size; ++i) {
+            data[i] = std::move((*this)[i]);
+        }
+        _data.swap(data);
+        _head = 0;
+        _mask = newCapacity - 1;
+    }
+
+private:
+    static const size_t MIN_CAPACITY = 16;
+
+    std::vector<T> _data;
+    size_t _head { 0 };
+    size_t _size { 0 };
+    size_t _mask { 0 };
+};
+
+}
+
+#endif // hifi_RingBuffer_h
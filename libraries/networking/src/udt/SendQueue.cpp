@@ -13,12 +13,8 @@
 
 #include <algorithm>
 #include <random>
-#include <thread>
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
-#include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -28,7 +24,6 @@
 #include "ControlPacket.h"
 #include "Packet.h"
 #include "PacketList.h"
-#include "../UserActivityLogger.h"
 #include "Socket.h"
 #include <Trace.h>
 #include <Profile.h>
@@ -67,25 +62,15 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination));
 
-    // Setup queue private thread
-    QThread* thread = new QThread;
-    thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
-    
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-    
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-    
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-    
-    thread->start();
+    // the scheduler starts with the handshake right away
+    socket->getSendScheduler().add(queue.get());
     
     return queue;
 }
     
 SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
     _socket(socket),
+    _scheduler(socket->getSendScheduler()),
     _destination(dest)
 {
     PROFILE_ASYNC_BEGIN(network, "SendQueue", _destination.toString());
@@ -108,38 +93,32 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
 }
 
 SendQueue::~SendQueue() {
+    // waits if the scheduler is processing the queue
+    _scheduler.remove(this);
+
     PROFILE_ASYNC_END(network, "SendQueue", _destination.toString());
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
-        this->thread()->start();
-    }
+    // wake the queue in case it is waiting for packets
+    notifyActivity();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
-        this->thread()->start();
-    }
+    // wake the queue in case it is waiting for packets
+    notifyActivity();
 }
 
 void SendQueue::stop() {
     
     _state = State::Stopped;
     
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting, so that the scheduler drops it
+    notifyActivity();
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -155,10 +134,11 @@ void SendQueue::ack(SequenceNumber ack) {
     }
     
     {
-        // remove any ACKed packets from the map of sent packets
+        // remove any ACKed packets from the front of the sent packets
         QWriteLocker locker(&_sentLock);
-        for (auto seq = SequenceNumber { (uint32_t) _lastACKSequenceNumber }; seq <= ack; ++seq) {
-            _sentPackets.erase(seq);
+        while (!_sentPackets.empty() && _firstSentSequenceNumber <= ack) {
+            _sentPackets.pop_front();
+            ++_firstSentSequenceNumber;
         }
     }
     
@@ -172,8 +152,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting with a full congestion window
+    notifyActivity();
 }
 
 void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
@@ -185,8 +165,8 @@ void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
         _naks.insert(start, end);
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -195,8 +175,8 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
@@ -220,36 +200,26 @@ void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
         }
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        PROFILE_ASYNC_BEGIN(network, "SendQueue:Handshake", _destination.toString());
+    // we haven't received a handshake ACK from the client, send another now
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    PROFILE_ASYNC_BEGIN(network, "SendQueue:Handshake", _destination.toString());
 
-        handshakePacket->writePrimitive(_initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
-    }
+    handshakePacket->writePrimitive(_initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
 }
 
 void SendQueue::handshakeACK(SequenceNumber initialSequenceNumber) {
     if (initialSequenceNumber == _initialSequenceNumber) {
-        {
-            std::lock_guard<std::mutex> locker { _handshakeMutex };
-            _hasReceivedHandshakeACK = true;
-        }
+        _hasReceivedHandshakeACK = true;
         PROFILE_ASYNC_END(network, "SendQueue:Handshake", _destination.toString());
 
-        // Notify on the handshake ACK condition
-        _handshakeACKCondition.notify_one();
+        // wake the queue, that is waiting for the handshake ACK
+        notifyActivity();
     }
 }
 
@@ -271,11 +241,20 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     emit packetSent(packetSize, payloadSize, sequenceNumber, p_high_resolution_clock::now());
 
     {
-        // Insert the packet we have just sent in the sent list
+        // Insert the packet we have just sent in the sent list, sequence numbers only go up
         QWriteLocker locker(&_sentLock);
-        auto& entry = _sentPackets[newPacket->getSequenceNumber()];
-        entry.first = 0; // No resend
-        entry.second.swap(newPacket);
+        if (_sentPackets.empty()) {
+            _firstSentSequenceNumber = sequenceNumber;
+        }
+        int offset = seqoff(_firstSentSequenceNumber, sequenceNumber);
+        Q_ASSERT_X(offset >= (int)_sentPackets.size(), "SendQueue::sendNewPacketAndAddToSentList()",
+                   "Sequence number lower than the last one sent");
+        while ((int)_sentPackets.size() < offset) {
+            _sentPackets.push_back(PacketResendPair());
+        }
+        if ((int)_sentPackets.size() == offset) {
+            _sentPackets.push_back(PacketResendPair(0, std::move(newPacket))); // No resend
+        }
     }
     Q_ASSERT_X(!newPacket, "SendQueue::sendNewPacketAndAddToSentList()", "Overriden packet in sent list");
 
@@ -296,113 +275,76 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
+SendScheduler::Wakeup SendQueue::process(TimePoint now) {
     if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
+        // we've been asked to stop, possibly before we even got a chance to start
+        return { now, true };
     }
     
-    _state = State::Running;
+    auto notStarted = State::NotStarted;
+    _state.compare_exchange_strong(notStarted, State::Running);
     
     // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeTimestamp) {
+            sendHandshake();
 
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+            static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+            _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
+        }
+
+        // we wait for the ACK or the re-send interval to expire
+        // no packets will be sent until the handshake ACK has been received
+        _nextPacketTimestamp = now;
+        return { _nextHandshakeTimestamp, true };
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    if (_wait != Wait::None) {
+        finishWait(now);
 
-    while (_state == State::Running) {
-        bool attemptedToSendPacket = maybeResendPacket();
-        
-        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
-        // (this is according to the current flow window size) then we send out a new packet
-        auto newPacketCount = 0;
-        if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
-            attemptedToSendPacket = (newPacketCount > 0);
-        }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+        if (_state != State::Running) {
+            return { now, true };
         }
+    }
 
-        if (_packetSendPeriod > 0) {
-            // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
-
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
-
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
+    bool attemptedToSendPacket = maybeResendPacket();
+    
+    // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+    // (this is according to the current flow window size) then we send out a new packet
+    auto newPacketCount = 0;
+    if (!attemptedToSendPacket) {
+        newPacketCount = maybeSendNewPacket();
+        attemptedToSendPacket = (newPacketCount > 0);
+    }
+    
+    // check now if we were just told to stop, or if the send queue has become inactive
+    // Either _state will have been set to Stopped and the scheduler drops us
+    // Or we will wait for activity
+    if (_state != State::Running || isInactive(attemptedToSendPacket, now)) {
+        return { now, true };
+    }
 
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+    if (_wait != Wait::None) {
+        return { _waitDeadline, true };
+    }
 
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
-            }
+    if (_packetSendPeriod > 0) {
+        // push the next packet timestamp forwards by the current packet send period
+        auto nextPacketDelta = std::chrono::microseconds((newPacketCount == 2 ? 2 : 1) * _packetSendPeriod);
+        _nextPacketTimestamp += nextPacketDelta;
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-                // alright, we're in a weird state
-                // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-                static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-                // setup a json object with the details we want
-                QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-                longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-                longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-                // hopefully send this event using the user activity logger
-                UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
-            }
-            
-            std::this_thread::sleep_for(timeToSleep);
+        // we use _nextPacketTimestamp so that we don't fall behind, not to force long waits
+        // we'll never allow _nextPacketTimestamp to force us to wait for more than nextPacketDelta
+        // so cap it to that value
+        if (_nextPacketTimestamp - now > nextPacketDelta) {
+            _nextPacketTimestamp = now + nextPacketDelta;
         }
+
+        return { _nextPacketTimestamp, false };
     }
+
+    _nextPacketTimestamp = now;
+    return { now, false };
 }
 
 void SendQueue::setProbePacketEnabled(bool enabled) {
@@ -458,6 +400,18 @@ int SendQueue::maybeSendNewPacket() {
     return 0;
 }
 
+SendQueue::PacketResendPair* SendQueue::findSentPacket(SequenceNumber sequenceNumber) {
+    if (_sentPackets.empty()) {
+        return nullptr;
+    }
+
+    int offset = seqoff(_firstSentSequenceNumber, sequenceNumber);
+    if (offset < 0 || offset >= (int)_sentPackets.size() || !_sentPackets[offset].second) {
+        return nullptr;
+    }
+    return &_sentPackets[offset];
+}
+
 bool SendQueue::maybeResendPacket() {
     
     // the following while makes sure that we find a packet to re-send, if there is one
@@ -474,11 +428,11 @@ bool SendQueue::maybeResendPacket() {
             QReadLocker sentLocker(&_sentLock);
             
             // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
+            auto sentPacket = findSentPacket(resendNumber);
 
-            if (it != _sentPackets.end()) {
+            if (sentPacket) {
 
-                auto& entry = it->second;
+                auto& entry = *sentPacket;
                 // we found the packet - grab it
                 auto& resendPacket = *(entry.second);
                 ++entry.first; // Add 1 resend
@@ -519,7 +473,7 @@ bool SendQueue::maybeResendPacket() {
                     sentLocker.unlock();
                 }
                 
-                emit packetRetransmitted(resendPacket.getWireSize(), it->first, p_high_resolution_clock::now());
+                emit packetRetransmitted(resendPacket.getWireSize(), resendNumber, p_high_resolution_clock::now());
                 
                 // Signal that we did resend a packet
                 return true;
@@ -538,7 +492,7 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
+bool SendQueue::isInactive(bool attemptedToSendPacket, TimePoint now) {
     // check for connection timeout first
 
     // that will be the case if we have had 16 timeouts since hearing back from the client, and it has been
@@ -566,8 +520,9 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
     if (!attemptedToSendPacket) {
         // During our processing above we didn't send any packets
         
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
+        // If that is still the case we should wait until we have data to handle.
+        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock.
+        // Anything queued after we let go of it wakes us through the scheduler.
         using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
         DoubleLock doubleLock(_packets.getLock(), _naksLock);
         DoubleLock::Lock locker(doubleLock, std::try_to_lock);
@@ -580,47 +535,14 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
                 // either wait for new data to send or 5 seconds before cleaning up the queue
                 static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
                 
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-#ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
-#endif
-
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
-
+                _wait = Wait::Empty;
+                _waitDeadline = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
             } else {
                 // We think the client is still waiting for data (based on the sequence number gap)
                 // Let's wait either for a response from the client or until the estimated timeout
                 // (plus the sync interval to allow the client to respond) has elapsed
-                auto waitDuration = std::chrono::microseconds(_estimatedTimeout + _syncInterval);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, waitDuration);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
+                _wait = Wait::Timeout;
+                _waitDeadline = now + std::chrono::microseconds(_estimatedTimeout + _syncInterval);
             }
         }
     }
@@ -628,8 +550,54 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
     return false;
 }
 
+void SendQueue::finishWait(TimePoint now) {
+    auto wait = _wait;
+    _wait = Wait::None;
+
+    // pace from now, rather than catching up on the time spent waiting
+    _nextPacketTimestamp = now;
+
+    if (now < _waitDeadline) {
+        // we were woken up by activity
+        return;
+    }
+
+    using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
+    DoubleLock doubleLock(_packets.getLock(), _naksLock);
+    DoubleLock::Lock locker(doubleLock);
+
+    if (!((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty())) {
+        return;
+    }
+
+    if (wait == Wait::Empty) {
+#ifdef UDT_CONNECTION_DEBUG
+        qCDebug(networking) << "SendQueue to" << _destination << "has been empty for 5 seconds"
+            << "and receiver has ACKed all packets."
+            << "The queue is now inactive and will be stopped.";
+#endif
+
+        // we have the lock - Make sure to unlock it
+        locker.unlock();
+
+        // Deactivate queue
+        deactivate();
+    } else if (SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+
+        // Note that thanks to the DoubleLock we have the _naksLock right now
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+
+        // time to unlock
+        locker.unlock();
+
+        emit timeout();
+    }
+}
+
 void SendQueue::deactivate() {
-    // this queue is inactive - emit that signal and stop the while
+    // this queue is inactive - emit that signal and stop
     emit queueInactive();
     
     _state = State::Stopped;
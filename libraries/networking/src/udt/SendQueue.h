@@ -13,12 +13,10 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
 #include <QtCore/QReadWriteLock>
@@ -31,6 +29,8 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "RingBuffer.h"
+#include "SendScheduler.h"
 
 namespace udt {
     
@@ -40,7 +40,7 @@ class Packet;
 class PacketList;
 class Socket;
     
-class SendQueue : public QObject {
+class SendQueue : public QObject, public SendScheduler::Queue {
     Q_OBJECT
     
 public:
@@ -50,6 +50,7 @@ public:
         Stopped
     };
     
+    // the queue is run by the socket's SendScheduler
     static std::unique_ptr<SendQueue> create(Socket* socket, HifiSockAddr destination);
 
     virtual ~SendQueue();
@@ -68,6 +69,8 @@ public:
     void setSyncInterval(int syncInterval) { _syncInterval = syncInterval; }
 
     void setProbePacketEnabled(bool enabled);
+
+    bool isStopped() const override { return _state == State::Stopped; }
     
 public slots:
     void stop();
@@ -87,13 +90,24 @@ signals:
     void shortCircuitLoss(quint32 sequenceNumber);
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    using TimePoint = p_high_resolution_clock::time_point;
+    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
+
+    // What the queue waits on when it has nothing to send
+    enum class Wait {
+        None,
+        Empty, // everything sent was ACKed, for new packets or the inactivity timeout
+        Timeout // for ACKs of what was sent, or the estimated timeout
+    };
+
     SendQueue(Socket* socket, HifiSockAddr dest);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
+
+    // Sends what is due now, called by the scheduler - returns when to call it next
+    SendScheduler::Wakeup process(TimePoint now) override;
+    void notifyActivity() { _scheduler.wake(this); }
     
     void sendHandshake();
     
@@ -103,10 +117,14 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    bool isInactive(bool attemptedToSendPacket, TimePoint now); // may start a wait
+    void finishWait(TimePoint now);
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
+
+    // The sent packet for this sequence number, if it still waits for an ACK - called with the sent lock held
+    PacketResendPair* findSentPacket(SequenceNumber sequenceNumber);
     
     // Increments current sequence number and return it
     SequenceNumber getNextSequenceNumber();
@@ -114,6 +132,7 @@ private:
     PacketQueue _packets;
     
     Socket* _socket { nullptr }; // Socket to send packet on
+    SendScheduler& _scheduler;
     HifiSockAddr _destination; // Destination addr
 
     SequenceNumber _initialSequenceNumber; // Randomized on SendQueue creation, identifies connection during re-connect requests
@@ -136,15 +155,16 @@ private:
     LossList _naks; // Sequence numbers of packets to resend
     
     mutable QReadWriteLock _sentLock; // Protects the sent packet list
-    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    RingBuffer<PacketResendPair> _sentPackets; // Packets waiting for ACK, indexed from _firstSentSequenceNumber
+    SequenceNumber _firstSentSequenceNumber; // Sequence number of the front of _sentPackets
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
+    TimePoint _nextHandshakeTimestamp; // When to re-send the handshake if it is not ACKed
+
+    TimePoint _nextPacketTimestamp; // When the next packet should be sent, according to the send period
 
+    Wait _wait { Wait::None };
+    TimePoint _waitDeadline;
 
     std::atomic<bool> _shouldSendProbes { true };
 };
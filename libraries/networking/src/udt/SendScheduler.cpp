@@ -0,0 +1,370 @@
+//
+//  SendScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendScheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+
+#include <QtCore/QThread>
+
+using namespace udt;
+using namespace std::chrono;
+
+// the wheel runs on a steady clock, so that it does not stall when the wall clock is set back
+using Clock = steady_clock;
+
+static const microseconds TICK { 100 };
+static const uint64_t NUM_SLOTS = 1024; // about 100ms per turn of the wheel, longer waits stay for more turns
+
+// processing a queue sends at most one packet (or probe pair) - catch up on queues that are behind in a visit,
+// but go on to the next queue after a few
+static const int MAX_PROCESS_PER_VISIT = 16;
+
+// upper bounds of the lag histogram buckets, the last bucket is everything above
+static const int LAG_BUCKET_USECS[] = { 100, 250, 500, 1000, 2500, 5000, 10000, 50000 };
+static const size_t NUM_LAG_BOUNDS = sizeof(LAG_BUCKET_USECS) / sizeof(LAG_BUCKET_USECS[0]);
+using LagHistogram = std::array<quint64, NUM_LAG_BOUNDS + 1>;
+
+class SendScheduler::Worker : public QThread {
+public:
+    Worker(int index) : _index(index), _start(Clock::now()), _slots(NUM_SLOTS) {
+        setObjectName(QString("Networking: SendScheduler %1").arg(index));
+    }
+
+    void add(Queue* queue);
+    void remove(Queue* queue);
+    void wake(Queue* queue);
+    void stop();
+
+    int getNumQueues() const { return _numQueues; }
+    void takeLagStats(LagHistogram& histogram, quint64& maxLagUsecs);
+
+protected:
+    void run() override;
+
+private:
+    uint64_t tickFor(Clock::time_point time) const; // the tick a time falls in, for what is due by then
+    uint64_t tickAtOrAfter(Clock::time_point time) const; // the first tick not before a time, for when to wake
+    Clock::time_point timeFor(uint64_t tick) const { return _start + TICK * (qint64)tick; }
+
+    // called with the lock held
+    void schedule(Queue* queue, uint64_t tick);
+    void unschedule(Queue* queue);
+    void recordLag(microseconds lag);
+    bool findNextTick(uint64_t& nextTick) const;
+
+    const int _index;
+    const Clock::time_point _start;
+
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _processedCondition;
+    bool _isStopping { false };
+
+    std::vector<std::vector<Queue*>> _slots; // queues by tick, modulo the number of slots
+    uint64_t _currentTick { 0 }; // last tick drained
+    std::atomic<int> _numQueues { 0 };
+
+    LagHistogram _lagHistogram {{}};
+    quint64 _maxLagUsecs { 0 };
+};
+
+uint64_t SendScheduler::Worker::tickFor(Clock::time_point time) const {
+    if (time <= _start) {
+        return 0;
+    }
+    return (time - _start) / TICK;
+}
+
+uint64_t SendScheduler::Worker::tickAtOrAfter(Clock::time_point time) const {
+    if (time <= _start) {
+        return 0;
+    }
+    return (time - _start + TICK - Clock::duration(1)) / TICK;
+}
+
+void SendScheduler::Worker::schedule(Queue* queue, uint64_t tick) {
+    auto& entry = queue->_schedulerEntry;
+    entry.tick = std::max(tick, _currentTick);
+
+    auto& slot = _slots[entry.tick % NUM_SLOTS];
+    entry.slotIndex = slot.size();
+    entry.isScheduled = true;
+    slot.push_back(queue);
+}
+
+void SendScheduler::Worker::unschedule(Queue* queue) {
+    auto& entry = queue->_schedulerEntry;
+    auto& slot = _slots[entry.tick % NUM_SLOTS];
+
+    // swap in the last queue of the slot
+    auto last = slot.back();
+    slot[entry.slotIndex] = last;
+    last->_schedulerEntry.slotIndex = entry.slotIndex;
+    slot.pop_back();
+
+    entry.isScheduled = false;
+}
+
+void SendScheduler::Worker::add(Queue* queue) {
+    std::lock_guard<std::mutex> locker(_mutex);
+
+    auto& entry = queue->_schedulerEntry;
+    entry.worker = _index;
+    entry.deadline = Clock::time_point();
+    schedule(queue, _currentTick);
+    ++_numQueues;
+
+    _wakeCondition.notify_one();
+}
+
+void SendScheduler::Worker::remove(Queue* queue) {
+    std::unique_lock<std::mutex> locker(_mutex);
+
+    auto& entry = queue->_schedulerEntry;
+    _processedCondition.wait(locker, [&] { return !entry.isProcessing; });
+
+    if (entry.isScheduled) {
+        unschedule(queue);
+    }
+    entry.worker = -1;
+    --_numQueues;
+}
+
+void SendScheduler::Worker::wake(Queue* queue) {
+    std::lock_guard<std::mutex> locker(_mutex);
+
+    auto& entry = queue->_schedulerEntry;
+    if (entry.isScheduled && entry.wakesOnActivity) {
+        entry.wakesOnActivity = false;
+        entry.deadline = Clock::time_point();
+
+        unschedule(queue);
+        schedule(queue, _currentTick);
+        _wakeCondition.notify_one();
+    }
+}
+
+void SendScheduler::Worker::stop() {
+    {
+        std::lock_guard<std::mutex> locker(_mutex);
+        _isStopping = true;
+        _wakeCondition.notify_one();
+    }
+    wait();
+}
+
+void SendScheduler::Worker::recordLag(microseconds lag) {
+    quint64 lagUsecs = std::max((qint64)lag.count(), (qint64)0);
+
+    size_t bucket = 0;
+    while (bucket < NUM_LAG_BOUNDS && lagUsecs >= (quint64)LAG_BUCKET_USECS[bucket]) {
+        ++bucket;
+    }
+    ++_lagHistogram[bucket];
+    _maxLagUsecs = std::max(_maxLagUsecs, lagUsecs);
+}
+
+void SendScheduler::Worker::takeLagStats(LagHistogram& histogram, quint64& maxLagUsecs) {
+    std::lock_guard<std::mutex> locker(_mutex);
+
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        histogram[i] += _lagHistogram[i];
+        _lagHistogram[i] = 0;
+    }
+    maxLagUsecs = std::max(maxLagUsecs, _maxLagUsecs);
+    _maxLagUsecs = 0;
+}
+
+bool SendScheduler::Worker::findNextTick(uint64_t& nextTick) const {
+    // the first slot with a queue due in this turn of the wheel, or the earliest tick if all are due in later turns
+    bool hasQueue = false;
+    for (uint64_t tick = _currentTick; tick < _currentTick + NUM_SLOTS; ++tick) {
+        for (auto queue : _slots[tick % NUM_SLOTS]) {
+            auto queueTick = queue->_schedulerEntry.tick;
+            if (!hasQueue || queueTick < nextTick) {
+                nextTick = queueTick;
+                hasQueue = true;
+            }
+        }
+        if (hasQueue && nextTick == tick) {
+            break;
+        }
+    }
+    return hasQueue;
+}
+
+void SendScheduler::Worker::run() {
+    std::vector<Queue*> dueQueues;
+    std::vector<Clock::time_point> wakeupTimes;
+    std::vector<bool> wakeupsOnActivity;
+
+    std::unique_lock<std::mutex> locker(_mutex);
+
+    while (!_isStopping) {
+        auto now = Clock::now();
+        auto nowTick = tickFor(now);
+
+        // take the queues due by now - if we are more than a turn behind, one turn covers every slot
+        auto lastTick = std::min(nowTick, _currentTick + NUM_SLOTS - 1);
+        for (uint64_t tick = _currentTick; tick <= lastTick; ++tick) {
+            auto& slot = _slots[tick % NUM_SLOTS];
+            for (size_t i = 0; i < slot.size();) {
+                auto queue = slot[i];
+                auto& entry = queue->_schedulerEntry;
+                if (entry.tick > nowTick) {
+                    ++i;
+                    continue;
+                }
+
+                // the slot's last queue is swapped in at i
+                unschedule(queue);
+
+                if (entry.deadline != Clock::time_point()) {
+                    recordLag(duration_cast<microseconds>(now - entry.deadline));
+                }
+
+                entry.isProcessing = true;
+                entry.wakesOnActivity = false;
+                entry.hasActivity = false;
+                dueQueues.push_back(queue);
+            }
+        }
+        _currentTick = std::max(_currentTick, nowTick);
+
+        if (!dueQueues.empty()) {
+            locker.unlock();
+
+            for (auto queue : dueQueues) {
+                // the queues pace against the high resolution clock, convert their wakeups to the steady clock
+                auto queueNow = p_high_resolution_clock::now();
+                auto wakeup = queue->process(queueNow);
+
+                for (int i = 1; i < MAX_PROCESS_PER_VISIT && !wakeup.onActivity && wakeup.time <= queueNow
+                     && !queue->isStopped(); ++i) {
+                    wakeup = queue->process(queueNow);
+                }
+
+                wakeupTimes.push_back(Clock::now() + duration_cast<Clock::duration>(wakeup.time - queueNow));
+                wakeupsOnActivity.push_back(wakeup.onActivity);
+            }
+
+            locker.lock();
+
+            auto processedTick = tickFor(Clock::now());
+            for (size_t i = 0; i < dueQueues.size(); ++i) {
+                auto queue = dueQueues[i];
+                auto& entry = queue->_schedulerEntry;
+                entry.isProcessing = false;
+
+                if (queue->isStopped()) {
+                    // stays out of the wheel until its connection removes it
+                    continue;
+                }
+
+                entry.wakesOnActivity = wakeupsOnActivity[i];
+                if (wakeupsOnActivity[i] && entry.hasActivity.exchange(false)) {
+                    // activity came in while we were processing, which wake() could not reschedule
+                    entry.wakesOnActivity = false;
+                    entry.deadline = Clock::time_point();
+                    schedule(queue, _currentTick);
+                } else {
+                    entry.deadline = wakeupTimes[i];
+
+                    // queues still due go in the next tick, after the other due queues had their turn
+                    schedule(queue, std::max(tickAtOrAfter(wakeupTimes[i]), processedTick + 1));
+                }
+            }
+
+            dueQueues.clear();
+            wakeupTimes.clear();
+            wakeupsOnActivity.clear();
+            _processedCondition.notify_all();
+            continue;
+        }
+
+        uint64_t nextTick;
+        if (findNextTick(nextTick)) {
+            _wakeCondition.wait_until(locker, timeFor(nextTick));
+        } else {
+            _wakeCondition.wait(locker);
+        }
+    }
+}
+
+SendScheduler::SendScheduler(int numThreads) {
+    for (int i = 0; i < std::max(numThreads, 1); ++i) {
+        _workers.emplace_back(new Worker(i));
+        _workers.back()->start();
+    }
+}
+
+SendScheduler::~SendScheduler() {
+    for (auto& worker : _workers) {
+        Q_ASSERT_X(worker->getNumQueues() == 0, "SendScheduler::~SendScheduler", "SendQueues outlived their scheduler");
+        worker->stop();
+    }
+}
+
+void SendScheduler::add(Queue* queue) {
+    // give the queue to the thread with the fewest queues
+    auto worker = std::min_element(_workers.begin(), _workers.end(), [](const std::unique_ptr<Worker>& a,
+                                                                        const std::unique_ptr<Worker>& b) {
+        return a->getNumQueues() < b->getNumQueues();
+    });
+    (*worker)->add(queue);
+}
+
+void SendScheduler::remove(Queue* queue) {
+    int workerIndex = queue->_schedulerEntry.worker;
+    if (workerIndex >= 0) {
+        _workers[workerIndex]->remove(queue);
+    }
+}
+
+void SendScheduler::wake(Queue* queue) {
+    auto& entry = queue->_schedulerEntry;
+
+    // the worker clears hasActivity before processing, and checks it after setting wakesOnActivity,
+    // so either it sees this activity, or we see that the queue is waiting for it
+    entry.hasActivity = true;
+    int workerIndex = entry.worker;
+    if (entry.wakesOnActivity && workerIndex >= 0) {
+        _workers[workerIndex]->wake(queue);
+    }
+}
+
+QJsonObject SendScheduler::takeLagStats() {
+    LagHistogram histogram {{}};
+    quint64 maxLagUsecs = 0;
+    int numQueues = 0;
+
+    for (auto& worker : _workers) {
+        worker->takeLagStats(histogram, maxLagUsecs);
+        numQueues += worker->getNumQueues();
+    }
+
+    QJsonObject lagHistogram;
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        auto key = i < NUM_LAG_BOUNDS ? QString("<%1").arg(LAG_BUCKET_USECS[i])
+                                      : QString(">=%1").arg(LAG_BUCKET_USECS[NUM_LAG_BOUNDS - 1]);
+        lagHistogram[key] = (qint64)histogram[i];
+    }
+
+    QJsonObject stats;
+    stats["num_threads"] = (int)_workers.size();
+    stats["num_queues"] = numQueues;
+    stats["lag_usecs"] = lagHistogram;
+    stats["max_lag_usecs"] = (qint64)maxLagUsecs;
+    return stats;
+}
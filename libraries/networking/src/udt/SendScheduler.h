@@ -0,0 +1,94 @@
+//
+//  SendScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendScheduler_h
+#define hifi_SendScheduler_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+// Runs the SendQueues of a socket on a few threads, instead of one sleeping thread per queue.
+// Each thread keeps a timer wheel of when its queues are next due, and processes the due queues in a batch.
+// A queue is due when its pacing delay has elapsed, or when it was waiting for activity (packets to send,
+// ACKs, NAKs, the handshake ACK) and gets some.
+class SendScheduler {
+public:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    // When a queue should be processed next
+    struct Wakeup {
+        TimePoint time;
+        bool onActivity; // or earlier, if there is activity
+    };
+
+    // Per queue scheduling state, only touched by the scheduler
+    struct Entry {
+        std::atomic<int> worker { -1 }; // read without the lock by wake()
+        uint64_t tick { 0 };
+        size_t slotIndex { 0 };
+        std::chrono::steady_clock::time_point deadline; // of a timed wakeup, to measure how late it was
+        bool isScheduled { false };
+        bool isProcessing { false };
+
+        std::atomic<bool> hasActivity { false };
+        std::atomic<bool> wakesOnActivity { false };
+    };
+
+    // What the scheduler runs, a SendQueue
+    class Queue {
+    public:
+        virtual ~Queue() {}
+
+        // does what is due now, returns when to be processed next
+        virtual Wakeup process(TimePoint now) = 0;
+
+        // a stopped queue is no longer processed, until it is removed
+        virtual bool isStopped() const = 0;
+
+    private:
+        friend class SendScheduler;
+        Entry _schedulerEntry;
+    };
+
+    explicit SendScheduler(int numThreads = 1);
+    ~SendScheduler();
+
+    SendScheduler(const SendScheduler&) = delete;
+    SendScheduler& operator=(const SendScheduler&) = delete;
+
+    // starts processing the queue right away
+    void add(Queue* queue);
+
+    // waits if the queue is being processed, must not be called from the processing
+    void remove(Queue* queue);
+
+    // notes activity for the queue, and processes it now if it was waiting for some
+    void wake(Queue* queue);
+
+    // histogram of how late queues were processed, against when they were due, since the last call
+    QJsonObject takeLagStats();
+
+private:
+    class Worker;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+};
+
+}
+
+#endif // hifi_SendScheduler_h
@@ -474,6 +474,23 @@ void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtua
     _synInterval = _ccFactory->synInterval();
 }
 
+bool Socket::setCongestionControl(const QString& name) {
+    std::unique_ptr<CongestionControlVirtualFactory> ccFactory;
+
+    if (name == "vegas") {
+        ccFactory.reset(new CongestionControlFactory<TCPVegasCC>());
+    } else if (name == "bbr") {
+        ccFactory.reset(new CongestionControlFactory<BBRCC>());
+    } else if (name == "udt") {
+        ccFactory.reset(new CongestionControlFactory<DefaultCC>());
+    } else {
+        qCWarning(networking) << "Unknown congestion control" << name << "- keeping the current one.";
+        return false;
+    }
+
+    setCongestionControlFactory(std::move(ccFactory));
+    return true;
+}
 
 void Socket::setConnectionMaxBandwidth(int maxBandwidth) {
     qInfo() << "Setting socket's maximum bandwith to" << maxBandwidth << "bps. ("
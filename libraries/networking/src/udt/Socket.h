@@ -23,8 +23,10 @@
 #include <QtNetwork/QUdpSocket>
 
 #include "../HifiSockAddr.h"
+#include "BBRCC.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "SendScheduler.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -81,6 +83,10 @@ public:
         { _unfilteredHandlers[senderSockAddr] = handler; }
     
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
+
+    // selects the congestion control of new connections - "vegas" (the default), "bbr" or "udt",
+    // returns false and keeps the current one for any other name
+    bool setCongestionControl(const QString& name);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
     void messageReceived(std::unique_ptr<Packet> packet);
@@ -88,6 +94,8 @@ public:
     
     StatsVector sampleStatsForAllConnections();
 
+    SendScheduler& getSendScheduler() { return _sendScheduler; }
+
 #if (PR_BUILD || DEV_BUILD)
     void sendFakedHandshakeRequest(const HifiSockAddr& sockAddr);
 #endif
@@ -132,6 +140,8 @@ private:
 
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
+
+    SendScheduler _sendScheduler; // runs the connections' send queues, must outlive them
     std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> _connectionsHash;
     
     int _synInterval { 10 }; // 10ms
@@ -13,6 +13,7 @@
 
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
+#include "impl/PointerClip.h"
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -55,7 +56,8 @@ float Clip::position() const {
 }
 
 // FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
+// fileOffset is advanced past what is written
+bool writeFrame(QIODevice& output, const Frame& frame, quint64& fileOffset, bool compressed = true) {
     if (frame.type == Frame::TYPE_INVALID) {
         qWarning() << "Attempting to write invalid frame";
         return true;
@@ -87,9 +89,28 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
             return false;
         }
     }
+    fileOffset += FRAME_HEADER_SIZE + dataSize;
     return true;
 }
 
+// Writes the index of the frames, and the footer that locates it
+bool writeIndex(QIODevice& output, const std::vector<PointerFrameHeader>& index, quint64& fileOffset) {
+    ClipIndexFooter footer;
+    footer.frameCount = (uint32_t)index.size();
+    footer.indexOffset = fileOffset;
+
+    for (size_t i = 0; i < index.size(); i += ENTRIES_PER_INDEX_FRAME) {
+        size_t entryCount = std::min(ENTRIES_PER_INDEX_FRAME, index.size() - i);
+        QByteArray entries(reinterpret_cast<const char*>(&index[i]), (int)(entryCount * sizeof(PointerFrameHeader)));
+        if (!writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, entries }), fileOffset, false)) {
+            return false;
+        }
+    }
+
+    QByteArray footerData(reinterpret_cast<const char*>(&footer), sizeof(ClipIndexFooter));
+    return writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, footerData }), fileOffset, false);
+}
+
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
 
@@ -105,17 +126,32 @@ bool Clip::write(QIODevice& output) {
     // Always mark new files as compressed
     rootObject.insert(FRAME_COMREPSSION_FLAG, true);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
+    quint64 fileOffset = 0;
     // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), fileOffset, false)) {
         return false;
     }
 
     seek(0);
 
+    std::vector<PointerFrameHeader> index;
+    index.reserve(frameCount());
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        quint64 frameOffset = fileOffset;
+        if (!writeFrame(output, *frame, fileOffset)) {
             return false;
         }
+        if (fileOffset == frameOffset) {
+            // invalid frames are skipped
+            continue;
+        }
+
+        PointerFrameHeader header;
+        header.fileOffset = frameOffset + FRAME_HEADER_SIZE;
+        header.timeOffset = frame->timeOffset;
+        header.type = frame->type;
+        header.size = (FrameSize)(fileOffset - header.fileOffset);
+        index.push_back(header);
     }
-    return true;
+    return writeIndex(output, index, fileOffset);
 }
@@ -6,23 +6,25 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 #include "ClipCache.h"
+
+#include <QtCore/QFileInfo>
+
+#include "impl/FileClip.h"
 #include "impl/PointerClip.h"
 
 using namespace recording;
 NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
-    Resource(url),
-    _clip(std::make_shared<NetworkClip>(url)) {}
-
-void NetworkClip::init(const QByteArray& clipData) {
-    _clipData = clipData;
-    PointerClip::init((uchar*)_clipData.data(), _clipData.size());
-}
+    Resource(url) {}
 
 void NetworkClipLoader::downloadFinished(const QByteArray& data) {
-    _clip->init(data);
+    _clipData = std::make_shared<ClipData>(data);
     finishedLoading(true);
 }
 
+ClipPointer NetworkClipLoader::getClip() {
+    return std::make_shared<NetworkClip>(_url, _clipData);
+}
+
 ClipCache& ClipCache::instance() {
     static ClipCache _instance;
     return _instance;
@@ -32,6 +34,24 @@ NetworkClipLoaderPointer ClipCache::getClipLoader(const QUrl& url) {
     return ResourceCache::getResource(url, QUrl(), nullptr).staticCast<NetworkClipLoader>();
 }
 
+ClipPointer ClipCache::getFileClip(const QString& filePath) {
+    QFileInfo fileInfo(filePath);
+    std::unique_lock<std::mutex> lock(_mappedFilesMutex);
+
+    // a file that changed since it was mapped is mapped again
+    auto& mappedFile = _mappedFiles[fileInfo.absoluteFilePath()];
+    auto clipData = mappedFile.clipData.lock();
+    if (!clipData || mappedFile.lastModified != fileInfo.lastModified() || mappedFile.size != fileInfo.size()) {
+        clipData = std::make_shared<ClipData>(filePath);
+        mappedFile = { clipData, fileInfo.lastModified(), fileInfo.size() };
+    }
+
+    if (clipData->frameCount() == 0) {
+        return ClipPointer();
+    }
+    return std::make_shared<FileClip>(filePath, clipData);
+}
+
 QSharedPointer<Resource> ClipCache::createResource(const QUrl& url, const QSharedPointer<Resource>& fallback, const void* extra) {
     return QSharedPointer<Resource>(new NetworkClipLoader(url), &Resource::deleter);
 }
@@ -9,6 +9,8 @@
 #ifndef hifi_Recording_ClipCache_h
 #define hifi_Recording_ClipCache_h
 
+#include <QtCore/QDateTime>
+
 #include <ResourceCache.h>
 
 #include "Forward.h"
@@ -20,12 +22,10 @@ class NetworkClip : public PointerClip {
 public:
     using Pointer = std::shared_ptr<NetworkClip>;
 
-    NetworkClip(const QUrl& url) : _url(url) {}
-    virtual void init(const QByteArray& clipData);
+    NetworkClip(const QUrl& url, const ClipData::Pointer& clipData) : PointerClip(clipData), _url(url) {}
     virtual QString getName() const override { return _url.toString(); }
 
 private:
-    QByteArray _clipData;
     QUrl _url;
 };
 
@@ -33,11 +33,13 @@ class NetworkClipLoader : public Resource {
 public:
     NetworkClipLoader(const QUrl& url);
     virtual void downloadFinished(const QByteArray& data) override;
-    ClipPointer getClip() { return _clip; }
+
+    // each clip has its own position, the downloaded data is shared
+    ClipPointer getClip();
     bool completed() { return _failedToLoad || isLoaded(); }
 
 private:
-    const NetworkClip::Pointer _clip;
+    ClipData::Pointer _clipData;
 };
 
 using NetworkClipLoaderPointer = QSharedPointer<NetworkClipLoader>;
@@ -48,8 +50,21 @@ public:
 
     NetworkClipLoaderPointer getClipLoader(const QUrl& url);
 
+    // each clip has its own position, the mapping of the file is shared while any of them is in use
+    ClipPointer getFileClip(const QString& filePath);
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url, const QSharedPointer<Resource>& fallback, const void* extra) override;
+
+private:
+    struct MappedFile {
+        std::weak_ptr<const ClipData> clipData;
+        QDateTime lastModified;
+        qint64 size;
+    };
+
+    std::mutex _mappedFilesMutex;
+    QHash<QString, MappedFile> _mappedFiles;
 };
 
 }
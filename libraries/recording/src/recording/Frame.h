@@ -36,6 +36,7 @@ struct FrameHeader {
 
     static const FrameType TYPE_INVALID = 0xFFFF;
     static const FrameType TYPE_HEADER = 0x0;
+    static const FrameType TYPE_INDEX = 0xFFFD; // never registered, holds the index of a clip file
 
     static Time secondsToFrameTime(float seconds);
     static float frameTimeToSeconds(Time frameTime);
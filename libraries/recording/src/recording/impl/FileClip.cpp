@@ -11,6 +11,7 @@
 #include <algorithm>
 
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
 
 #include <Finally.h>
 
@@ -21,21 +22,16 @@
 
 using namespace recording;
 
-FileClip::FileClip(const QString& fileName) : _file(fileName) {
-    auto size = _file.size();
-    qDebug(recordingLog) << "Opening file of size: " << size;
-    bool opened = _file.open(QIODevice::ReadOnly);
-    if (!opened) {
-        qCWarning(recordingLog) << "Unable to open file " << fileName;
-        return;
-    }
-    auto mappedFile = _file.map(0, size, QFile::MapPrivateOption);
-    init(mappedFile, size);
-}
+FileClip::FileClip(const QString& fileName) :
+    PointerClip(std::make_shared<ClipData>(fileName)),
+    _fileName(fileName) {}
 
+FileClip::FileClip(const QString& fileName, const ClipData::Pointer& clipData) :
+    PointerClip(clipData),
+    _fileName(fileName) {}
 
 QString FileClip::getName() const {
-    return _file.fileName();
+    return _fileName;
 }
 
 
@@ -56,12 +52,3 @@ bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
     Finally closer([&] { outputFile.close(); });
     return clip->write(outputFile);
 }
-
-FileClip::~FileClip() {
-    Locker lock(_mutex);
-    _file.unmap(_data);
-    if (_file.isOpen()) {
-        _file.close();
-    }
-    reset();
-}
@@ -12,8 +12,6 @@
 
 #include "PointerClip.h"
 
-#include <QtCore/QFile>
-
 namespace recording {
 
 class FileClip : public PointerClip {
@@ -21,14 +19,14 @@ public:
     using Pointer = std::shared_ptr<FileClip>;
 
     FileClip(const QString& file);
-    virtual ~FileClip();
+    FileClip(const QString& file, const ClipData::Pointer& clipData);
 
     virtual QString getName() const override;
 
     static bool write(const QString& filePath, Clip::Pointer clip);
 
 private:
-    QFile _file;
+    QString _fileName;
 };
 
 }
@@ -44,117 +44,329 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
     return results;
 }
 
+// Reads the header of the frame at offset, returns false if the frame doesn't fit in the data
+// FIXME move to Frame::readHeader?
+static bool readFrameHeader(const uchar* start, size_t size, size_t offset, PointerFrameHeader& header) {
+    if (offset > size || size - offset < (size_t)FRAME_HEADER_SIZE) {
+        return false;
+    }
+    auto current = start + offset;
+    memcpy(&(header.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&(header.size), current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    header.fileOffset = current - start;
+    return size - header.fileOffset >= header.size;
+}
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
-    PointerFrameHeaderList results;
-    auto current = start;
-    auto end = current + size;
-    // Read all the frame headers
-    // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
-        header.fileOffset = current - start;
-        if (end - current < header.size) {
-            current = end;
-            break;
-        }
-        current += header.size;
-        results.push_back(header);
-    }
-    qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames";
-//    int i = 0;
-//    for (const auto& frameHeader : results) {
-//        qDebug(recordingLog) << "Frame " << i++ << " time " << frameHeader.timeOffset << " Type " << frameHeader.type;
-//    }
-    return results;
+ClipData::ClipData(const QByteArray& clipData) : _clipData(clipData) {
+    init(reinterpret_cast<const uchar*>(_clipData.constData()), _clipData.size());
 }
 
-void PointerClip::reset() {
-    _frames.clear();
-    _data = nullptr;
-    _size = 0;
-    _header = QJsonDocument();
+ClipData::ClipData(const QString& fileName) : _file(fileName) {
+    auto size = _file.size();
+    qDebug(recordingLog) << "Opening file of size: " << size;
+    bool opened = _file.open(QIODevice::ReadOnly);
+    if (!opened) {
+        qCWarning(recordingLog) << "Unable to open file " << fileName;
+        return;
+    }
+    _mappedFile = _file.map(0, size, QFile::MapPrivateOption);
+    if (_mappedFile) {
+        init(_mappedFile, size);
+    }
 }
 
-void PointerClip::init(uchar* data, size_t size) {
-    reset();
+ClipData::~ClipData() {
+    if (_mappedFile) {
+        _file.unmap(_mappedFile);
+    }
+    if (_file.isOpen()) {
+        _file.close();
+    }
+}
 
+void ClipData::init(const uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
+    size_t firstFrameOffset;
+    if (!readHeader(firstFrameOffset)) {
+        return;
+    }
+
+    if (!readIndex(firstFrameOffset) || !checkIndex()) {
+        // written before clips had an index, or damaged
+        buildIndex(firstFrameOffset);
+        checkIndex();
+    }
+    qDebug(recordingLog) << "Indexed source data into " << _frameCount << " frames"
+        << (_storedIndex ? "using the stored index" : "");
+}
+
+bool ClipData::readHeader(size_t& firstFrameOffset) {
     // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
+    PointerFrameHeader fileHeaderFrameHeader;
+    if (!readFrameHeader(_data, _size, 0, fileHeaderFrameHeader)) {
         qWarning() << "No frames found, invalid file";
-        reset();
-        return;
+        return false;
+    }
+    if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
+        qWarning() << "Missing header frame, invalid file";
+        return false;
     }
+    firstFrameOffset = fileHeaderFrameHeader.fileOffset + fileHeaderFrameHeader.size;
 
     // Grab the file header
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
-        if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
-            qWarning() << "Missing header frame, invalid file";
-            reset();
-            return;
-        }
-
-        QByteArray fileHeaderData((char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
+        QByteArray fileHeaderData((const char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
         _header = QJsonDocument::fromBinaryData(fileHeaderData);
     }
 
     // Check for compression
     {
-        _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+        _compressed = _header.object()[Clip::FRAME_COMREPSSION_FLAG].toBool();
     }
 
-    // Find the type enum translation map and fix up the frame headers
+    // Find the type enum translation map
     {
         FrameTranslationMap translationMap = parseTranslationMap(_header);
         if (translationMap.empty()) {
             qWarning() << "Header missing frame type map, invalid file";
-            reset();
-            return;
+            return false;
         }
 
-        // Update the loaded headers with the frame data
-        _frames.reserve(parsedFrameHeaders.size());
-        for (auto& frameHeader : parsedFrameHeaders) {
-            if (!translationMap.contains(frameHeader.type)) {
-                continue;
+        _typeTranslations.assign(translationMap.lastKey() + 1, Frame::TYPE_INVALID);
+        for (auto itr = translationMap.begin(); itr != translationMap.end(); ++itr) {
+            _typeTranslations[itr.key()] = itr.value();
+        }
+    }
+    return true;
+}
+
+bool ClipData::readIndex(size_t firstFrameOffset) {
+    static const size_t FOOTER_FRAME_SIZE = FRAME_HEADER_SIZE + sizeof(ClipIndexFooter);
+    static const size_t INDEX_FRAME_SIZE = FRAME_HEADER_SIZE + ENTRIES_PER_INDEX_FRAME * sizeof(PointerFrameHeader);
+
+    if (_size < firstFrameOffset + FOOTER_FRAME_SIZE) {
+        return false;
+    }
+
+    size_t footerFrameOffset = _size - FOOTER_FRAME_SIZE;
+    PointerFrameHeader footerFrameHeader;
+    if (!readFrameHeader(_data, _size, footerFrameOffset, footerFrameHeader) ||
+            footerFrameHeader.type != Frame::TYPE_INDEX || footerFrameHeader.size != sizeof(ClipIndexFooter)) {
+        return false;
+    }
+
+    ClipIndexFooter footer;
+    memcpy(&footer, _data + footerFrameHeader.fileOffset, sizeof(ClipIndexFooter));
+    if (footer.magic != ClipIndexFooter::MAGIC || footer.indexOffset < firstFrameOffset) {
+        return false;
+    }
+
+    // the index frames must fill the space between the index offset and the footer
+    size_t indexFrameCount = (footer.frameCount + ENTRIES_PER_INDEX_FRAME - 1) / ENTRIES_PER_INDEX_FRAME;
+    quint64 indexSize = indexFrameCount * FRAME_HEADER_SIZE + (quint64)footer.frameCount * sizeof(PointerFrameHeader);
+    if (footer.indexOffset + indexSize != footerFrameOffset) {
+        return false;
+    }
+    for (size_t i = 0; i < indexFrameCount; ++i) {
+        size_t entryCount = std::min(ENTRIES_PER_INDEX_FRAME, footer.frameCount - i * ENTRIES_PER_INDEX_FRAME);
+        PointerFrameHeader indexFrameHeader;
+        if (!readFrameHeader(_data, _size, footer.indexOffset + i * INDEX_FRAME_SIZE, indexFrameHeader) ||
+                indexFrameHeader.type != Frame::TYPE_INDEX ||
+                indexFrameHeader.size != entryCount * sizeof(PointerFrameHeader)) {
+            return false;
+        }
+    }
+
+    _storedIndex = _data + footer.indexOffset;
+    _frameCount = footer.frameCount;
+    return true;
+}
+
+void ClipData::buildIndex(size_t firstFrameOffset) {
+    _storedIndex = nullptr;
+    _builtIndex.clear();
+
+    // Read all the frame headers
+    PointerFrameHeader header;
+    for (size_t offset = firstFrameOffset; readFrameHeader(_data, _size, offset, header);
+            offset = header.fileOffset + header.size) {
+        if (header.type != Frame::TYPE_INDEX) {
+            _builtIndex.push_back(header);
+        }
+    }
+    _frameCount = _builtIndex.size();
+}
+
+// Checks that the frames are in the data, and drops the frames of types unknown to this run
+bool ClipData::checkIndex() {
+    bool hasUnknownFrames = false;
+    for (size_t i = 0; i < _frameCount; ++i) {
+        auto header = getStoredFrameHeader(i);
+        if (header.fileOffset > _size || _size - header.fileOffset < header.size) {
+            qCWarning(recordingLog) << "Clip index points outside of the clip data";
+            return false;
+        }
+        if (translateType(header.type) == Frame::TYPE_INVALID) {
+            hasUnknownFrames = true;
+        }
+    }
+
+    if (hasUnknownFrames) {
+        std::vector<PointerFrameHeader> knownFrames;
+        knownFrames.reserve(_frameCount);
+        for (size_t i = 0; i < _frameCount; ++i) {
+            auto header = getStoredFrameHeader(i);
+            if (translateType(header.type) != Frame::TYPE_INVALID) {
+                knownFrames.push_back(header);
             }
-            frameHeader.type = translationMap[frameHeader.type];
-            _frames.push_back(frameHeader);
         }
+        _builtIndex.swap(knownFrames);
+        _storedIndex = nullptr;
+        _frameCount = _builtIndex.size();
     }
+    return true;
+}
 
+FrameType ClipData::translateType(FrameType storedType) const {
+    return storedType < _typeTranslations.size() ? _typeTranslations[storedType] : Frame::TYPE_INVALID;
 }
 
-// Internal only function, needs no locking
-FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
+PointerFrameHeader ClipData::getStoredFrameHeader(size_t index) const {
+    if (!_storedIndex) {
+        return _builtIndex[index];
+    }
+
+    // the stored entries are in index frames, and may not be aligned
+    static const size_t INDEX_FRAME_SIZE = FRAME_HEADER_SIZE + ENTRIES_PER_INDEX_FRAME * sizeof(PointerFrameHeader);
+    auto entry = _storedIndex + (index / ENTRIES_PER_INDEX_FRAME) * INDEX_FRAME_SIZE + FRAME_HEADER_SIZE +
+        (index % ENTRIES_PER_INDEX_FRAME) * sizeof(PointerFrameHeader);
+    PointerFrameHeader result;
+    memcpy(&result, entry, sizeof(PointerFrameHeader));
+    return result;
+}
+
+PointerFrameHeader ClipData::getFrameHeader(size_t index) const {
+    auto result = getStoredFrameHeader(index);
+    result.type = translateType(result.type);
+    return result;
+}
+
+size_t ClipData::findFrame(Frame::Time timeOffset) const {
+    size_t first = 0;
+    size_t last = _frameCount;
+    while (first < last) {
+        size_t middle = first + (last - first) / 2;
+        if (getStoredFrameHeader(middle).timeOffset < timeOffset) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+FrameConstPointer ClipData::readFrame(size_t index) const {
     FramePointer result;
-    if (frameIndex < _frames.size()) {
+    if (index < _frameCount) {
         result = std::make_shared<Frame>();
-        const auto& header = _frames[frameIndex];
+        const auto header = getFrameHeader(index);
         result->type = header.type;
         result->timeOffset = header.timeOffset;
         if (header.size) {
-            result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
+            // the data is copied rather than referenced in place, as frame handlers pass it on to other threads
             if (_compressed) {
-                result->data = qUncompress(result->data);
+                result->data = qUncompress(_data + header.fileOffset, header.size);
+            } else {
+                result->data = QByteArray(reinterpret_cast<const char*>(_data) + header.fileOffset, header.size);
             }
         }
     }
     return result;
 }
 
+void PointerClip::reset() {
+    _clipData.reset();
+    _frameIndex = 0;
+}
+
+void PointerClip::init(const ClipData::Pointer& clipData) {
+    Locker lock(_mutex);
+    reset();
+    _clipData = clipData;
+}
+
+const QJsonDocument& PointerClip::getHeader() const {
+    static const QJsonDocument EMPTY_HEADER;
+    return _clipData ? _clipData->getHeader() : EMPTY_HEADER;
+}
+
+Clip::Pointer PointerClip::duplicate() const {
+    auto result = newClip();
+    Locker lock(_mutex);
+    for (size_t i = 0; i < frameCount(); ++i) {
+        result->addFrame(_clipData->readFrame(i));
+    }
+    return result;
+}
+
+float PointerClip::duration() const {
+    Locker lock(_mutex);
+    if (frameCount() == 0) {
+        return 0;
+    }
+    return Frame::frameTimeToSeconds(_clipData->getFrameHeader(frameCount() - 1).timeOffset);
+}
+
+size_t PointerClip::frameCount() const {
+    Locker lock(_mutex);
+    return _clipData ? _clipData->frameCount() : 0;
+}
+
+void PointerClip::seekFrameTime(Frame::Time offset) {
+    Locker lock(_mutex);
+    _frameIndex = _clipData ? _clipData->findFrame(offset) : 0;
+}
+
+Frame::Time PointerClip::positionFrameTime() const {
+    Locker lock(_mutex);
+    Frame::Time result = Frame::INVALID_TIME;
+    if (_frameIndex < frameCount()) {
+        result = _clipData->getFrameHeader(_frameIndex).timeOffset;
+    }
+    return result;
+}
+
+FrameConstPointer PointerClip::peekFrame() const {
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    if (_frameIndex < frameCount()) {
+        result = _clipData->readFrame(_frameIndex);
+    }
+    return result;
+}
+
+FrameConstPointer PointerClip::nextFrame() {
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    if (_frameIndex < frameCount()) {
+        result = _clipData->readFrame(_frameIndex++);
+    }
+    return result;
+}
+
+void PointerClip::skipFrame() {
+    Locker lock(_mutex);
+    if (_frameIndex < frameCount()) {
+        ++_frameIndex;
+    }
+}
+
 void PointerClip::addFrame(FrameConstPointer) {
     throw std::runtime_error("Pointer clips are read only, use duplicate to create a read/write clip");
 }
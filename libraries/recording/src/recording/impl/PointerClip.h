@@ -10,47 +10,119 @@
 #ifndef hifi_Recording_Impl_PointerClip_h
 #define hifi_Recording_Impl_PointerClip_h
 
-#include "ArrayClip.h"
+#include "../Clip.h"
 
 #include <mutex>
+#include <vector>
 
+#include <QtCore/QFile>
 #include <QtCore/QJsonDocument>
 
 #include "../Frame.h"
 
 namespace recording {
 
-struct PointerFrameHeader : public FrameHeader {
-    FrameType type;
+// Where a frame is in the clip data.  This is also the layout of the entries in the index of clip files.
+struct PointerFrameHeader {
+    quint64 fileOffset; // of the frame data
     Frame::Time timeOffset;
-    uint16_t size;
-    quint64 fileOffset;
+    FrameType type;
+    FrameSize size;
+};
+
+static_assert(sizeof(PointerFrameHeader) == 16, "Clip file index entries must be 16 bytes");
+
+// Clip files end with an index of their frames, so they can be played without being parsed.
+// The index is stored in TYPE_INDEX frames of up to ENTRIES_PER_INDEX_FRAME entries each, followed by
+// a TYPE_INDEX frame holding this footer.  Readers that don't know about the index skip these frames.
+struct ClipIndexFooter {
+    static const uint32_t MAGIC = 0x58444E49; // "INDX"
+
+    uint32_t magic { MAGIC };
+    uint32_t frameCount { 0 };
+    quint64 indexOffset { 0 }; // of the first index frame
 };
 
-using PointerFrameHeaderList = std::list<PointerFrameHeader>;
+static const qint64 FRAME_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+static const size_t ENTRIES_PER_INDEX_FRAME = std::numeric_limits<FrameSize>::max() / sizeof(PointerFrameHeader);
+
+// The read only data of a clip, and the index of its frames.  This is shared by all the clips playing
+// the same data, each with its own position.  Files are used in place through a memory mapping.
+class ClipData {
+public:
+    using Pointer = std::shared_ptr<const ClipData>;
+
+    ClipData(const QByteArray& clipData);
+    ClipData(const QString& fileName);
+    ~ClipData();
+
+    const QJsonDocument& getHeader() const { return _header; }
+
+    size_t frameCount() const { return _frameCount; }
+
+    // the type is translated to the frame types of this run
+    PointerFrameHeader getFrameHeader(size_t index) const;
+
+    // the index of the first frame at or after the time, or frameCount() if there is none
+    size_t findFrame(Frame::Time timeOffset) const;
+
+    // compressed frame data is decompressed straight from the clip data
+    FrameConstPointer readFrame(size_t index) const;
+
+private:
+    void init(const uchar* data, size_t size);
+    bool readHeader(size_t& firstFrameOffset);
+    bool readIndex(size_t firstFrameOffset);
+    void buildIndex(size_t firstFrameOffset);
+    bool checkIndex();
+    FrameType translateType(FrameType storedType) const;
+    PointerFrameHeader getStoredFrameHeader(size_t index) const;
 
-class PointerClip : public ArrayClip<PointerFrameHeader> {
+    QByteArray _clipData;
+    QFile _file;
+    uchar* _mappedFile { nullptr };
+
+    const uchar* _data { nullptr };
+    size_t _size { 0 };
+    QJsonDocument _header;
+    bool _compressed { true };
+    std::vector<FrameType> _typeTranslations; // from the stored frame type to the frame type of this run
+
+    // the index is either the one stored in the file, or built when the clip is loaded
+    const uchar* _storedIndex { nullptr };
+    std::vector<PointerFrameHeader> _builtIndex;
+    size_t _frameCount { 0 };
+};
+
+class PointerClip : public Clip {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
 
     PointerClip() {};
-    PointerClip(uchar* data, size_t size) { init(data, size); }
+    PointerClip(const ClipData::Pointer& clipData) { init(clipData); }
+
+    void init(const ClipData::Pointer& clipData);
+    const ClipData::Pointer& getClipData() const { return _clipData; }
 
-    void init(uchar* data, size_t size);
+    const QJsonDocument& getHeader() const;
+
+    virtual Clip::Pointer duplicate() const override;
+    virtual float duration() const override;
+    virtual size_t frameCount() const override;
+
+    virtual void seekFrameTime(Frame::Time offset) override;
+    virtual Frame::Time positionFrameTime() const override;
+
+    virtual FrameConstPointer peekFrame() const override;
+    virtual FrameConstPointer nextFrame() override;
+    virtual void skipFrame() override;
     virtual void addFrame(FrameConstPointer) override;
-    const QJsonDocument& getHeader() const {
-        return _header;
-    }
 
-    // FIXME move to frame?
-    static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
 protected:
     void reset() override;
-    virtual FrameConstPointer readFrame(size_t index) const override;
-    QJsonDocument _header;
-    uchar* _data { nullptr };
-    size_t _size { 0 };
-    bool _compressed { true };
+
+    ClipData::Pointer _clipData;
+    size_t _frameIndex { 0 };
 };
 
 }
@@ -21,6 +21,7 @@
 #include <PerfStat.h>
 #include <ViewFrustum.h>
 #include <GLMHelpers.h>
+#include <shared/ParallelFor.h>
 
 #include "AbstractViewStateInterface.h"
 #include "MeshPartPayload.h"
@@ -35,6 +36,15 @@ int nakedModelPointerTypeId = qRegisterMetaType<ModelPointer>();
 int weakGeometryResourceBridgePointerTypeId = qRegisterMetaType<Geometry::WeakPointer >();
 int vec3VectorTypeId = qRegisterMetaType<QVector<glm::vec3> >();
 float Model::FAKE_DIMENSION_PLACEHOLDER = -1.0f;
+
+// the models whose render items are to be updated this frame
+static std::mutex modelsPendingClusterMatricesMutex;
+static std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> modelsPendingClusterMatrices;
+
+static void addModelPendingClusterMatrices(const ModelWeakPointer& model) {
+    std::lock_guard<std::mutex> lock(modelsPendingClusterMatricesMutex);
+    modelsPendingClusterMatrices.insert(model);
+}
 #define HTTP_INVALID_COM "http://invalid.com"
 
 const int NUM_COLLISION_HULL_COLORS = 24;
@@ -206,6 +216,7 @@ void Model::updateRenderItems() {
     // the application will ensure only the last lambda is actually invoked.
     void* key = (void*)this;
     std::weak_ptr<Model> weakSelf = shared_from_this();
+    addModelPendingClusterMatrices(weakSelf);
     AbstractViewStateInterface::instance()->pushPostUpdateLambda(key, [weakSelf, scale]() {
 
         // do nothing, if the model has already been destroyed.
@@ -313,6 +324,9 @@ bool Model::updateGeometry() {
             }
             _blendedVertexBuffers.push_back(buffer);
         }
+        if (fbxGeometry.hasBlendedMeshes()) {
+            _blendshapes = std::make_shared<SparseBlendshapes>(fbxGeometry);
+        }
         needFullUpdate = true;
     }
     return needFullUpdate;
@@ -970,7 +984,7 @@ class Blender : public QRunnable {
 public:
 
     Blender(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients);
+        const SparseBlendshapes::Pointer& blendshapes, const QVector<float>& blendshapeCoefficients);
 
     virtual void run() override;
 
@@ -979,55 +993,28 @@ private:
     ModelPointer _model;
     int _blendNumber;
     Geometry::WeakPointer _geometry;
-    QVector<FBXMesh> _meshes;
+    SparseBlendshapes::Pointer _blendshapes;
     QVector<float> _blendshapeCoefficients;
 };
 
 Blender::Blender(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients) :
+        const SparseBlendshapes::Pointer& blendshapes, const QVector<float>& blendshapeCoefficients) :
     _model(model),
     _blendNumber(blendNumber),
     _geometry(geometry),
-    _meshes(meshes),
+    _blendshapes(blendshapes),
     _blendshapeCoefficients(blendshapeCoefficients) {
 }
 
 void Blender::run() {
     PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
-    QVector<glm::vec3> vertices, normals;
-    if (_model) {
-        int offset = 0;
-        foreach (const FBXMesh& mesh, _meshes) {
-            if (mesh.blendshapes.isEmpty()) {
-                continue;
-            }
-            vertices += mesh.vertices;
-            normals += mesh.normals;
-            glm::vec3* meshVertices = vertices.data() + offset;
-            glm::vec3* meshNormals = normals.data() + offset;
-            offset += mesh.vertices.size();
-            const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-            for (int i = 0, n = qMin(_blendshapeCoefficients.size(), mesh.blendshapes.size()); i < n; i++) {
-                float vertexCoefficient = _blendshapeCoefficients.at(i);
-                const float EPSILON = 0.0001f;
-                if (vertexCoefficient < EPSILON) {
-                    continue;
-                }
-                float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
-                const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
-                for (int j = 0; j < blendshape.indices.size(); j++) {
-                    int index = blendshape.indices.at(j);
-                    meshVertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
-                    meshNormals[index] += blendshape.normals.at(j) * normalCoefficient;
-                }
-            }
-        }
+    auto geometry = _geometry.lock();
+    if (_model && geometry && _blendshapes) {
+        _blendshapes->blend(geometry->getFBXGeometry(), _blendshapeCoefficients);
     }
     // post the result to the geometry cache, which will dispatch to the model if still alive
     QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
-        Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
-        Q_ARG(const Geometry::WeakPointer&, _geometry), Q_ARG(const QVector<glm::vec3>&, vertices),
-        Q_ARG(const QVector<glm::vec3>&, normals));
+        Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber), Q_ARG(const Geometry::WeakPointer&, _geometry));
 }
 
 void Model::setScaleToFit(bool scaleToFit, const glm::vec3& dimensions) {
@@ -1149,12 +1136,11 @@ void Model::simulateInternal(float deltaTime) {
     // update the world space transforms for all joints
     glm::mat4 parentTransform = glm::scale(_scale) * glm::translate(_offset);
     updateRig(deltaTime, parentTransform);
+    addModelPendingClusterMatrices(getThisPointer());
 }
 
 // virtual
 void Model::updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation) {
-    PerformanceTimer perfTimer("Model::updateClusterMatrices");
-
     if (!_needsUpdateClusterMatrices || !isLoaded()) {
         return;
     }
@@ -1214,9 +1200,41 @@ void Model::updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrient
             }
         }
     }
+}
+
+// static
+void Model::updatePendingClusterMatrices() {
+    PerformanceTimer perfTimer("Model::updatePendingClusterMatrices");
+
+    std::vector<ModelPointer> models;
+    {
+        std::lock_guard<std::mutex> lock(modelsPendingClusterMatricesMutex);
+        models.reserve(modelsPendingClusterMatrices.size());
+        for (auto& weakModel : modelsPendingClusterMatrices) {
+            auto model = weakModel.lock();
+            if (model) {
+                models.push_back(model);
+            }
+        }
+        modelsPendingClusterMatrices.clear();
+    }
+
+    // each model only touches its own mesh states, and the rigs are not animated while this runs
+    parallelFor((int)models.size(), [&](int i) {
+        const ModelPointer& model = models[i];
+        if (model->isLoaded()) {
+            model->updateClusterMatrices(model->getTranslation(), model->getRotation());
+        }
+    });
 
+    for (auto& model : models) {
+        model->updateBlendshapes();
+    }
+}
+
+void Model::updateBlendshapes() {
     // post the blender if we're not currently waiting for one to finish
-    if (geometry.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
+    if (isLoaded() && getFBXGeometry().hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
         _blendedBlendshapeCoefficients = _blendshapeCoefficients;
         DependencyManager::get<ModelBlender>()->noteRequiresBlend(getThisPointer());
     }
@@ -1242,44 +1260,49 @@ float Model::getLimbLength(int jointIndex) const {
 }
 
 bool Model::maybeStartBlender() {
-    if (isLoaded()) {
-        const FBXGeometry& fbxGeometry = getFBXGeometry();
-        if (fbxGeometry.hasBlendedMeshes()) {
-            QThreadPool::globalInstance()->start(new Blender(getThisPointer(), ++_blendNumber, _renderGeometry,
-                fbxGeometry.meshes, _blendshapeCoefficients));
-            return true;
-        }
+    if (isLoaded() && !_isBlending && _blendshapes) {
+        _isBlending = true;
+        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), ++_blendNumber, _renderGeometry,
+            _blendshapes, _blendshapeCoefficients));
+        return true;
     }
     return false;
 }
 
-void Model::setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) {
+void Model::setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry) {
+    if (blendNumber == _blendNumber) {
+        _isBlending = false;
+    }
     auto geometryRef = geometry.lock();
-    if (!geometryRef || _renderGeometry != geometryRef || _blendedVertexBuffers.empty() || blendNumber < _appliedBlendNumber) {
+    if (!geometryRef || _renderGeometry != geometryRef || _blendedVertexBuffers.empty() || !_blendshapes ||
+            blendNumber < _appliedBlendNumber) {
         return;
     }
     _appliedBlendNumber = blendNumber;
     const FBXGeometry& fbxGeometry = getFBXGeometry();
-    int index = 0;
     for (int i = 0; i < fbxGeometry.meshes.size(); i++) {
         const FBXMesh& mesh = fbxGeometry.meshes.at(i);
-        if (mesh.blendshapes.isEmpty()) {
+        const SparseBlendshapes::Range& range = _blendshapes->getUploadRange(i);
+        if (mesh.blendshapes.isEmpty() || range.isEmpty()) {
             continue;
         }
 
+        // only the vertices that changed since the last blend
         gpu::BufferPointer& buffer = _blendedVertexBuffers[i];
-        buffer->setSubData(0, mesh.vertices.size() * sizeof(glm::vec3), (gpu::Byte*) vertices.constData() + index*sizeof(glm::vec3));
-        buffer->setSubData(mesh.vertices.size() * sizeof(glm::vec3),
-            mesh.normals.size() * sizeof(glm::vec3), (gpu::Byte*) normals.constData() + index*sizeof(glm::vec3));
-
-        index += mesh.vertices.size();
+        size_t offset = range.start * sizeof(glm::vec3);
+        size_t size = (range.end - range.start) * sizeof(glm::vec3);
+        buffer->setSubData(offset, size, (const gpu::Byte*)(_blendshapes->getVertices(i) + range.start));
+        if (mesh.normals.size() == mesh.vertices.size()) {
+            buffer->setSubData(mesh.vertices.size() * sizeof(glm::vec3) + offset, size,
+                (const gpu::Byte*)(_blendshapes->getNormals(i) + range.start));
+        }
     }
 }
 
 void Model::deleteGeometry() {
     _deleteGeometryCounter++;
     _blendedVertexBuffers.clear();
+    _blendshapes.reset();
     _meshStates.clear();
     _rig->destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
@@ -1469,7 +1492,7 @@ ModelBlender::~ModelBlender() {
 }
 
 void ModelBlender::noteRequiresBlend(ModelPointer model) {
-    if (_pendingBlenders < QThread::idealThreadCount()) {
+    if (_pendingBlenders < QThread::idealThreadCount() && !model->isBlending()) {
         if (model->maybeStartBlender()) {
             _pendingBlenders++;
         }
@@ -1482,18 +1505,21 @@ void ModelBlender::noteRequiresBlend(ModelPointer model) {
     }
 }
 
-void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber,
-        const Geometry::WeakPointer& geometry, const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) {
+void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry) {
     if (model) {
-        model->setBlendedVertices(blendNumber, geometry, vertices, normals);
+        model->setBlendedVertices(blendNumber, geometry);
     }
     _pendingBlenders--;
     {
         Lock lock(_mutex);
         for (auto i = _modelsRequiringBlends.begin(); i != _modelsRequiringBlends.end();) {
-            auto weakPtr = *i;
-            _modelsRequiringBlends.erase(i++); // remove front of the set
-            ModelPointer nextModel = weakPtr.lock();
+            ModelPointer nextModel = i->lock();
+            if (nextModel && nextModel->isBlending()) {
+                // it blends its latest coefficients once its current blend is done
+                ++i;
+                continue;
+            }
+            _modelsRequiringBlends.erase(i++);
             if (nextModel && nextModel->maybeStartBlender()) {
                 _pendingBlenders++;
                 return;
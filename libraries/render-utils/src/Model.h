@@ -31,6 +31,7 @@
 #include "GeometryCache.h"
 #include "TextureCache.h"
 #include "Rig.h"
+#include "SparseBlendshapes.h"
 
 class AbstractViewStateInterface;
 class QScriptEngine;
@@ -102,15 +103,16 @@ public:
     bool isLayeredInFront() const { return _isLayeredInFront; }
 
     void updateRenderItems();
+    void updateBlendshapes();
     void setRenderItemsNeedUpdate() { _renderItemsNeedUpdate = true; }
     bool getRenderItemsNeedUpdate() { return _renderItemsNeedUpdate; }
     AABox getRenderableMeshBound() const;
 
     bool maybeStartBlender();
+    bool isBlending() const { return _isBlending; }
 
-    /// Sets blended vertices computed in a separate thread.
-    void setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
+    /// Uploads the vertices blended in a separate thread.
+    void setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry);
 
     bool isLoaded() const { return (bool)_renderGeometry; }
 
@@ -128,6 +130,11 @@ public:
     virtual void simulate(float deltaTime, bool fullUpdate = true);
     virtual void updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation);
 
+    /// Updates the cluster matrices of every model whose render items are to be updated, spread over the global
+    /// thread pool, then posts their blenders. Called on the main thread once per frame, before the scene applies
+    /// the pending changes to the render items.
+    static void updatePendingClusterMatrices();
+
     /// Returns a reference to the shared geometry.
     const Geometry::Pointer& getGeometry() const { return _renderGeometry; }
     /// Returns a reference to the shared collision geometry.
@@ -358,8 +365,10 @@ protected:
     QVector<QVector<QSharedPointer<Texture> > > _dilatedTextures;
 
     QVector<float> _blendedBlendshapeCoefficients;
+    SparseBlendshapes::Pointer _blendshapes;
     int _blendNumber;
     int _appliedBlendNumber;
+    bool _isBlending { false }; // further blends wait for this one, then blend the latest coefficients
 
     QHash<QPair<int,int>, AABox> _calculatedMeshPartBoxes; // world coordinate AABoxes for all sub mesh part boxes
 
@@ -438,8 +447,7 @@ public:
     void noteRequiresBlend(ModelPointer model);
 
 public slots:
-    void setBlendedVertices(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
+    void setBlendedVertices(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry);
 
 private:
     using Mutex = std::mutex;
@@ -0,0 +1,155 @@
+//
+//  SparseBlendshapes.cpp
+//  libraries/render-utils/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SparseBlendshapes.h"
+
+#include <algorithm>
+
+#include <FBXReader.h>
+
+// blendshapes move normals less than vertices
+static const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+static const float COEFFICIENT_EPSILON = 0.0001f;
+
+//
+// on x86 architecture, assume that SSE is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <xmmintrin.h>
+
+// adds the deltas times the coefficient to the vec3s at the indices, four floats at a time:
+// the fourth float of each delta is zero, so it leaves the float after the vec3 as it was
+static void addDeltas(float* vectors, const int* indices, const glm::vec4* deltas, int count, float coefficient) {
+    __m128 scale = _mm_set1_ps(coefficient);
+    for (int i = 0; i < count; i++) {
+        float* vector = vectors + 3 * indices[i];
+        __m128 delta = _mm_loadu_ps(&deltas[i].x);
+        _mm_storeu_ps(vector, _mm_add_ps(_mm_loadu_ps(vector), _mm_mul_ps(delta, scale)));
+    }
+}
+
+#else   // portable reference code
+
+static void addDeltas(float* vectors, const int* indices, const glm::vec4* deltas, int count, float coefficient) {
+    for (int i = 0; i < count; i++) {
+        float* vector = vectors + 3 * indices[i];
+        vector[0] += deltas[i].x * coefficient;
+        vector[1] += deltas[i].y * coefficient;
+        vector[2] += deltas[i].z * coefficient;
+    }
+}
+
+#endif
+
+void SparseBlendshapes::Range::expand(const Range& other) {
+    if (other.isEmpty()) {
+        return;
+    }
+    if (isEmpty()) {
+        *this = other;
+        return;
+    }
+    start = std::min(start, other.start);
+    end = std::max(end, other.end);
+}
+
+SparseBlendshapes::SparseBlendshapes(const FBXGeometry& geometry) {
+    _meshes.resize(geometry.meshes.size());
+    for (int i = 0; i < geometry.meshes.size(); i++) {
+        const FBXMesh& fbxMesh = geometry.meshes.at(i);
+        if (fbxMesh.blendshapes.isEmpty()) {
+            continue;
+        }
+        Mesh& mesh = _meshes[i];
+        mesh.vertexCount = fbxMesh.vertices.size();
+        bool hasNormals = (fbxMesh.normals.size() == fbxMesh.vertices.size());
+
+        for (int j = 0; j < fbxMesh.blendshapes.size(); j++) {
+            const FBXBlendshape& fbxBlendshape = fbxMesh.blendshapes.at(j);
+            if (fbxBlendshape.indices.isEmpty()) {
+                continue;
+            }
+            Blendshape blendshape;
+            blendshape.blendshapeIndex = j;
+            blendshape.range.start = mesh.vertexCount;
+            blendshape.indices.reserve(fbxBlendshape.indices.size());
+            blendshape.vertexDeltas.reserve(fbxBlendshape.indices.size());
+            if (hasNormals) {
+                blendshape.normalDeltas.reserve(fbxBlendshape.indices.size());
+            }
+            for (int k = 0; k < fbxBlendshape.indices.size(); k++) {
+                int index = fbxBlendshape.indices.at(k);
+                if (index < 0 || index >= mesh.vertexCount) {
+                    continue;
+                }
+                blendshape.indices.push_back(index);
+                blendshape.vertexDeltas.push_back(glm::vec4(fbxBlendshape.vertices.at(k), 0.0f));
+                if (hasNormals) {
+                    glm::vec3 normalDelta = (k < fbxBlendshape.normals.size()) ? fbxBlendshape.normals.at(k) : glm::vec3();
+                    blendshape.normalDeltas.push_back(glm::vec4(normalDelta, 0.0f));
+                }
+                blendshape.range.start = std::min(blendshape.range.start, index);
+                blendshape.range.end = std::max(blendshape.range.end, index + 1);
+            }
+            if (!blendshape.indices.empty()) {
+                mesh.blendshapes.push_back(std::move(blendshape));
+            }
+        }
+
+        mesh.blended.resize(3 * (fbxMesh.vertices.size() + fbxMesh.normals.size()) + 1, 0.0f);
+        std::copy_n((const float*)fbxMesh.vertices.constData(), 3 * fbxMesh.vertices.size(), mesh.blended.data());
+        std::copy_n((const float*)fbxMesh.normals.constData(), 3 * fbxMesh.normals.size(),
+            mesh.blended.data() + 3 * mesh.vertexCount);
+    }
+}
+
+void SparseBlendshapes::blend(const FBXGeometry& geometry, const QVector<float>& coefficients) {
+    for (size_t i = 0; i < _meshes.size(); i++) {
+        Mesh& mesh = _meshes[i];
+        if (mesh.blendshapes.empty()) {
+            continue;
+        }
+        const FBXMesh& fbxMesh = geometry.meshes.at((int)i);
+        float* vertices = mesh.blended.data();
+        float* normals = vertices + 3 * mesh.vertexCount;
+        bool hasNormals = (fbxMesh.normals.size() == mesh.vertexCount);
+
+        // restore what the last blend changed
+        const Range& dirty = mesh.dirtyRange;
+        if (!dirty.isEmpty()) {
+            int count = 3 * (dirty.end - dirty.start);
+            std::copy_n((const float*)(fbxMesh.vertices.constData() + dirty.start), count, vertices + 3 * dirty.start);
+            if (hasNormals) {
+                std::copy_n((const float*)(fbxMesh.normals.constData() + dirty.start), count, normals + 3 * dirty.start);
+            }
+        }
+        mesh.uploadRange = dirty;
+        mesh.dirtyRange = Range();
+
+        for (const Blendshape& blendshape : mesh.blendshapes) {
+            if (blendshape.blendshapeIndex >= coefficients.size()) {
+                break;
+            }
+            float vertexCoefficient = coefficients.at(blendshape.blendshapeIndex);
+            if (vertexCoefficient < COEFFICIENT_EPSILON) {
+                continue;
+            }
+            int count = (int)blendshape.indices.size();
+            addDeltas(vertices, blendshape.indices.data(), blendshape.vertexDeltas.data(), count, vertexCoefficient);
+            if (!blendshape.normalDeltas.empty()) {
+                addDeltas(normals, blendshape.indices.data(), blendshape.normalDeltas.data(), count,
+                    vertexCoefficient * NORMAL_COEFFICIENT_SCALE);
+            }
+            mesh.dirtyRange.expand(blendshape.range);
+        }
+        mesh.uploadRange.expand(mesh.dirtyRange);
+    }
+}
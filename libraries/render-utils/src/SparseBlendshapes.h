@@ -0,0 +1,75 @@
+//
+//  SparseBlendshapes.h
+//  libraries/render-utils/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SparseBlendshapes_h
+#define hifi_SparseBlendshapes_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include <glm/glm.hpp>
+
+class FBXGeometry;
+
+// The blendshapes of a model as sparse deltas, and the blended meshes they are applied to.
+// The blended meshes are kept between blends: each blend restores only the vertices the last one changed,
+// adds the deltas of the blendshapes whose coefficients are not zero, and notes the range of vertices to upload.
+// Blends are not thread safe, the model runs one at a time.
+class SparseBlendshapes {
+public:
+    using Pointer = std::shared_ptr<SparseBlendshapes>;
+
+    // a range of vertices, empty when end <= start
+    struct Range {
+        int start { 0 };
+        int end { 0 };
+
+        bool isEmpty() const { return end <= start; }
+        void expand(const Range& other);
+    };
+
+    SparseBlendshapes(const FBXGeometry& geometry);
+
+    // geometry must be the one these blendshapes were made from
+    void blend(const FBXGeometry& geometry, const QVector<float>& coefficients);
+
+    // the vertices of each mesh to upload after the last blend, empty for meshes without blendshapes
+    const Range& getUploadRange(int meshIndex) const { return _meshes[meshIndex].uploadRange; }
+
+    // the blended vertices then normals of the mesh, laid out as in its blended vertex buffer
+    const glm::vec3* getVertices(int meshIndex) const { return (const glm::vec3*)_meshes[meshIndex].blended.data(); }
+    const glm::vec3* getNormals(int meshIndex) const { return getVertices(meshIndex) + _meshes[meshIndex].vertexCount; }
+
+private:
+    // the deltas are padded to four floats, so they are added a whole register at a time
+    struct Blendshape {
+        int blendshapeIndex;
+        Range range; // of the vertices it moves
+        std::vector<int> indices;
+        std::vector<glm::vec4> vertexDeltas;
+        std::vector<glm::vec4> normalDeltas; // empty when the mesh has no normal per vertex
+    };
+
+    struct Mesh {
+        int vertexCount { 0 };
+        std::vector<Blendshape> blendshapes;
+
+        // the vertices then the normals, and a float of padding for the four float add to the last normal
+        std::vector<float> blended;
+        Range dirtyRange; // of the vertices that differ from the mesh
+        Range uploadRange;
+    };
+
+    std::vector<Mesh> _meshes;
+};
+
+#endif // hifi_SparseBlendshapes_h
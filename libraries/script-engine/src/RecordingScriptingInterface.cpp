@@ -55,6 +55,18 @@ float RecordingScriptingInterface::playerLength() const {
 bool RecordingScriptingInterface::loadRecording(const QString& url) {
     using namespace recording;
 
+    // local files are used in place, rather than read into memory
+    QUrl clipURL(url);
+    if (clipURL.isLocalFile()) {
+        auto clip = ClipCache::instance().getFileClip(clipURL.toLocalFile());
+        if (!clip) {
+            qWarning() << "Clip failed to load from " << url;
+            return false;
+        }
+        _player->queueClip(clip);
+        return true;
+    }
+
     auto loader = ClipCache::instance().getClipLoader(url);
     if (!loader->isLoaded()) {
         QEventLoop loop;
@@ -141,9 +141,11 @@ static inline bool cpuSupportsAVX2() {
     unsigned int eax, ebx, ecx, edx;
 
     bool result = false;
-    if (cpuSupportsAVX()) {
+    if (cpuSupportsAVX() && __get_cpuid_max(0, nullptr) >= 0x7) {
 
-        if (__get_cpuid(0x7, &eax, &ebx, &ecx, &edx) && ((ebx & MASK_AVX2) == MASK_AVX2)) {
+        // leaf 7 requires subleaf 0
+        __cpuid_count(0x7, 0, eax, ebx, ecx, edx);
+        if ((ebx & MASK_AVX2) == MASK_AVX2) {
             result = true;
         }
     }
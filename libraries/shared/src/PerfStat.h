@@ -23,6 +23,7 @@
 #include <cstring>
 #include <string>
 #include <map>
+#include <mutex>
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
@@ -73,6 +74,8 @@ private:
     SimpleMovingAverage _movingAverage;
 };
 
+// Timers may run on any thread: each thread nests its own names, and the records they add to are shared.
+// The records returned by reference are only safe to read while no timer runs on another thread.
 class PerformanceTimer {
 public:
 
@@ -95,6 +98,7 @@ private:
     static std::atomic<bool> _isActive;
     static QHash<QThread*, QString> _fullNames;
     static QMap<QString, PerformanceTimerRecord> _records;
+    static std::mutex _mutex; // guards _fullNames and _records
 };
 
 
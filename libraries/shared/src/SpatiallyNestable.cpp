@@ -18,6 +18,7 @@
 
 const float defaultAACubeSize = 1.0f;
 const int maxParentingChain = 30;
+const quint16 noJointIndex = (quint16)-1;
 
 SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
     _nestableType(nestableType),
@@ -30,6 +31,7 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
 
 SpatiallyNestable::~SpatiallyNestable() {
     forEachChild([&](SpatiallyNestablePointer object) {
+        object->invalidateTransformCache();
         object->parentDeleted();
     });
 }
@@ -67,6 +69,7 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
             _parentKnowsMe = false;
         }
     });
+    invalidateTransformCache();
 }
 
 Transform SpatiallyNestable::getParentTransform(bool& success, int depth) const {
@@ -144,6 +147,7 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
     _parentJointIndex = parentJointIndex;
+    invalidateTransformCache();
 }
 
 glm::vec3 SpatiallyNestable::worldToLocal(const glm::vec3& position,
@@ -401,8 +405,11 @@ void SpatiallyNestable::setPosition(const glm::vec3& position, bool& success, bo
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
         }
     });
-    if (success && changed) {
-        locationChanged(tellPhysics);
+    if (changed) {
+        invalidateTransformCache();
+        if (success) {
+            locationChanged(tellPhysics);
+        }
     }
 }
 
@@ -453,8 +460,11 @@ void SpatiallyNestable::setOrientation(const glm::quat& orientation, bool& succe
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
         }
     });
-    if (success && changed) {
-        locationChanged(tellPhysics);
+    if (changed) {
+        invalidateTransformCache();
+        if (success) {
+            locationChanged(tellPhysics);
+        }
     }
 }
 
@@ -588,14 +598,65 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+    quint32 generation = _transformGeneration;
+    bool isCached = false;
+    _transformLock.withReadLock([&] {
+        if (_cachedTransformGeneration == generation) {
+            result = _cachedTransform;
+            isCached = true;
+        }
+    });
+    if (isCached) {
+        success = true;
+        return result;
+    }
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    // if this object or an ancestor moved since generation was read, the generation is stale and this is never used
+    if (success && isTransformCacheable()) {
+        _transformLock.withWriteLock([&] {
+            _cachedTransform = result;
+            _cachedTransformGeneration = generation;
+        });
+    }
     return result;
 }
 
+bool SpatiallyNestable::hasCachedTransform() const {
+    quint32 generation = _transformGeneration;
+    bool result = false;
+    _transformLock.withReadLock([&] {
+        result = _cachedTransformGeneration == generation;
+    });
+    return result;
+}
+
+bool SpatiallyNestable::isTransformCacheable() const {
+    SpatiallyNestablePointer parent = _parent.lock();
+    if (!parent) {
+        return getParentID().isNull();
+    }
+    // joints move without their object's location changing, so the transforms of things parented
+    // to a joint (or to something parented to a joint) are always recomputed.
+    return _parentJointIndex == noJointIndex && parent->hasCachedTransform();
+}
+
+void SpatiallyNestable::invalidateTransformCache(int depth) {
+    _transformGeneration++;
+
+    // the world-transforms of the descendants are relative to this one.  The depth stops a parenting loop.
+    if (depth < maxParentingChain) {
+        forEachChild([&](SpatiallyNestablePointer object) {
+            object->invalidateTransformCache(depth + 1);
+        });
+    }
+}
+
 const Transform SpatiallyNestable::getTransform() const {
     bool success;
     Transform result = getTransform(success);
@@ -651,8 +712,11 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             changed = true;
         }
     });
-    if (success && changed) {
-        locationChanged();
+    if (changed) {
+        invalidateTransformCache();
+        if (success) {
+            locationChanged();
+        }
     }
 }
 
@@ -692,6 +756,7 @@ void SpatiallyNestable::setScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        invalidateTransformCache();
         dimensionsChanged();
     }
 }
@@ -714,6 +779,7 @@ void SpatiallyNestable::setScale(float value) {
     });
 
     if (changed) {
+        invalidateTransformCache();
         dimensionsChanged();
     }
 }
@@ -742,6 +808,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     });
 
     if (changed) {
+        invalidateTransformCache();
         locationChanged();
     }
 }
@@ -768,6 +835,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         }
     });
     if (changed) {
+        invalidateTransformCache();
         locationChanged(tellPhysics);
     }
 }
@@ -794,6 +862,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         }
     });
     if (changed) {
+        invalidateTransformCache();
         locationChanged();
     }
 }
@@ -850,6 +919,9 @@ void SpatiallyNestable::setLocalScale(const glm::vec3& scale) {
             changed = true;
         }
     });
+    if (changed) {
+        invalidateTransformCache();
+    }
     dimensionsChanged();
 }
 
@@ -1071,6 +1143,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     });
 
     if (changed) {
+        invalidateTransformCache();
         locationChanged(false);
     }
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -201,11 +203,19 @@ protected:
     bool _missingAncestor { false };
 
 private:
+    // the world-frame transform is cached until this object or an ancestor moves, or the parenting changes
+    void invalidateTransformCache(int depth = 0);
+    bool hasCachedTransform() const;
+    bool isTransformCacheable() const;
+
     mutable ReadWriteLockable _transformLock;
     mutable ReadWriteLockable _idLock;
     mutable ReadWriteLockable _velocityLock;
     mutable ReadWriteLockable _angularVelocityLock;
     Transform _transform; // this is to be combined with parent's world-transform to produce this' world-transform.
+    std::atomic<quint32> _transformGeneration { 1 }; // bumped whenever the world-transform may have changed
+    mutable quint32 _cachedTransformGeneration { 0 }; // _transformGeneration when _cachedTransform was computed
+    mutable Transform _cachedTransform; // world-frame, guarded by _transformLock
     glm::vec3 _velocity;
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
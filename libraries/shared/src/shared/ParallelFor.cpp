@@ -0,0 +1,79 @@
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+namespace {
+
+// Shared between the caller and the helpers; helpers may start after the caller has returned,
+// in which case they find nothing left to claim and never touch the task.
+struct ParallelForState {
+    ParallelForState(int count, const std::function<void(int)>& task) : count(count), task(&task) {}
+
+    const int count;
+    const std::function<void(int)>* task;
+
+    std::atomic<int> next { 0 };
+    std::atomic<int> completed { 0 };
+
+    std::mutex mutex;
+    std::condition_variable done;
+
+    void run() {
+        for (int i = next++; i < count; i = next++) {
+            (*task)(i);
+            if (++completed == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+};
+
+class ParallelForHelper : public QRunnable {
+public:
+    ParallelForHelper(const std::shared_ptr<ParallelForState>& state) : _state(state) {}
+    void run() override { _state->run(); }
+
+private:
+    std::shared_ptr<ParallelForState> _state;
+};
+
+}
+
+void parallelFor(int count, const std::function<void(int)>& task) {
+    if (count <= 0) {
+        return;
+    }
+    if (count == 1) {
+        task(0);
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>(count, task);
+
+    auto pool = QThreadPool::globalInstance();
+    int numHelpers = std::min(count, pool->maxThreadCount()) - 1;
+    for (int i = 0; i < numHelpers; i++) {
+        pool->start(new ParallelForHelper(state));
+    }
+
+    // take part, then wait for the tasks claimed by the helpers
+    state->run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->completed == count; });
+}
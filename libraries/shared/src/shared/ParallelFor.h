@@ -0,0 +1,19 @@
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_Shared_ParallelFor_h
+#define hifi_Shared_ParallelFor_h
+
+#include <functional>
+
+// Runs task(i) for every i in [0, count), spread over the calling thread and the idle threads of the global QThreadPool.
+// The calling thread always takes part and never waits on a task that has not started, so it is safe to call
+// from a task that is itself running on the global pool (such as the texture readers).
+// Returns once every task has completed.
+void parallelFor(int count, const std::function<void(int)>& task);
+
+#endif // hifi_Shared_ParallelFor_h
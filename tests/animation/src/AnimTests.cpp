@@ -10,11 +10,14 @@
 #include "AnimTests.h"
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimCompressedClip.h>
 #include <AnimBlendLinear.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
 #include <AnimExpression.h>
 #include <AnimUtil.h>
+#include <AnimSkeleton.h>
+#include <NumericalConstants.h>
 
 #include <../QTestExtensions.h>
 
@@ -22,6 +25,10 @@ QTEST_MAIN(AnimTests)
 
 const float EPSILON = 0.001f;
 
+// evaluations of the avatar graph per benchmark iteration, as many as a crowded domain makes per frame
+static const int BENCHMARK_AVATAR_COUNT = 100;
+static const int BENCHMARK_CLIP_FRAME_COUNT = 60;
+
 void AnimTests::initTestCase() {
     auto animationCache = DependencyManager::set<AnimationCache>();
     auto resourceCacheSharedItems = DependencyManager::set<ResourceCacheSharedItems>();
@@ -422,6 +429,250 @@ void AnimTests::testAnimPose() {
     }
 }
 
+// the blend of each pose, as blend() did before it was vectorized
+static AnimPose referenceBlend(const AnimPose& a, const AnimPose& b, float alpha) {
+    glm::quat q2 = (glm::dot(a.rot, b.rot) < 0.0f) ? -b.rot : b.rot;
+    return AnimPose(lerp(a.scale, b.scale, alpha), glm::normalize(glm::lerp(a.rot, q2, alpha)), lerp(a.trans, b.trans, alpha));
+}
+
+void AnimTests::testBlend() {
+    AnimPoseVec a, b;
+    for (int i = 0; i < 16; i++) {
+        float angle = i * PI / 8.0f;
+        a.push_back(AnimPose(glm::vec3(1.0f + i), glm::angleAxis(angle, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(i, 0.0f, -i)));
+        // every other rotation is in the far hemisphere, so its sign has to be flipped
+        glm::quat rot = glm::angleAxis(-angle, glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f)));
+        b.push_back(AnimPose(glm::vec3(0.5f), (i % 2) ? -rot : rot, glm::vec3(0.0f, i, 2.0f * i)));
+    }
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+        AnimPoseVec result(a.size());
+        ::blend(a.size(), &a[0], &b[0], alpha, &result[0]);
+
+        // in place, as the state machine and clips do
+        AnimPoseVec inPlace = a;
+        ::blend(inPlace.size(), &inPlace[0], &b[0], alpha, &inPlace[0]);
+
+        for (size_t i = 0; i < a.size(); i++) {
+            AnimPose expected = referenceBlend(a[i], b[i], alpha);
+            QCOMPARE_WITH_ABS_ERROR(result[i].scale, expected.scale, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].rot, expected.rot, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].trans, expected.trans, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(inPlace[i].rot, expected.rot, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(inPlace[i].trans, expected.trans, EPSILON);
+        }
+    }
+
+    // an alpha per pose, as overlays blend their bone sets
+    std::vector<float> alphas;
+    for (size_t i = 0; i < a.size(); i++) {
+        alphas.push_back((i % 3) * 0.5f);
+    }
+    AnimPoseVec result(a.size());
+    ::blend(a.size(), &a[0], &b[0], &alphas[0], 0.5f, &result[0]);
+    for (size_t i = 0; i < a.size(); i++) {
+        AnimPose expected = referenceBlend(a[i], b[i], alphas[i] * 0.5f);
+        QCOMPARE_WITH_ABS_ERROR(result[i].rot, expected.rot, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].trans, expected.trans, EPSILON);
+    }
+}
+
+void AnimTests::testCompressedClip() {
+    const int FRAME_COUNT = 90;
+    const int JOINT_COUNT = 16;
+    std::vector<AnimPoseVec> frames(FRAME_COUNT);
+    for (int frame = 0; frame < FRAME_COUNT; frame++) {
+        for (int i = 0; i < JOINT_COUNT; i++) {
+            // some joints hold still, the others swing, with the sign of their rotations flipping now and then
+            float angle = (i % 4 == 0) ? 0.5f : 0.8f * sinf(0.1f * frame + i);
+            glm::quat rot = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, (float)i, 0.0f)));
+            glm::vec3 trans(0.1f * i, (i % 2) ? 0.05f * sinf(0.2f * frame) : 0.3f, 0.0f);
+            frames[frame].push_back(AnimPose(glm::vec3(1.0f), (frame % 7 == 0) ? -rot : rot, trans));
+        }
+    }
+
+    AnimCompressedClip clip(frames);
+    QCOMPARE(clip.getFrameCount(), FRAME_COUNT);
+    QCOMPARE(clip.getJointCount(), JOINT_COUNT);
+    QVERIFY(clip.getKeySize() < FRAME_COUNT * JOINT_COUNT * sizeof(AnimPose) / 2);
+
+    AnimPoseVec poses(JOINT_COUNT);
+    for (int frame = 0; frame < FRAME_COUNT; frame++) {
+        clip.sampleFrame(frame, poses);
+        for (int i = 0; i < JOINT_COUNT; i++) {
+            const AnimPose& expected = frames[frame][i];
+            glm::quat rot = (glm::dot(poses[i].rot, expected.rot) < 0.0f) ? -poses[i].rot : poses[i].rot;
+            QCOMPARE_WITH_ABS_ERROR(rot, expected.rot, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(poses[i].trans, expected.trans, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(poses[i].scale, expected.scale, EPSILON);
+        }
+    }
+
+    // frames outside the clip are clamped to it
+    AnimPoseVec first(JOINT_COUNT);
+    clip.sampleFrame(0, first);
+    clip.sampleFrame(-10, poses);
+    for (int i = 0; i < JOINT_COUNT; i++) {
+        QCOMPARE_WITH_ABS_ERROR(poses[i].trans, first[i].trans, EPSILON);
+    }
+}
+
+// a humanoid skeleton, with the joints the avatar graph refers to
+static std::vector<FBXJoint> makeHumanoidJoints() {
+    struct JointDesc {
+        const char* name;
+        int parentIndex;
+        glm::vec3 translation;
+    };
+    const std::vector<JointDesc> descs = {
+        { "Hips", -1, glm::vec3(0.0f, 1.0f, 0.0f) },
+        { "Spine", 0, glm::vec3(0.0f, 0.1f, 0.0f) },
+        { "Spine1", 1, glm::vec3(0.0f, 0.1f, 0.0f) },
+        { "Spine2", 2, glm::vec3(0.0f, 0.1f, 0.0f) },
+        { "Neck", 3, glm::vec3(0.0f, 0.2f, 0.0f) },
+        { "Head", 4, glm::vec3(0.0f, 0.1f, 0.0f) },
+        { "HeadTop_End", 5, glm::vec3(0.0f, 0.2f, 0.0f) },
+        { "LeftShoulder", 3, glm::vec3(0.1f, 0.15f, 0.0f) },
+        { "LeftArm", 7, glm::vec3(0.1f, 0.0f, 0.0f) },
+        { "LeftForeArm", 8, glm::vec3(0.25f, 0.0f, 0.0f) },
+        { "LeftHand", 9, glm::vec3(0.25f, 0.0f, 0.0f) },
+        { "LeftHandIndex1", 10, glm::vec3(0.1f, 0.0f, 0.0f) },
+        { "LeftHandThumb1", 10, glm::vec3(0.03f, 0.0f, 0.03f) },
+        { "RightShoulder", 3, glm::vec3(-0.1f, 0.15f, 0.0f) },
+        { "RightArm", 13, glm::vec3(-0.1f, 0.0f, 0.0f) },
+        { "RightForeArm", 14, glm::vec3(-0.25f, 0.0f, 0.0f) },
+        { "RightHand", 15, glm::vec3(-0.25f, 0.0f, 0.0f) },
+        { "RightHandIndex1", 16, glm::vec3(-0.1f, 0.0f, 0.0f) },
+        { "RightHandThumb1", 16, glm::vec3(-0.03f, 0.0f, 0.03f) },
+        { "LeftUpLeg", 0, glm::vec3(0.1f, 0.0f, 0.0f) },
+        { "LeftLeg", 19, glm::vec3(0.0f, -0.45f, 0.0f) },
+        { "LeftFoot", 20, glm::vec3(0.0f, -0.45f, 0.0f) },
+        { "LeftToeBase", 21, glm::vec3(0.0f, -0.05f, 0.1f) },
+        { "RightUpLeg", 0, glm::vec3(-0.1f, 0.0f, 0.0f) },
+        { "RightLeg", 23, glm::vec3(0.0f, -0.45f, 0.0f) },
+        { "RightFoot", 24, glm::vec3(0.0f, -0.45f, 0.0f) },
+        { "RightToeBase", 25, glm::vec3(0.0f, -0.05f, 0.1f) }
+    };
+
+    std::vector<FBXJoint> joints;
+    for (auto& desc : descs) {
+        FBXJoint joint;
+        joint.isFree = false;
+        joint.parentIndex = desc.parentIndex;
+        joint.distanceToParent = glm::length(desc.translation);
+        joint.translation = desc.translation;
+        joint.preTransform = glm::mat4();
+        joint.preRotation = glm::quat();
+        joint.rotation = glm::quat();
+        joint.postRotation = glm::quat();
+        joint.postTransform = glm::mat4();
+        glm::mat4 parentTransform = (desc.parentIndex >= 0) ? joints[desc.parentIndex].transform : glm::mat4();
+        joint.transform = parentTransform * glm::translate(glm::mat4(), desc.translation);
+        joint.rotationMin = glm::vec3(-PI);
+        joint.rotationMax = glm::vec3(PI);
+        joint.inverseDefaultRotation = glm::quat();
+        joint.inverseBindRotation = glm::quat();
+        joint.bindTransform = joint.transform;
+        joint.name = desc.name;
+        joint.isSkeletonJoint = true;
+        joint.bindTransformFoundInCluster = true;
+        joint.hasGeometricOffset = false;
+        joints.push_back(joint);
+    }
+    return joints;
+}
+
+// Evaluates the avatar graph from AnimNodeLoader, with every clip filled in with frames of its own,
+// so that each blend, overlay and state machine interp does its work.
+void AnimTests::benchmarkAvatarGraph() {
+    QDir path(__FILE__);
+    path.cdUp();
+    AnimNodeLoader loader(QUrl::fromLocalFile(path.absoluteFilePath("data/avatar.json")));
+
+    const int timeout = 1000;
+    QEventLoop loop;
+
+    AnimNode::Pointer node = nullptr;
+    connect(&loader, &AnimNodeLoader::success, [&](AnimNode::Pointer nodeIn) { node = nodeIn; });
+
+    loop.connect(&loader, SIGNAL(success(AnimNode::Pointer)), SLOT(quit()));
+    loop.connect(&loader, SIGNAL(error(int, QString)), SLOT(quit()));
+    QTimer::singleShot(timeout, &loop, SLOT(quit()));
+
+    loop.exec();
+
+    QVERIFY((bool)node);
+
+    auto skeleton = std::make_shared<AnimSkeleton>(makeHumanoidJoints());
+    node->setSkeleton(skeleton);
+
+    int clipIndex = 0;
+    node->traverse([&](AnimNode::Pointer child) {
+        if (child->getType() == AnimNode::Type::Clip) {
+            auto clip = std::static_pointer_cast<AnimClip>(child);
+            clip->_networkAnim.reset();
+            std::vector<AnimPoseVec> frames(BENCHMARK_CLIP_FRAME_COUNT);
+            for (int frame = 0; frame < BENCHMARK_CLIP_FRAME_COUNT; frame++) {
+                AnimPoseVec& poses = frames[frame];
+                poses = skeleton->getRelativeDefaultPoses();
+                for (size_t i = 0; i < poses.size(); i++) {
+                    float angle = 0.1f * sinf((float)(frame + i + clipIndex));
+                    poses[i].rot = poses[i].rot * glm::angleAxis(angle, glm::vec3(1.0f, 0.0f, 0.0f));
+                }
+            }
+            clip->_clip = std::make_shared<AnimCompressedClip>(frames);
+            clip->_bakedClipKey = "benchmark/" + QByteArray::number(clipIndex);
+            clip->_poses.resize(skeleton->getNumJoints());
+            clip->_prevPoses.resize(skeleton->getNumJoints());
+            clip->_nextPoses.resize(skeleton->getNumJoints());
+            clipIndex++;
+        }
+        return true;
+    });
+
+    AnimVariantMap vars;
+    vars.set("isMovingForward", true);
+    vars.set("isRightHandGrab", true);
+    vars.set("rightHandOverlayAlpha", 0.5f);
+    vars.set("rightHandGrabBlend", 0.5f);
+    vars.set("leftHandGrabBlend", 0.5f);
+
+    const float dt = 1.0f / 90.0f;
+    AnimNode::Triggers triggers;
+    QBENCHMARK {
+        for (int i = 0; i < BENCHMARK_AVATAR_COUNT; i++) {
+            triggers.clear();
+            const AnimPoseVec& poses = node->evaluate(vars, dt, triggers);
+            QCOMPARE((int)poses.size(), skeleton->getNumJoints());
+        }
+    }
+}
+
+void AnimTests::testBakedClipCache() {
+    // skeletons built from the same joints share the clips baked for them
+    auto skeleton = std::make_shared<AnimSkeleton>(makeHumanoidJoints());
+    auto otherSkeleton = std::make_shared<AnimSkeleton>(makeHumanoidJoints());
+    QCOMPARE(skeleton->getSignature(), otherSkeleton->getSignature());
+
+    std::vector<FBXJoint> joints = makeHumanoidJoints();
+    joints[1].translation.y += 0.1f;
+    auto tallerSkeleton = std::make_shared<AnimSkeleton>(joints);
+    QVERIFY(skeleton->getSignature() != tallerSkeleton->getSignature());
+
+    auto animCache = DependencyManager::get<AnimationCache>();
+    QByteArray key = skeleton->getSignature() + "test.fbx";
+    QVERIFY(!animCache->getBakedClip(key));
+
+    std::vector<AnimPoseVec> frames(2, skeleton->getRelativeDefaultPoses());
+    auto clip = std::make_shared<AnimCompressedClip>(frames);
+    animCache->addBakedClip(key, clip);
+    QVERIFY(animCache->getBakedClip(key) == clip);
+
+    // clips are only held while in use
+    clip.reset();
+    QVERIFY(!animCache->getBakedClip(key));
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -27,9 +27,13 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testBlend();
+    void testCompressedClip();
+    void testBakedClipCache();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
+    void benchmarkAvatarGraph();
 };
 
 #endif // hifi_AnimTests_h
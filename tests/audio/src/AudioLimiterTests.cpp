@@ -0,0 +1,221 @@
+//
+//  AudioLimiterTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioLimiterTests.h"
+
+#include <math.h>
+#include <vector>
+
+#include <CPUDetect.h>
+
+#include "AudioLimiter.h"
+
+QTEST_MAIN(AudioLimiterTests)
+
+// block kernels, defined in AudioLimiter.cpp and avx2/AudioLimiter_avx2.cpp
+void limiterPeak_ref(const float* input, int32_t* output, int numChannels, int numFrames);
+void limiterOutput_ref(const float* input, const float* gain, const float* dither, int16_t* output,
+                       int numChannels, int numFrames);
+#ifdef ARCH_X86
+void limiterPeak_AVX2(const float* input, int32_t* output, int numChannels, int numFrames);
+void limiterOutput_AVX2(const float* input, const float* gain, const float* dither, int16_t* output,
+                        int numChannels, int numFrames);
+#endif
+
+static const int NUM_CHANNELS[] = { 1, 2, 4 };
+
+// uniform in [-1, 1], scaled over a wide dynamic range
+static float randomSample() {
+    float x = 2.0f * rand() / RAND_MAX - 1.0f;
+    return x * powf(10.0f, (float)(rand() % 12 - 8));
+}
+
+// peak detection is integer math, and must be bit-exact
+void AudioLimiterTests::testPeakAVX2() {
+#ifdef ARCH_X86
+    if (!cpuSupportsAVX2()) {
+        QSKIP("AVX2 not supported");
+    }
+    srand(1);
+    for (int numChannels : NUM_CHANNELS) {
+        for (int numFrames = 0; numFrames < 64; numFrames++) {
+
+            std::vector<float> input(numChannels * numFrames);
+            for (auto& x : input) {
+                x = randomSample();
+            }
+
+            std::vector<int32_t> expected(numFrames), actual(numFrames);
+            limiterPeak_ref(input.data(), expected.data(), numChannels, numFrames);
+            limiterPeak_AVX2(input.data(), actual.data(), numChannels, numFrames);
+
+            for (int i = 0; i < numFrames; i++) {
+                QCOMPARE(actual[i], expected[i]);
+            }
+        }
+    }
+#else
+    QSKIP("AVX2 not supported");
+#endif
+}
+
+// fused multiply-add may round differently, so output is within 1 LSB
+void AudioLimiterTests::testOutputAVX2() {
+#ifdef ARCH_X86
+    if (!cpuSupportsAVX2()) {
+        QSKIP("AVX2 not supported");
+    }
+    srand(2);
+    for (int numChannels : NUM_CHANNELS) {
+        for (int numFrames = 0; numFrames < 64; numFrames++) {
+
+            std::vector<float> input(numChannels * numFrames);
+            std::vector<float> gain(numFrames), dither(numFrames);
+            for (auto& x : input) {
+                x = 2.0f * rand() / RAND_MAX - 1.0f;
+            }
+            for (int i = 0; i < numFrames; i++) {
+                gain[i] = 32000.0f * rand() / RAND_MAX;    // within 16-bit range
+                dither[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+            }
+
+            std::vector<int16_t> expected(numChannels * numFrames), actual(numChannels * numFrames);
+            limiterOutput_ref(input.data(), gain.data(), dither.data(), expected.data(), numChannels, numFrames);
+            limiterOutput_AVX2(input.data(), gain.data(), dither.data(), actual.data(), numChannels, numFrames);
+
+            for (int i = 0; i < numChannels * numFrames; i++) {
+                QVERIFY(abs(actual[i] - expected[i]) <= 1);
+            }
+        }
+    }
+#else
+    QSKIP("AVX2 not supported");
+#endif
+}
+
+// output must not depend on how the input is split into render calls
+void AudioLimiterTests::testBlockSize() {
+    const int NUM_FRAMES = 4800;
+    const int BLOCK_SIZES[] = { 240, 1, 7, 513, 256, 33 };
+
+    srand(3);
+    for (int numChannels : NUM_CHANNELS) {
+
+        std::vector<float> input(numChannels * NUM_FRAMES);
+        for (int i = 0; i < numChannels * NUM_FRAMES; i++) {
+            input[i] = 4.0f * sinf(0.01f * i) * rand() / RAND_MAX;
+        }
+
+        AudioLimiter limiter0(48000, numChannels);
+        AudioLimiter limiter1(48000, numChannels);
+        limiter0.setThreshold(-6.0f);
+        limiter1.setThreshold(-6.0f);
+
+        std::vector<int16_t> expected(numChannels * NUM_FRAMES), actual(numChannels * NUM_FRAMES);
+        limiter0.render(input.data(), expected.data(), NUM_FRAMES);
+
+        for (int i = 0, k = 0; i < NUM_FRAMES; k++) {
+            int n = std::min(BLOCK_SIZES[k % 6], NUM_FRAMES - i);
+            limiter1.render(&input[numChannels * i], &actual[numChannels * i], n);
+            i += n;
+        }
+
+        for (int i = 0; i < numChannels * NUM_FRAMES; i++) {
+            QCOMPARE(actual[i], expected[i]);
+        }
+    }
+}
+
+void AudioLimiterTests::testSettled() {
+    const int NUM_FRAMES = 240;
+
+    for (int numChannels : NUM_CHANNELS) {
+
+        AudioLimiter limiter(48000, numChannels);
+        std::vector<float> input(numChannels * NUM_FRAMES);
+        std::vector<int16_t> output(numChannels * NUM_FRAMES);
+
+        // a new limiter is at rest
+        QVERIFY(limiter.isSettled());
+
+        // a loud frame engages the limiter
+        for (int i = 0; i < numChannels * NUM_FRAMES; i++) {
+            input[i] = 4.0f * sinf(0.1f * i);
+        }
+        limiter.render(input.data(), output.data(), NUM_FRAMES);
+        QVERIFY(!limiter.isSettled());
+
+        // silence flushes the delay and releases the envelope
+        std::fill(input.begin(), input.end(), 0.0f);
+        int numSilentFrames = 0;
+        while (!limiter.isSettled()) {
+            limiter.render(input.data(), output.data(), NUM_FRAMES);
+            QVERIFY(++numSilentFrames < 1000);
+        }
+
+        // once settled, silence renders as dither only
+        limiter.render(input.data(), output.data(), NUM_FRAMES);
+        for (int i = 0; i < numChannels * NUM_FRAMES; i++) {
+            QVERIFY(abs(output[i]) <= 1);
+        }
+        QVERIFY(limiter.isSettled());
+    }
+}
+
+// skipping render while settled must leave the limiter as rendering silence would,
+// so only the dither differs when audio resumes
+void AudioLimiterTests::testSettledResume() {
+    const int NUM_FRAMES = 240;
+    const int NUM_SKIPPED_BLOCKS = 200;
+
+    for (int numChannels : NUM_CHANNELS) {
+
+        AudioLimiter continuous(48000, numChannels);
+        AudioLimiter skipped(48000, numChannels);
+        std::vector<float> input(numChannels * NUM_FRAMES);
+        std::vector<int16_t> expected(numChannels * NUM_FRAMES), actual(numChannels * NUM_FRAMES);
+        int t = 0;
+
+        // limit hard, then release into silence until settled
+        for (int k = 0; k < 20; k++) {
+            for (int i = 0; i < numChannels * NUM_FRAMES; i++, t++) {
+                input[i] = 4.0f * sinf(0.05f * t);
+            }
+            continuous.render(input.data(), expected.data(), NUM_FRAMES);
+            skipped.render(input.data(), actual.data(), NUM_FRAMES);
+        }
+        std::fill(input.begin(), input.end(), 0.0f);
+        int numSilentBlocks = 0;
+        while (!skipped.isSettled()) {
+            continuous.render(input.data(), expected.data(), NUM_FRAMES);
+            skipped.render(input.data(), actual.data(), NUM_FRAMES);
+            QVERIFY(++numSilentBlocks < 1000);
+        }
+
+        // one keeps rendering silence while the other skips
+        for (int k = 0; k < NUM_SKIPPED_BLOCKS; k++) {
+            continuous.render(input.data(), expected.data(), NUM_FRAMES);
+        }
+        QVERIFY(continuous.isSettled());
+
+        // a loud onset and its release render the same, within the difference of two dithers
+        for (int k = 0; k < 80; k++) {
+            float amplitude = (k < 5) ? 4.0f : 0.9f;
+            for (int i = 0; i < numChannels * NUM_FRAMES; i++, t++) {
+                input[i] = amplitude * sinf(0.05f * t);
+            }
+            continuous.render(input.data(), expected.data(), NUM_FRAMES);
+            skipped.render(input.data(), actual.data(), NUM_FRAMES);
+            for (int i = 0; i < numChannels * NUM_FRAMES; i++) {
+                QVERIFY(abs(actual[i] - expected[i]) <= 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  AudioLimiterTests.h
+//  tests/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioLimiterTests_h
+#define hifi_AudioLimiterTests_h
+
+#include <QtTest/QtTest>
+
+class AudioLimiterTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testPeakAVX2();
+    void testOutputAVX2();
+    void testBlockSize();
+    void testSettled();
+    void testSettledResume();
+};
+
+#endif // hifi_AudioLimiterTests_h
@@ -0,0 +1,106 @@
+//
+//  AudioReverbTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioReverbTests.h"
+
+#include <math.h>
+#include <vector>
+
+#include <CPUDetect.h>
+
+#include "AudioReverb.h"
+
+QTEST_MAIN(AudioReverbTests)
+
+// block kernels, defined in AudioReverb.cpp and avx2/AudioReverb_avx2.cpp
+void allpass_ref(const float* src, float* dst, const float* input, float* output, float coef, int numFrames);
+#ifdef ARCH_X86
+void allpass_AVX2(const float* src, float* dst, const float* input, float* output, float coef, int numFrames);
+#endif
+
+// fused multiply-add may round differently, so results are within a few ULP
+void AudioReverbTests::testAllpassAVX2() {
+#ifdef ARCH_X86
+    if (!cpuSupportsAVX2()) {
+        QSKIP("AVX2 not supported");
+    }
+    const float EPSILON = 1.0e-6f;
+
+    srand(1);
+    for (int numFrames = 0; numFrames < 64; numFrames++) {
+
+        std::vector<float> src(numFrames), input(numFrames);
+        for (int i = 0; i < numFrames; i++) {
+            src[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+            input[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+        }
+        float coef = 0.6180339887f;
+
+        std::vector<float> dst0(numFrames), dst1(numFrames), output0(numFrames), output1(numFrames);
+        allpass_ref(src.data(), dst0.data(), input.data(), output0.data(), coef, numFrames);
+        allpass_AVX2(src.data(), dst1.data(), input.data(), output1.data(), coef, numFrames);
+
+        for (int i = 0; i < numFrames; i++) {
+            QVERIFY(fabsf(dst1[i] - dst0[i]) < EPSILON);
+            QVERIFY(fabsf(output1[i] - output0[i]) < EPSILON);
+        }
+
+        // in-place, as used when delay equals the buffer size
+        std::vector<float> buffer = src;
+        allpass_AVX2(buffer.data(), buffer.data(), input.data(), output1.data(), coef, numFrames);
+
+        for (int i = 0; i < numFrames; i++) {
+            QVERIFY(fabsf(buffer[i] - dst0[i]) < EPSILON);
+            QVERIFY(fabsf(output1[i] - output0[i]) < EPSILON);
+        }
+    }
+#else
+    QSKIP("AVX2 not supported");
+#endif
+}
+
+// output must not depend on how the input is split into render calls
+void AudioReverbTests::testBlockSize() {
+    const int NUM_FRAMES = 48000;
+    const int BLOCK_SIZES[] = { 240, 1, 7, 513, 256, 33, 1000 };
+    const float ROOM_SIZES[] = { 0.0f, 10.0f, 50.0f, 100.0f };
+
+    srand(2);
+    std::vector<float> input(2 * NUM_FRAMES);
+    for (int i = 0; i < 2 * NUM_FRAMES; i++) {
+        input[i] = (i < NUM_FRAMES / 4) ? (2.0f * rand() / RAND_MAX - 1.0f) : 0.0f;
+    }
+
+    for (float roomSize : ROOM_SIZES) {
+
+        AudioReverb reverb0(48000.0f);
+        AudioReverb reverb1(48000.0f);
+
+        ReverbParameters p;
+        reverb0.getParameters(&p);
+        p.roomSize = roomSize;
+        p.preDelay = 1.0f;
+        reverb0.setParameters(&p);
+        reverb1.setParameters(&p);
+
+        std::vector<float> expected(2 * NUM_FRAMES), actual(2 * NUM_FRAMES);
+        reverb0.render(input.data(), expected.data(), NUM_FRAMES);
+
+        for (int i = 0, k = 0; i < NUM_FRAMES; k++) {
+            int n = std::min(BLOCK_SIZES[k % 7], NUM_FRAMES - i);
+            reverb1.render(&input[2 * i], &actual[2 * i], n);
+            i += n;
+        }
+
+        for (int i = 0; i < 2 * NUM_FRAMES; i++) {
+            QCOMPARE(actual[i], expected[i]);
+        }
+    }
+}
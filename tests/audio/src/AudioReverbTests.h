@@ -0,0 +1,24 @@
+//
+//  AudioReverbTests.h
+//  tests/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioReverbTests_h
+#define hifi_AudioReverbTests_h
+
+#include <QtTest/QtTest>
+
+class AudioReverbTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAllpassAVX2();
+    void testBlockSize();
+};
+
+#endif // hifi_AudioReverbTests_h
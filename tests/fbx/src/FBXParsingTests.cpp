@@ -0,0 +1,310 @@
+//
+//  FBXParsingTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXParsingTests.h"
+
+#include <QtCore/QBuffer>
+
+#include <FBXReader.h>
+
+QTEST_MAIN(FBXParsingTests)
+
+static const quint32 VERSION_FBX2014 = 7400;
+static const quint32 VERSION_FBX2016 = 7500;
+
+static const int BENCHMARK_VERTEX_COUNT = 1000000;
+
+// a node to write, with its properties already encoded
+struct TestNode {
+    QByteArray name;
+    QByteArray properties;
+    quint32 propertyCount { 0 };
+    QList<TestNode> children;
+};
+
+template<class T> static void append(QByteArray& data, T value) {
+    data.append((const char*)&value, sizeof(T));
+}
+
+static void addInt(TestNode& node, qint32 value) {
+    node.properties.append('I');
+    append(node.properties, value);
+    node.propertyCount++;
+}
+
+static void addString(TestNode& node, const QByteArray& value) {
+    node.properties.append('S');
+    append(node.properties, (quint32)value.size());
+    node.properties.append(value);
+    node.propertyCount++;
+}
+
+template<class T> static void addArray(TestNode& node, char type, const QVector<T>& values, bool deflate) {
+    QByteArray data((const char*)values.constData(), values.size() * sizeof(T));
+    if (deflate) {
+        data = qCompress(data).mid(sizeof(quint32)); // a zlib stream, without Qt's length prefix
+    }
+    node.properties.append(type);
+    append(node.properties, (quint32)values.size());
+    append(node.properties, (quint32)(deflate ? 1 : 0));
+    append(node.properties, (quint32)data.size());
+    node.properties.append(data);
+    node.propertyCount++;
+}
+
+static QByteArray writeNode(const TestNode& node, qint64 offset, bool has64BitPositions) {
+    int headerSize = (has64BitPositions ? 3 * sizeof(quint64) : 3 * sizeof(quint32)) + 1 + node.name.size();
+    QByteArray body = node.properties;
+    for (auto& child : node.children) {
+        body.append(writeNode(child, offset + headerSize + body.size(), has64BitPositions));
+    }
+    if (!node.children.isEmpty()) {
+        body.append(QByteArray(has64BitPositions ? 25 : 13, 0)); // null record
+    }
+    qint64 endOffset = offset + headerSize + body.size();
+
+    QByteArray data;
+    if (has64BitPositions) {
+        append(data, (quint64)endOffset);
+        append(data, (quint64)node.propertyCount);
+        append(data, (quint64)node.properties.size());
+    } else {
+        append(data, (quint32)endOffset);
+        append(data, node.propertyCount);
+        append(data, (quint32)node.properties.size());
+    }
+    append(data, (quint8)node.name.size());
+    data.append(node.name);
+    data.append(body);
+    return data;
+}
+
+static QByteArray writeDocument(const QList<TestNode>& nodes, quint32 version) {
+    QByteArray data("Kaydara FBX Binary  ");
+    data.append('\0');
+    data.append('\x1A');
+    data.append('\0');
+    append(data, version);
+    bool has64BitPositions = (version >= VERSION_FBX2016);
+    for (auto& node : nodes) {
+        data.append(writeNode(node, data.size(), has64BitPositions));
+    }
+    data.append(QByteArray(has64BitPositions ? 25 : 13, 0)); // null record
+    return data;
+}
+
+static FBXNode parse(const QByteArray& data) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return FBXReader::parseFBX(&buffer);
+}
+
+static TestNode createGeometry(int vertexCount, bool deflate, QVector<double>& vertices, QVector<int>& indices) {
+    vertices.resize(3 * vertexCount);
+    for (int i = 0; i < vertices.size(); i++) {
+        vertices[i] = i * 0.25 - 100.0;
+    }
+    indices.resize(vertexCount);
+    for (int i = 0; i < indices.size(); i++) {
+        indices[i] = ((i % 3) == 2) ? ~i : i; // the last index of each triangle is negated, as in FBX files
+    }
+
+    TestNode verticesNode;
+    verticesNode.name = "Vertices";
+    addArray(verticesNode, 'd', vertices, deflate);
+    TestNode indicesNode;
+    indicesNode.name = "PolygonVertexIndex";
+    addArray(indicesNode, 'i', indices, deflate);
+
+    TestNode geometry;
+    geometry.name = "Geometry";
+    addInt(geometry, 42);
+    addString(geometry, QByteArray("Geometry::Test\0\1Geometry", 24));
+    addString(geometry, "Mesh");
+    geometry.children << verticesNode << indicesNode;
+
+    TestNode objects;
+    objects.name = "Objects";
+    objects.children << geometry;
+    return objects;
+}
+
+// arrays come back as typed vectors, whether deflated or not, in either node header format
+void FBXParsingTests::testBinaryArrays() {
+    for (quint32 version : { VERSION_FBX2014, VERSION_FBX2016 }) {
+        for (bool deflate : { false, true }) {
+            QVector<double> vertices;
+            QVector<int> indices;
+            TestNode objects = createGeometry(1000, deflate, vertices, indices);
+
+            TestNode weights;
+            weights.name = "Weights";
+            QVector<float> floats { 0.0f, 0.5f, 1.0f };
+            addArray(weights, 'f', floats, deflate);
+            QVector<char> bytes { 0, 1, 2 };
+            addArray(weights, 'b', bytes, deflate);
+            objects.children[0].children << weights;
+
+            FBXNode top = parse(writeDocument({ objects }, version));
+            QCOMPARE(top.children.size(), 1);
+            const FBXNode& geometry = top.children.at(0).children.at(0);
+            QCOMPARE(geometry.name, QByteArray("Geometry"));
+            QCOMPARE(geometry.properties.size(), 3);
+            QCOMPARE(geometry.properties.at(0).toInt(), 42);
+            QCOMPARE(geometry.properties.at(1).toByteArray(), QByteArray("Geometry::Test\0\1Geometry", 24));
+            QCOMPARE(geometry.properties.at(2).toByteArray(), QByteArray("Mesh"));
+
+            QCOMPARE(geometry.children.size(), 3);
+            QCOMPARE(FBXReader::getDoubleVector(geometry.children.at(0)), vertices);
+            QCOMPARE(FBXReader::getIntVector(geometry.children.at(1)), indices);
+            QCOMPARE(FBXReader::getFloatVector(geometry.children.at(2)), floats);
+            QCOMPARE(geometry.children.at(2).properties.at(1).value<QVector<bool>>(), QVector<bool>({ false, true, true }));
+        }
+    }
+}
+
+// the top level nodes that the geometry isn't extracted from are not parsed
+void FBXParsingTests::testSkippedTopLevelNodes() {
+    QVector<double> vertices;
+    QVector<int> indices;
+    TestNode takes = createGeometry(10, false, vertices, indices);
+    takes.name = "Takes";
+    addString(takes, "Take 001");
+    TestNode objects = createGeometry(10, true, vertices, indices);
+
+    FBXNode top = parse(writeDocument({ takes, objects }, VERSION_FBX2016));
+    QCOMPARE(top.children.size(), 2);
+    QCOMPARE(top.children.at(0).name, QByteArray("Takes"));
+    QVERIFY(top.children.at(0).properties.isEmpty());
+    QVERIFY(top.children.at(0).children.isEmpty());
+    QCOMPARE(top.children.at(1).name, QByteArray("Objects"));
+    QCOMPARE(FBXReader::getDoubleVector(top.children.at(1).children.at(0).children.at(0)), vertices);
+}
+
+// a file cut short throws, rather than reading past its end
+void FBXParsingTests::testTruncatedFile() {
+    QVector<double> vertices;
+    QVector<int> indices;
+    QByteArray data = writeDocument({ createGeometry(100, false, vertices, indices) }, VERSION_FBX2016);
+    for (int size : { 30, 100, data.size() / 2, data.size() - 40 }) {
+        QVERIFY_EXCEPTION_THROWN(parse(data.left(size)), QString);
+    }
+
+    // array lengths larger than the file can hold throw before anything is allocated
+    for (bool deflate : { false, true }) {
+        for (quint32 arrayLength : { (quint32)0x0FFFFFFF, (quint32)0xFFFFFFF0 }) {
+            QByteArray corrupt = writeDocument({ createGeometry(100, deflate, vertices, indices) }, VERSION_FBX2016);
+            int lengthOffset = corrupt.indexOf("Vertices") + QByteArray("Vertices").size() + 1; // after the 'd' type
+            memcpy(corrupt.data() + lengthOffset, &arrayLength, sizeof(quint32));
+            QVERIFY_EXCEPTION_THROWN(parse(corrupt), QString);
+        }
+    }
+
+    // a skipped top level node ending before itself would be parsed over and over
+    TestNode takes = createGeometry(10, false, vertices, indices);
+    takes.name = "Takes";
+    QByteArray looping = writeDocument({ takes }, VERSION_FBX2016);
+    const int HEADER_SIZE = 27;
+    quint64 endOffset = HEADER_SIZE + 3 * sizeof(quint64);
+    memcpy(looping.data() + HEADER_SIZE, &endOffset, sizeof(quint64));
+    QVERIFY_EXCEPTION_THROWN(parse(looping), QString);
+}
+
+// geometry comes back from its baked form as it went in, and a cut short or stale blob is refused
+void FBXParsingTests::testBakedGeometry() {
+    FBXGeometry geometry;
+    geometry.author = "author";
+
+    FBXJoint joint;
+    joint.isFree = false;
+    joint.parentIndex = -1;
+    joint.distanceToParent = 0.0f;
+    joint.translation = glm::vec3(1.0f, 2.0f, 3.0f);
+    joint.rotation = glm::quat(0.5f, 0.5f, 0.5f, 0.5f);
+    joint.name = "Hips";
+    joint.isSkeletonJoint = true;
+    joint.bindTransformFoundInCluster = false;
+    joint.hasGeometricOffset = false;
+    geometry.joints << joint;
+    geometry.jointIndices.insert(joint.name, 1);
+    geometry.rootJointIndex = 0;
+
+    FBXMesh mesh;
+    mesh.vertices << glm::vec3(0.0f) << glm::vec3(1.0f, 0.0f, 0.0f) << glm::vec3(0.0f, 1.0f, 0.0f);
+    mesh.normals << glm::vec3(0.0f, 0.0f, 1.0f) << glm::vec3(0.0f, 0.0f, 1.0f) << glm::vec3(0.0f, 0.0f, 1.0f);
+    FBXMeshPart part;
+    part.triangleIndices << 0 << 1 << 2;
+    part.materialID = "material";
+    mesh.parts << part;
+    FBXBlendshape blendshape;
+    blendshape.indices << 2;
+    blendshape.vertices << glm::vec3(0.0f, 0.5f, 0.0f);
+    blendshape.normals << glm::vec3(0.0f);
+    mesh.blendshapes << blendshape;
+    mesh.isEye = false;
+    mesh.meshIndex = 0;
+    geometry.meshes << mesh;
+
+    FBXMaterial material;
+    material.materialID = "material";
+    material.albedoTexture.filename = "albedo.png";
+    material.albedoTexture.texcoordSet = 0;
+    material.albedoTexture.transform.setScale(glm::vec3(2.0f));
+    material._material = std::make_shared<model::Material>();
+    material._material->setAlbedo(glm::vec3(0.25f, 0.5f, 0.75f), false);
+    material._material->setRoughness(0.3f);
+    geometry.materials.insert(material.materialID, material);
+
+    QByteArray blob;
+    QVERIFY(FBXGeometry::serialize(geometry, blob));
+    std::unique_ptr<FBXGeometry> baked(FBXGeometry::unserialize(blob.constData(), blob.size(), "model.fbx"));
+    QVERIFY((bool)baked);
+
+    QCOMPARE(baked->author, geometry.author);
+    QCOMPARE(baked->joints.size(), 1);
+    QCOMPARE(baked->joints.at(0).name, joint.name);
+    QCOMPARE(baked->joints.at(0).translation, joint.translation);
+    QCOMPARE(baked->joints.at(0).rotation, joint.rotation);
+    QCOMPARE(baked->getJointIndex("Hips"), 0);
+    QCOMPARE(baked->rootJointIndex, 0);
+
+    QCOMPARE(baked->meshes.size(), 1);
+    const FBXMesh& bakedMesh = baked->meshes.at(0);
+    QCOMPARE(bakedMesh.vertices, mesh.vertices);
+    QCOMPARE(bakedMesh.normals, mesh.normals);
+    QCOMPARE(bakedMesh.parts.at(0).triangleIndices, part.triangleIndices);
+    QCOMPARE(bakedMesh.blendshapes.at(0).vertices, blendshape.vertices);
+    QVERIFY((bool)bakedMesh._mesh);
+
+    const FBXMaterial& bakedMaterial = baked->materials.value("material");
+    QCOMPARE(bakedMaterial.albedoTexture.filename, material.albedoTexture.filename);
+    QCOMPARE(bakedMaterial.albedoTexture.transform.getScale(), glm::vec3(2.0f));
+    QVERIFY(bakedMaterial.normalTexture.isNull());
+    QVERIFY((bool)bakedMaterial._material);
+    QCOMPARE(bakedMaterial._material->getAlbedo(false), glm::vec3(0.25f, 0.5f, 0.75f));
+    QCOMPARE(bakedMaterial._material->getRoughness(), 0.3f);
+
+    QVERIFY(!FBXGeometry::unserialize(blob.constData(), blob.size() / 2, "model.fbx"));
+    QByteArray stale = blob;
+    stale[4] = stale[4] + 1; // the version follows the magic number
+    QVERIFY(!FBXGeometry::unserialize(stale.constData(), stale.size(), "model.fbx"));
+}
+
+void FBXParsingTests::benchmarkParseBinary() {
+    QVector<double> vertices;
+    QVector<int> indices;
+    QByteArray data = writeDocument({ createGeometry(BENCHMARK_VERTEX_COUNT, true, vertices, indices) }, VERSION_FBX2016);
+
+    QBENCHMARK {
+        FBXNode top = parse(data);
+        QCOMPARE(top.children.size(), 1);
+    }
+}
@@ -0,0 +1,220 @@
+//
+//  TextureProcessingTests.cpp
+//  tests/model/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureProcessingTests.h"
+
+#include <math.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <QImage>
+
+#include <CPUDetect.h>
+
+#include <model/TextureProcessing.h>
+
+QTEST_MAIN(TextureProcessingTests)
+
+// row kernels, defined in TextureProcessing.cpp and avx2/TextureProcessing_avx2.cpp
+void downsampleRow_ref(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                       int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB);
+#ifdef ARCH_X86
+void downsampleRow_AVX2(const uint8_t* row0, const uint8_t* row1, int srcWidth, uint8_t* dst, int dstWidth,
+                        int numComponents, const uint16_t* toLinear, const uint8_t* toSRGB);
+#endif
+
+static const int NUM_COMPONENTS[] = { 1, 3, 4 };
+
+static const int BENCHMARK_SIZE = 2048;
+
+// the SIMD kernel must be bit-exact, for any row width and either table
+void TextureProcessingTests::testDownsampleAVX2() {
+#ifdef ARCH_X86
+    if (!cpuSupportsAVX2()) {
+        QSKIP("AVX2 not supported");
+    }
+
+    // any monotonic pair of tables will do, padded as the kernels expect
+    std::vector<uint16_t> toLinear(256 + 2);
+    std::vector<uint8_t> toSRGB(65536 + 4);
+    for (int i = 0; i < 256; i++) {
+        toLinear[i] = (uint16_t)(powf(i / 255.0f, 2.2f) * 65535.0f + 0.5f);
+    }
+    for (int v = 0; v < 65536; v++) {
+        toSRGB[v] = (uint8_t)(powf(v / 65535.0f, 1.0f / 2.2f) * 255.0f + 0.5f);
+    }
+
+    srand(1);
+    for (int numComponents : NUM_COMPONENTS) {
+        for (int srcWidth = 1; srcWidth < 96; srcWidth++) {
+            for (bool isSRGB : { false, true }) {
+                int dstWidth = std::max(srcWidth >> 1, 1);
+
+                // exactly sized, so that a checked build catches any overread
+                std::vector<uint8_t> row0(srcWidth * numComponents), row1(srcWidth * numComponents);
+                for (auto& x : row0) {
+                    x = (uint8_t)rand();
+                }
+                for (auto& x : row1) {
+                    x = (uint8_t)rand();
+                }
+
+                const uint16_t* table = isSRGB ? toLinear.data() : nullptr;
+                std::vector<uint8_t> expected(dstWidth * numComponents), actual(dstWidth * numComponents);
+                downsampleRow_ref(row0.data(), row1.data(), srcWidth, expected.data(), dstWidth,
+                                  numComponents, table, toSRGB.data());
+                downsampleRow_AVX2(row0.data(), row1.data(), srcWidth, actual.data(), dstWidth,
+                                   numComponents, table, toSRGB.data());
+
+                for (size_t i = 0; i < expected.size(); i++) {
+                    QCOMPARE(actual[i], expected[i]);
+                }
+            }
+        }
+    }
+#else
+    QSKIP("AVX2 not supported");
+#endif
+}
+
+// linear images are a rounded 2x2 average, an odd last column is dropped
+void TextureProcessingTests::testDownsampleBox() {
+    const int srcWidth = 5;
+    const int srcHeight = 2;
+    const int srcPitch = 16;    // padded, as QImage rows are
+    gpu::Byte src[srcPitch * srcHeight] = {};
+    for (int y = 0; y < srcHeight; y++) {
+        for (int x = 0; x < srcWidth * 3; x++) {
+            src[y * srcPitch + x] = (gpu::Byte)(10 * x + 100 * y);
+        }
+    }
+
+    gpu::Byte dst[2 * 3];
+    model::TextureProcessing::downsample(src, srcWidth, srcHeight, srcPitch, 3, false, dst);
+
+    for (int x = 0; x < 2; x++) {
+        for (int c = 0; c < 3; c++) {
+            int i0 = 2 * x * 3 + c;
+            int i1 = i0 + 3;
+            int sum = src[i0] + src[i1] + src[srcPitch + i0] + src[srcPitch + i1];
+            QCOMPARE((int)dst[x * 3 + c], (sum + 2) >> 2);
+        }
+    }
+}
+
+// a uniform sRGB area keeps its exact value, through every level
+void TextureProcessingTests::testUniformSRGB() {
+    for (int v = 0; v < 256; v++) {
+        const int size = 8;
+        std::vector<gpu::Byte> image(size * size * 4);
+        for (size_t i = 0; i < image.size(); i++) {
+            image[i] = (i % 4 == 3) ? (gpu::Byte)(255 - v) : (gpu::Byte)v;
+        }
+
+        for (int width = size; width > 1; width >>= 1) {
+            std::vector<gpu::Byte> mip((width >> 1) * (width >> 1) * 4);
+            model::TextureProcessing::downsample(image.data(), width, width, width * 4, 4, true, mip.data());
+            image.swap(mip);
+        }
+
+        QCOMPARE((int)image[0], v);
+        QCOMPARE((int)image[1], v);
+        QCOMPARE((int)image[2], v);
+        QCOMPARE((int)image[3], 255 - v);
+    }
+}
+
+// mip rows are padded to 4 bytes, which GL expects by default, whatever the width and texel size
+void TextureProcessingTests::testMipRowAlignment() {
+    const int WIDTHS[] = { 3, 5, 7, 13 };
+    const int height = 6;
+
+    srand(4);
+    for (int numComponents : { 1, 3 }) {
+        gpu::Element format(numComponents == 1 ? gpu::SCALAR : gpu::VEC3, gpu::NUINT8, gpu::RGB);
+
+        for (int width : WIDTHS) {
+            int pitch = (width * numComponents + 3) & ~3;
+            std::vector<gpu::Byte> image(pitch * height);
+            for (auto& x : image) {
+                x = (gpu::Byte)rand();
+            }
+
+            std::unique_ptr<gpu::Texture> texture(gpu::Texture::create2D(format, width, height));
+            texture->assignStoredMip(0, format, image.size(), image.data());
+            model::TextureProcessing::generateMips(texture.get(), image.data(), pitch, format);
+
+            const gpu::Byte* src = image.data();
+            int srcPitch = pitch;
+            for (gpu::uint16 level = 1; level < texture->evalNumMips(); level++) {
+                int mipWidth = texture->evalMipWidth(level);
+                int mipHeight = texture->evalMipHeight(level);
+                int mipPitch = (mipWidth * numComponents + 3) & ~3;
+
+                auto mip = texture->accessStoredMipFace(level);
+                QVERIFY(mip);
+                QCOMPARE((int)mip->getSize(), mipPitch * mipHeight);
+
+                // each row holds the downsampled texels of the level above, whatever its padding
+                std::vector<gpu::Byte> expected(mipWidth * mipHeight * numComponents);
+                model::TextureProcessing::downsample(src, texture->evalMipWidth(level - 1), texture->evalMipHeight(level - 1),
+                                                     srcPitch, numComponents, false, expected.data());
+                for (int y = 0; y < mipHeight; y++) {
+                    for (int x = 0; x < mipWidth * numComponents; x++) {
+                        QCOMPARE(mip->readData()[y * mipPitch + x], expected[y * mipWidth * numComponents + x]);
+                    }
+                }
+
+                src = mip->readData();
+                srcPitch = mipPitch;
+            }
+        }
+    }
+}
+
+static QImage benchmarkImage() {
+    QImage image(BENCHMARK_SIZE, BENCHMARK_SIZE, QImage::Format_ARGB32);
+    for (int y = 0; y < BENCHMARK_SIZE; y++) {
+        QRgb* row = (QRgb*)image.scanLine(y);
+        for (int x = 0; x < BENCHMARK_SIZE; x++) {
+            row[x] = qRgba(x, y, x ^ y, 255);
+        }
+    }
+    return image;
+}
+
+// the mip chain as previously built with QImage (nearest texel, no gamma correction)
+void TextureProcessingTests::benchmarkMipsQImage() {
+    QImage source = benchmarkImage();
+    QBENCHMARK {
+        QImage image = source;
+        for (int size = BENCHMARK_SIZE >> 1; size > 0; size >>= 1) {
+            image = image.scaled(QSize(size, size));
+        }
+    }
+}
+
+// the same chain with the gamma correct box filter
+void TextureProcessingTests::benchmarkMipsDownsample() {
+    QImage source = benchmarkImage();
+    std::vector<gpu::Byte> previous, current;
+    QBENCHMARK {
+        const gpu::Byte* src = source.constBits();
+        int srcPitch = source.bytesPerLine();
+        for (int size = BENCHMARK_SIZE; size > 1; size >>= 1) {
+            current.resize((size >> 1) * (size >> 1) * 4);
+            model::TextureProcessing::downsample(src, size, size, srcPitch, 4, true, current.data());
+            previous.swap(current);
+            src = previous.data();
+            srcPitch = (size >> 1) * 4;
+        }
+    }
+}
@@ -0,0 +1,28 @@
+//
+//  TextureProcessingTests.h
+//  tests/model/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureProcessingTests_h
+#define hifi_TextureProcessingTests_h
+
+#include <QtTest/QtTest>
+
+class TextureProcessingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testDownsampleAVX2();
+    void testDownsampleBox();
+    void testUniformSRGB();
+    void testMipRowAlignment();
+    void benchmarkMipsQImage();
+    void benchmarkMipsDownsample();
+};
+
+#endif // hifi_TextureProcessingTests_h
@@ -0,0 +1,112 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <udt/LossList.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+static SequenceNumber seq(int value) {
+    return SequenceNumber(value);
+}
+
+void LossListTests::rangeTest() {
+    LossList lossList;
+    QVERIFY(lossList.isEmpty());
+
+    lossList.append(seq(10), seq(19));
+    lossList.append(seq(30));
+    lossList.append(seq(31), seq(39));
+    QCOMPARE(lossList.getLength(), 20);
+
+    // fills the gap between the two ranges, and one merged with an existing range
+    lossList.insert(seq(20), seq(29));
+    lossList.insert(seq(5), seq(12));
+    QCOMPARE(lossList.getLength(), 35);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(5));
+
+    // removing from the middle splits the range
+    QVERIFY(lossList.remove(seq(20)));
+    QVERIFY(!lossList.remove(seq(20)));
+    lossList.remove(seq(25), seq(29));
+    QCOMPARE(lossList.getLength(), 29);
+
+    // removing across ranges and gaps
+    lossList.remove(seq(0), seq(22));
+    QCOMPARE(lossList.getLength(), 12);
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(23));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(24));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(30));
+
+    lossList.remove(seq(30), seq(100));
+    QVERIFY(lossList.isEmpty());
+}
+
+void LossListTests::wrapTest() {
+    const SequenceNumber::Type MAX = SequenceNumber::MAX;
+
+    LossList lossList;
+    lossList.append(seq(MAX - 4), seq(MAX));
+    lossList.append(seq(0), seq(4));
+    QCOMPARE(lossList.getLength(), 10);
+
+    lossList.insert(seq(MAX - 9), seq(MAX - 5));
+    QCOMPARE(lossList.getLength(), 15);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(MAX - 9));
+
+    lossList.remove(seq(MAX - 1), seq(1));
+    QCOMPARE(lossList.getLength(), 11);
+
+    QVERIFY(lossList.remove(seq(MAX - 9)));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(MAX - 8));
+
+    lossList.remove(seq(MAX - 20), seq(3));
+    QCOMPARE(lossList.getLength(), 1);
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(4));
+    QVERIFY(lossList.isEmpty());
+}
+
+void LossListTests::benchmarkLossyStream() {
+    // roughly 1% of packets lost, in bursts of up to 3, and resent a window later
+    const int NUM_PACKETS = 100000;
+    const int RESEND_DELAY = 2048;
+
+    QBENCHMARK {
+        LossList lossList;
+        SequenceNumber current(SequenceNumber::MAX - NUM_PACKETS / 2);
+        quint32 random = 1;
+
+        for (int i = 0; i < NUM_PACKETS; ++i) {
+            random = random * 1664525 + 1013904223;
+            if ((random >> 24) < 3) {
+                SequenceNumber end = current;
+                end += (int)(random >> 30);
+                lossList.append(current, end);
+                current = end;
+            }
+            ++current;
+
+            if (i >= RESEND_DELAY && !lossList.isEmpty()) {
+                // the receiver gets a resend, or the sender an ACK for a run of them
+                SequenceNumber first = lossList.getFirstSequenceNumber();
+                if (random & 1) {
+                    lossList.remove(first);
+                } else {
+                    SequenceNumber last = first;
+                    last += 64;
+                    lossList.remove(first, last);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test appending, inserting and removing ranges, and that adjacent ranges merge
+    void rangeTest();
+
+    // Test ranges across the sequence number wrap
+    void wrapTest();
+
+    // Loss list throughput for a stream with sparse losses, NAKed and then resent
+    void benchmarkLossyStream();
+};
+
+#endif // hifi_LossListTests_h
@@ -0,0 +1,140 @@
+//
+//  PacketVerificationTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketVerificationTests.h"
+
+#include <QtCore/QCryptographicHash>
+
+#include <NLPacket.h>
+#include <PacketVerificationKey.h>
+
+QTEST_MAIN(PacketVerificationTests)
+
+// the reference key, 00 01 02 ... 0f
+static const QUuid REFERENCE_SECRET("{00010203-0405-0607-0809-0a0b0c0d0e0f}");
+
+static std::unique_ptr<NLPacket> createVerifiedPacket(int payloadSize) {
+    auto packet = NLPacket::create(PacketType::AvatarData);
+    for (int i = 0; i < payloadSize; i++) {
+        packet->writePrimitive((quint8)(i * 7));
+    }
+    packet->writeSourceID(QUuid::createUuid());
+    return packet;
+}
+
+void PacketVerificationTests::referenceVectorTest() {
+    PacketVerificationKey key(0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL);
+    const char message[] = { 0 };
+    char hash[PacketVerificationKey::HASH_SIZE];
+
+    key.hash(message, 0, hash);
+    QCOMPARE(QByteArray(hash, sizeof(hash)).toHex(), QByteArray("a3817f04ba25a8e66df67214c7550293"));
+
+    key.hash(message, 1, hash);
+    QCOMPARE(QByteArray(hash, sizeof(hash)).toHex(), QByteArray("da87c1d86b99af44347659119b22fc45"));
+}
+
+void PacketVerificationTests::secretKeyTest() {
+    QCOMPARE(REFERENCE_SECRET.toRfc4122().toHex(), QByteArray("000102030405060708090a0b0c0d0e0f"));
+
+    PacketVerificationKey key(0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL);
+    PacketVerificationKey secretKey(REFERENCE_SECRET);
+    QByteArray message(100, 'x');
+    char hash[PacketVerificationKey::HASH_SIZE];
+    key.hash(message.constData(), message.size(), hash);
+    QVERIFY(secretKey.matches(message.constData(), message.size(), hash));
+
+    QVERIFY(PacketVerificationKey().isNull());
+    QVERIFY(!secretKey.isNull());
+}
+
+void PacketVerificationTests::packetVerificationTest() {
+    QUuid secret = QUuid::createUuid();
+    PacketVerificationKey key(secret);
+
+    for (int payloadSize : { 0, 1, 7, 8, 9, 100, 1000 }) {
+        auto packet = createVerifiedPacket(payloadSize);
+        packet->writeVerificationHash(key);
+        QVERIFY(NLPacket::verificationHashMatches(*packet, key));
+
+        // another secret
+        QVERIFY(!NLPacket::verificationHashMatches(*packet, PacketVerificationKey(QUuid::createUuid())));
+
+        // any changed payload byte
+        if (payloadSize > 0) {
+            char* lastByte = packet->getData() + packet->getDataSize() - 1;
+            *lastByte ^= 1;
+            QVERIFY(!NLPacket::verificationHashMatches(*packet, key));
+        }
+    }
+}
+
+static const int BENCHMARK_PACKETS = 1000;
+
+static void addPayloadSizes() {
+    QTest::addColumn<int>("payloadSize");
+    QTest::newRow("small") << 64;
+    QTest::newRow("medium") << 400;
+    QTest::newRow("full") << NLPacket::maxPayloadSize(PacketType::AvatarData);
+}
+
+void PacketVerificationTests::benchmarkVerifyMD5_data() {
+    addPayloadSizes();
+}
+
+// the hash as previously computed for each packet
+static QByteArray md5ForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+
+    int offset = udt::Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
+        + NUM_BYTES_RFC4122_UUID + NUM_BYTES_VERIFICATION_HASH;
+
+    hash.addData(packet.getData() + offset, packet.getDataSize() - offset);
+    hash.addData(connectionSecret.toRfc4122());
+    return hash.result();
+}
+
+void PacketVerificationTests::benchmarkVerifyMD5() {
+    QFETCH(int, payloadSize);
+    auto packet = createVerifiedPacket(payloadSize);
+    QUuid secret = QUuid::createUuid();
+
+    int offset = NLPacket::totalHeaderSize(PacketType::AvatarData) - NUM_BYTES_VERIFICATION_HASH;
+    QByteArray expected = md5ForPacketAndSecret(*packet, secret);
+    memcpy(packet->getData() + offset, expected.constData(), NUM_BYTES_VERIFICATION_HASH);
+
+    int matches = 0;
+    QBENCHMARK {
+        for (int i = 0; i < BENCHMARK_PACKETS; i++) {
+            QByteArray headerHash(packet->getData() + offset, NUM_BYTES_VERIFICATION_HASH);
+            matches += (headerHash == md5ForPacketAndSecret(*packet, secret));
+        }
+    }
+    QVERIFY(matches > 0);
+}
+
+void PacketVerificationTests::benchmarkVerify_data() {
+    addPayloadSizes();
+}
+
+void PacketVerificationTests::benchmarkVerify() {
+    QFETCH(int, payloadSize);
+    auto packet = createVerifiedPacket(payloadSize);
+    PacketVerificationKey key(QUuid::createUuid());
+    packet->writeVerificationHash(key);
+
+    int matches = 0;
+    QBENCHMARK {
+        for (int i = 0; i < BENCHMARK_PACKETS; i++) {
+            matches += NLPacket::verificationHashMatches(*packet, key);
+        }
+    }
+    QVERIFY(matches > 0);
+}
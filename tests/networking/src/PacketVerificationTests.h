@@ -0,0 +1,35 @@
+//
+//  PacketVerificationTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketVerificationTests_h
+#define hifi_PacketVerificationTests_h
+
+#include <QtTest/QtTest>
+
+class PacketVerificationTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test the hash against the SipHash-128 reference vectors
+    void referenceVectorTest();
+
+    // Test that the key is the secret in RFC 4122 byte order
+    void secretKeyTest();
+
+    // Test that a written hash verifies, and that changes to the payload or secret do not
+    void packetVerificationTest();
+
+    // Verify throughput, for the previous MD5 hash and the keyed hash
+    void benchmarkVerifyMD5_data();
+    void benchmarkVerifyMD5();
+    void benchmarkVerify_data();
+    void benchmarkVerify();
+};
+
+#endif // hifi_PacketVerificationTests_h
@@ -0,0 +1,199 @@
+//
+//  SendSchedulerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendSchedulerTests.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <udt/SendScheduler.h>
+
+QTEST_MAIN(SendSchedulerTests)
+
+using namespace udt;
+using namespace std::chrono;
+
+using TimePoint = SendScheduler::TimePoint;
+using Wakeup = SendScheduler::Wakeup;
+
+// long enough that a queue parked this long is only processed again on activity
+static const seconds PARKED { 10 };
+
+// generous, so that a loaded machine does not fail the tests
+static const milliseconds WAIT_TIMEOUT { 2000 };
+
+// The order in which queues were processed, by their IDs
+class ProcessLog {
+public:
+    void append(int id) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _ids.push_back(id);
+    }
+    std::vector<int> getIDs() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _ids;
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<int> _ids;
+};
+
+// A queue that records when it is processed, and asks for the wakeup its policy gives for each call
+class TestQueue : public SendScheduler::Queue {
+public:
+    using Policy = std::function<Wakeup(int call, TimePoint now)>;
+
+    TestQueue(Policy policy, int id = 0, ProcessLog* log = nullptr) : _policy(policy), _id(id), _log(log) {}
+
+    Wakeup process(TimePoint now) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        int call = (int)_times.size();
+        _times.push_back(now);
+        if (_log) {
+            _log->append(_id);
+        }
+        auto wakeup = _policy(call, now);
+        _wakeups.push_back(wakeup.time);
+        _processedCondition.notify_all();
+        return wakeup;
+    }
+
+    bool isStopped() const override { return false; }
+
+    // waits until the queue has been processed this many times
+    bool waitForCalls(int numCalls, milliseconds timeout = WAIT_TIMEOUT) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _processedCondition.wait_for(lock, timeout, [&] { return (int)_times.size() >= numCalls; });
+    }
+
+    int getNumCalls() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return (int)_times.size();
+    }
+    TimePoint getTime(int call) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _times[call];
+    }
+    TimePoint getRequestedWakeup(int call) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _wakeups[call];
+    }
+
+private:
+    Policy _policy;
+    int _id;
+    ProcessLog* _log;
+
+    std::mutex _mutex;
+    std::condition_variable _processedCondition;
+    std::vector<TimePoint> _times;
+    std::vector<TimePoint> _wakeups;
+};
+
+// waits once for the given time, then parks until activity
+static TestQueue::Policy waitOnce(microseconds delay) {
+    return [delay](int call, TimePoint now) {
+        return (call == 0) ? Wakeup { now + delay, false } : Wakeup { now + PARKED, true };
+    };
+}
+
+void SendSchedulerTests::wakeupOrderTest() {
+    // a single thread, so that the order is the order of the wakeups, a few ticks apart and off the tick boundaries
+    SendScheduler scheduler(1);
+    ProcessLog log;
+
+    const microseconds DELAYS[] = { microseconds(8050), microseconds(2050), microseconds(6050), microseconds(4050) };
+    const std::vector<int> EXPECTED_ORDER = { 1, 3, 2, 0 };
+
+    std::vector<std::unique_ptr<TestQueue>> queues;
+    for (int i = 0; i < 4; ++i) {
+        queues.emplace_back(new TestQueue(waitOnce(DELAYS[i]), i, &log));
+    }
+    for (auto& queue : queues) {
+        scheduler.add(queue.get());
+    }
+
+    for (auto& queue : queues) {
+        QVERIFY(queue->waitForCalls(2));
+    }
+
+    // each was added and processed once right away, then once more at its wakeup
+    auto ids = log.getIDs();
+    QCOMPARE((int)ids.size(), 8);
+    QVERIFY(std::vector<int>(ids.begin() + 4, ids.end()) == EXPECTED_ORDER);
+
+    for (auto& queue : queues) {
+        QVERIFY(queue->getTime(1) >= queue->getRequestedWakeup(0));
+        scheduler.remove(queue.get());
+    }
+}
+
+void SendSchedulerTests::activityWakeTest() {
+    SendScheduler scheduler(2);
+
+    // waiting for activity, processed again as soon as there is some
+    TestQueue waiting([](int call, TimePoint now) { return Wakeup { now + PARKED, true }; });
+    scheduler.add(&waiting);
+    QVERIFY(waiting.waitForCalls(1));
+    std::this_thread::sleep_for(milliseconds(5));
+    QCOMPARE(waiting.getNumCalls(), 1);
+
+    scheduler.wake(&waiting);
+    QVERIFY(waiting.waitForCalls(2));
+    QVERIFY(waiting.getTime(1) < waiting.getRequestedWakeup(0));
+
+    // activity while it is being processed, which the scheduler can only see once the processing is done
+    SendScheduler* schedulerPointer = &scheduler;
+    TestQueue* busyPointer = nullptr;
+    TestQueue busy([&](int call, TimePoint now) {
+        if (call == 0) {
+            schedulerPointer->wake(busyPointer);
+        }
+        return Wakeup { now + PARKED, true };
+    });
+    busyPointer = &busy;
+    scheduler.add(&busy);
+    QVERIFY(busy.waitForCalls(2));
+
+    // waiting for a time, activity does not bring it forward
+    const milliseconds DELAY { 50 };
+    TestQueue timed(waitOnce(DELAY));
+    scheduler.add(&timed);
+    QVERIFY(timed.waitForCalls(1));
+    scheduler.wake(&timed);
+    QVERIFY(timed.waitForCalls(2));
+    QVERIFY(timed.getTime(1) >= timed.getRequestedWakeup(0));
+
+    scheduler.remove(&waiting);
+    scheduler.remove(&busy);
+    scheduler.remove(&timed);
+}
+
+void SendSchedulerTests::timeoutWaitTest() {
+    SendScheduler scheduler(1);
+
+    // waits for activity, but no longer than the timeout
+    const milliseconds TIMEOUT { 20 };
+    TestQueue queue([&](int call, TimePoint now) {
+        return (call == 0) ? Wakeup { now + TIMEOUT, true } : Wakeup { now + PARKED, true };
+    });
+    scheduler.add(&queue);
+
+    QVERIFY(queue.waitForCalls(2));
+    QVERIFY(queue.getTime(1) >= queue.getRequestedWakeup(0));
+    QVERIFY(queue.getTime(1) - queue.getTime(0) < WAIT_TIMEOUT);
+
+    scheduler.remove(&queue);
+}
@@ -0,0 +1,30 @@
+//
+//  SendSchedulerTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendSchedulerTests_h
+#define hifi_SendSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class SendSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that queues are processed in the order of their wakeups, and never before them
+    void wakeupOrderTest();
+
+    // Test that activity wakes a queue waiting for it, including activity during its processing,
+    // and does not wake a queue waiting for a time
+    void activityWakeTest();
+
+    // Test that a queue waiting for activity is still processed at its timeout
+    void timeoutWaitTest();
+};
+
+#endif // hifi_SendSchedulerTests_h
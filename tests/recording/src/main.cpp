@@ -9,6 +9,7 @@
 
 #include <recording/Clip.h>
 #include <recording/Frame.h>
+#include <recording/impl/PointerClip.h>
 
 #include "Constants.h"
 
@@ -97,6 +98,51 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void verifyIndexedClip(const QString& fileName, int frameCount) {
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == (size_t)frameCount);
+
+    for (int i = 0; i < frameCount; i += 997) {
+        // on a frame
+        readClip->seekFrameTime(i * 10);
+        QVERIFY(readClip->positionFrameTime() == (Frame::Time)(i * 10));
+        QVERIFY(readClip->nextFrame()->data == QByteArray::number(i));
+
+        // between frames
+        readClip->seekFrameTime(i * 10 + 5);
+        if (i + 1 < frameCount) {
+            QVERIFY(readClip->positionFrameTime() == (Frame::Time)((i + 1) * 10));
+            QVERIFY(readClip->nextFrame()->data == QByteArray::number(i + 1));
+        } else {
+            QVERIFY(readClip->positionFrameTime() == Frame::INVALID_TIME);
+        }
+    }
+}
+
+void testIndexedClip() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // enough frames to need several index frames
+    static const int FRAME_COUNT = 10000;
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * 10), QByteArray::number(i)));
+    }
+    Clip::toFile(fileName, writeClip);
+    verifyIndexedClip(fileName, FRAME_COUNT);
+
+    // without the footer the index is not found, and the frames are parsed like in clips written before it
+    QFile truncatedFile(fileName);
+    QVERIFY(truncatedFile.resize(truncatedFile.size() - (FRAME_HEADER_SIZE + sizeof(ClipIndexFooter))));
+    verifyIndexedClip(fileName, FRAME_COUNT);
+}
+
 #ifdef Q_OS_WIN32
 void myMessageHandler(QtMsgType type, const QMessageLogContext & context, const QString & msg) {
     OutputDebugStringA(msg.toLocal8Bit().toStdString().c_str());
@@ -111,4 +157,5 @@ int main(int, const char**) {
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testIndexedClip();
 }
\ No newline at end of file
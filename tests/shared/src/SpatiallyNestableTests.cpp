@@ -0,0 +1,115 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <DependencyManager.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SpatiallyNestable.h>
+
+#include <../GLMTestUtils.h>
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+const quint16 NO_JOINT_INDEX = (quint16)-1;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree = nullptr) const override {
+        SpatiallyNestableWeakPointer parent = _nestables.value(parentID);
+        success = parentID.isNull() || !parent.expired();
+        return parent;
+    }
+
+    QHash<QUuid, SpatiallyNestableWeakPointer> _nestables;
+};
+
+static SpatiallyNestablePointer createNestable(const QUuid& parentID = QUuid()) {
+    auto nestable = std::make_shared<SpatiallyNestable>(NestableType::Entity, QUuid::createUuid());
+    nestable->setParentID(parentID);
+    nestable->setParentJointIndex(NO_JOINT_INDEX);
+    DependencyManager::get<TestParentFinder>()->_nestables[nestable->getID()] = nestable;
+    return nestable;
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+    DependencyManager::set<TestParentFinder>();
+}
+
+void SpatiallyNestableTests::childFollowsParent() {
+    auto parent = createNestable();
+    auto child = createNestable(parent->getID());
+    auto grandchild = createNestable(child->getID());
+
+    child->setLocalPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    grandchild->setLocalPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+
+    bool success;
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getPosition(success), glm::vec3(1.0f, 1.0f, 0.0f), EPSILON);
+    QVERIFY(success);
+
+    // read again, so the transforms come from the caches, then move the root
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getPosition(success), glm::vec3(1.0f, 1.0f, 0.0f), EPSILON);
+    parent->setPosition(glm::vec3(0.0f, 0.0f, 10.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getPosition(success), glm::vec3(1.0f, 0.0f, 10.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getPosition(success), glm::vec3(1.0f, 1.0f, 10.0f), EPSILON);
+
+    // rotate the middle of the chain a quarter turn about z
+    child->setLocalOrientation(glm::angleAxis(PI_OVER_TWO, Vectors::UNIT_Z));
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getPosition(success), glm::vec3(0.0f, 0.0f, 10.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(parent->getPosition(success), glm::vec3(0.0f, 0.0f, 10.0f), EPSILON);
+
+    // setting a world position on a child is relative to the cached parent
+    grandchild->setPosition(glm::vec3(5.0f, 5.0f, 5.0f));
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getPosition(success), glm::vec3(5.0f, 5.0f, 5.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getLocalPosition(), glm::vec3(5.0f, -4.0f, -5.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::reparenting() {
+    auto parentA = createNestable();
+    auto parentB = createNestable();
+    auto child = createNestable(parentA->getID());
+
+    parentA->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    parentB->setPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+    child->setLocalPosition(glm::vec3(0.0f, 0.0f, 3.0f));
+
+    bool success;
+    QCOMPARE_WITH_ABS_ERROR(child->getPosition(success), glm::vec3(1.0f, 0.0f, 3.0f), EPSILON);
+
+    child->setParentID(parentB->getID());
+    QCOMPARE_WITH_ABS_ERROR(child->getPosition(success), glm::vec3(0.0f, 2.0f, 3.0f), EPSILON);
+    QVERIFY(success);
+
+    // the old parent no longer moves it
+    parentA->setPosition(glm::vec3(-1.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getPosition(success), glm::vec3(0.0f, 2.0f, 3.0f), EPSILON);
+
+    child->setParentID(QUuid());
+    QCOMPARE_WITH_ABS_ERROR(child->getPosition(success), glm::vec3(0.0f, 0.0f, 3.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::deletedParent() {
+    auto parent = createNestable();
+    auto child = createNestable(parent->getID());
+
+    parent->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+
+    bool success;
+    child->getPosition(success);
+    QVERIFY(success);
+
+    parent.reset();
+    child->getPosition(success);
+    QVERIFY(!success);
+}
@@ -0,0 +1,204 @@
+//
+//  LossyLink.cpp
+//  tools/udt-sim/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossyLink.h"
+
+#include <algorithm>
+#include <functional>
+
+using namespace std::chrono;
+
+void LossyLinkSocket::relay(QByteArray datagram) {
+    writeDatagram(datagram, _destination.getAddress(), _destination.getPort());
+}
+
+LossyLink::LossyLink(const Parameters& parameters, quint32 seed) :
+    _parameters(parameters),
+    _firstSide(new LossyLinkSocket),
+    _secondSide(new LossyLinkSocket)
+{
+    _readThread.setObjectName("LossyLink");
+
+    _firstSide->bind(QHostAddress::LocalHost);
+    _secondSide->bind(QHostAddress::LocalHost);
+
+    // the link buffers the datagrams itself, make sure the socket buffers are not what drops them
+    static const int SOCKET_BUFFER_BYTES = 1 << 22;
+    for (auto socket : { _firstSide, _secondSide }) {
+        socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, SOCKET_BUFFER_BYTES);
+        socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, SOCKET_BUFFER_BYTES);
+    }
+
+    _towardsSecond.in = _firstSide;
+    _towardsSecond.out = _secondSide;
+    _towardsSecond.generator.seed(seed);
+
+    _towardsFirst.in = _secondSide;
+    _towardsFirst.out = _firstSide;
+    _towardsFirst.generator.seed(seed + 1);
+}
+
+LossyLink::~LossyLink() {
+    stop();
+
+    delete _firstSide;
+    delete _secondSide;
+}
+
+void LossyLink::start(const HifiSockAddr& firstEndpoint, const HifiSockAddr& secondEndpoint) {
+    _firstSide->setDestination(firstEndpoint);
+    _secondSide->setDestination(secondEndpoint);
+
+    // read on our own thread, the sockets are the context so the reads run there
+    _firstSide->moveToThread(&_readThread);
+    _secondSide->moveToThread(&_readThread);
+    connect(_firstSide, &QUdpSocket::readyRead, _firstSide, [this] { readPendingDatagrams(_towardsSecond); });
+    connect(_secondSide, &QUdpSocket::readyRead, _secondSide, [this] { readPendingDatagrams(_towardsFirst); });
+    _readThread.start();
+
+    // deliver on another, that waits for the next delivery time
+    _deliveryThread = std::thread([this] { deliverDatagrams(); });
+}
+
+void LossyLink::stop() {
+    if (_deliveryThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> locker(_mutex);
+            _isStopping = true;
+        }
+        _pendingCondition.notify_one();
+        _deliveryThread.join();
+    }
+
+    if (_readThread.isRunning()) {
+        _readThread.quit();
+        _readThread.wait();
+    }
+}
+
+HifiSockAddr LossyLink::getFirstSideAddress() const {
+    return HifiSockAddr(QHostAddress::LocalHost, _firstSide->localPort());
+}
+
+HifiSockAddr LossyLink::getSecondSideAddress() const {
+    return HifiSockAddr(QHostAddress::LocalHost, _secondSide->localPort());
+}
+
+LossyLink::Stats LossyLink::getStats(bool towardsSecond) const {
+    std::lock_guard<std::mutex> locker(_mutex);
+    return towardsSecond ? _towardsSecond.stats : _towardsFirst.stats;
+}
+
+bool LossyLink::shouldLose(Direction& direction) {
+    if (_parameters.lossRate <= 0.0) {
+        return false;
+    }
+
+    // two state (Gilbert) model: every packet in a burst is lost, bursts have a geometric length with the given mean,
+    // and start often enough for the average loss rate
+    double meanBurst = std::max(_parameters.meanLossBurst, 1.0);
+    double lossRate = std::min(_parameters.lossRate, 0.99);
+
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    if (direction.isInLossBurst) {
+        direction.isInLossBurst = distribution(direction.generator) >= 1.0 / meanBurst;
+    } else {
+        direction.isInLossBurst = distribution(direction.generator) < lossRate / (meanBurst * (1.0 - lossRate));
+    }
+    return direction.isInLossBurst;
+}
+
+void LossyLink::readPendingDatagrams(Direction& direction) {
+    bool hasNewDatagrams = false;
+
+    while (direction.in->hasPendingDatagrams()) {
+        QByteArray data(direction.in->pendingDatagramSize(), 0);
+        direction.in->readDatagram(data.data(), data.size());
+
+        auto now = p_high_resolution_clock::now();
+
+        std::lock_guard<std::mutex> locker(_mutex);
+
+        if (shouldLose(direction)) {
+            ++direction.stats.lostPackets;
+            continue;
+        }
+
+        // the packet waits for those in front of it to go through the bottleneck, if there is room in its queue
+        auto departureTime = now;
+        if (_parameters.bandwidthKbps > 0) {
+            while (!direction.departureTimes.empty() && direction.departureTimes.front() <= now) {
+                direction.departureTimes.pop_front();
+            }
+            if ((int)direction.departureTimes.size() >= _parameters.queuePackets) {
+                ++direction.stats.queueDroppedPackets;
+                continue;
+            }
+
+            auto transmitTime = microseconds((qint64)data.size() * 8 * 1000 / _parameters.bandwidthKbps);
+            departureTime = std::max(now, direction.linkFreeTime) + transmitTime;
+            direction.linkFreeTime = departureTime;
+            direction.departureTimes.push_back(departureTime);
+        }
+
+        auto delayUsecs = _parameters.latencyUsecs;
+        if (_parameters.jitterUsecs > 0) {
+            std::uniform_int_distribution<int> jitter(-_parameters.jitterUsecs, _parameters.jitterUsecs);
+            delayUsecs = std::max(delayUsecs + jitter(direction.generator), 0);
+        }
+        if (_parameters.reorderRate > 0.0 &&
+            std::uniform_real_distribution<double>(0.0, 1.0)(direction.generator) < _parameters.reorderRate) {
+            // held back long enough for the following packets to pass it
+            delayUsecs += std::max(_parameters.latencyUsecs, 1000);
+            ++direction.stats.reorderedPackets;
+        }
+
+        direction.pending.push_back({ departureTime + microseconds(delayUsecs), direction.numDatagrams++, std::move(data) });
+        std::push_heap(direction.pending.begin(), direction.pending.end(), std::greater<Datagram>());
+        hasNewDatagrams = true;
+    }
+
+    if (hasNewDatagrams) {
+        _pendingCondition.notify_one();
+    }
+}
+
+void LossyLink::deliverDatagrams() {
+    std::unique_lock<std::mutex> locker(_mutex);
+
+    while (!_isStopping) {
+        auto now = p_high_resolution_clock::now();
+        TimePoint nextDeliveryTime = TimePoint::max();
+
+        for (auto direction : { &_towardsSecond, &_towardsFirst }) {
+            auto& pending = direction->pending;
+            while (!pending.empty() && pending.front().deliveryTime <= now) {
+                std::pop_heap(pending.begin(), pending.end(), std::greater<Datagram>());
+                auto datagram = std::move(pending.back());
+                pending.pop_back();
+                ++direction->stats.relayedPackets;
+
+                // the socket is read on the read thread, it is written there too
+                QMetaObject::invokeMethod(direction->out, "relay", Qt::QueuedConnection,
+                                          Q_ARG(QByteArray, datagram.data));
+            }
+
+            if (!pending.empty()) {
+                nextDeliveryTime = std::min(nextDeliveryTime, pending.front().deliveryTime);
+            }
+        }
+
+        if (nextDeliveryTime == TimePoint::max()) {
+            _pendingCondition.wait(locker);
+        } else {
+            _pendingCondition.wait_for(locker, nextDeliveryTime - p_high_resolution_clock::now());
+        }
+    }
+}
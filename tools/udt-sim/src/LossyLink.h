@@ -0,0 +1,123 @@
+//
+//  LossyLink.h
+//  tools/udt-sim/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossyLink_h
+#define hifi_LossyLink_h
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QThread>
+#include <QtNetwork/QUdpSocket>
+
+#include <HifiSockAddr.h>
+#include <PortableHighResolutionClock.h>
+
+// One side of the link. The link writes through it with queued calls, so that it is only used on its own thread.
+class LossyLinkSocket : public QUdpSocket {
+    Q_OBJECT
+public:
+    void setDestination(const HifiSockAddr& destination) { _destination = destination; }
+
+public slots:
+    void relay(QByteArray datagram);
+
+private:
+    HifiSockAddr _destination;
+};
+
+// Relays datagrams between two local endpoints over loopback, as a link with latency, jitter, loss,
+// reordering and a bandwidth cap would. Each direction is simulated on its own, with seeded random numbers
+// so that runs with the same parameters are repeatable.
+class LossyLink : public QObject {
+    Q_OBJECT
+public:
+    struct Parameters {
+        int latencyUsecs { 0 }; // one way
+        int jitterUsecs { 0 }; // added to the latency, uniform in [-jitter, jitter]
+        double lossRate { 0.0 };
+        double meanLossBurst { 1.0 }; // mean number of packets lost in a row, from a two state loss model
+        double reorderRate { 0.0 }; // ratio of packets held back for an extra latency, and passed by the next ones
+        int bandwidthKbps { 0 }; // 0 is not limited
+        int queuePackets { 1000 }; // drop-tail queue in front of the bandwidth cap
+    };
+
+    struct Stats {
+        quint64 relayedPackets { 0 };
+        quint64 lostPackets { 0 };
+        quint64 queueDroppedPackets { 0 };
+        quint64 reorderedPackets { 0 };
+    };
+
+    LossyLink(const Parameters& parameters, quint32 seed);
+    ~LossyLink();
+
+    // datagrams sent to the first side are relayed to the second endpoint, and datagrams the second endpoint sends
+    // to the second side are relayed to the first endpoint
+    void start(const HifiSockAddr& firstEndpoint, const HifiSockAddr& secondEndpoint);
+    void stop();
+
+    HifiSockAddr getFirstSideAddress() const;
+    HifiSockAddr getSecondSideAddress() const;
+
+    Stats getStats(bool towardsSecond) const;
+
+private:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    struct Datagram {
+        TimePoint deliveryTime;
+        quint64 order;
+        QByteArray data;
+
+        bool operator>(const Datagram& other) const {
+            return deliveryTime > other.deliveryTime || (deliveryTime == other.deliveryTime && order > other.order);
+        }
+    };
+
+    struct Direction {
+        LossyLinkSocket* in { nullptr };
+        LossyLinkSocket* out { nullptr };
+
+        std::mt19937 generator;
+        bool isInLossBurst { false };
+        std::deque<TimePoint> departureTimes; // of the packets in the bottleneck queue
+        TimePoint linkFreeTime;
+        quint64 numDatagrams { 0 };
+
+        std::vector<Datagram> pending; // heap by delivery time
+        Stats stats;
+    };
+
+    void readPendingDatagrams(Direction& direction);
+    bool shouldLose(Direction& direction);
+    void deliverDatagrams();
+
+    const Parameters _parameters;
+
+    QThread _readThread;
+    LossyLinkSocket* _firstSide; // live on the read thread
+    LossyLinkSocket* _secondSide;
+
+    Direction _towardsSecond;
+    Direction _towardsFirst;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _pendingCondition;
+    std::thread _deliveryThread;
+    bool _isStopping { false };
+};
+
+#endif // hifi_LossyLink_h
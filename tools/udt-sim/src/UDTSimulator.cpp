@@ -0,0 +1,416 @@
+//
+//  UDTSimulator.cpp
+//  tools/udt-sim/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UDTSimulator.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+
+#include <udt/Constants.h>
+#include <udt/Packet.h>
+#include <udt/PacketList.h>
+
+#include <LogHandler.h>
+
+const QCommandLineOption MODE_OPTION {
+    "mode", "what to send: reliable (packets), unreliable (packets) or messages (default is reliable)", "mode"
+};
+const QCommandLineOption DURATION_OPTION { "duration", "seconds to send for (default is 10)", "seconds" };
+const QCommandLineOption PACKET_SIZE_OPTION {
+    "packet-size", "size for sent packets in bytes (defaults to " + QString::number(udt::MAX_PACKET_SIZE) + ")", "bytes"
+};
+const QCommandLineOption MESSAGE_SIZE_OPTION { "message-size", "bytes per message (default is 100000)", "bytes" };
+const QCommandLineOption WINDOW_OPTION {
+    "window", "bytes sent but not yet delivered, when sending reliably (default is 1000000)", "bytes"
+};
+const QCommandLineOption SEND_RATE_OPTION {
+    "send-rate", "megabits per second sent, when sending unreliable packets (default is 10)", "Mb/s"
+};
+const QCommandLineOption LATENCY_OPTION { "latency", "one way latency of the link (default is 0)", "milliseconds" };
+const QCommandLineOption JITTER_OPTION { "jitter", "jitter added to the latency (default is 0)", "milliseconds" };
+const QCommandLineOption LOSS_OPTION { "loss", "packets lost by the link (default is 0)", "percent" };
+const QCommandLineOption LOSS_BURST_OPTION { "loss-burst", "mean number of packets lost in a row (default is 1)", "packets" };
+const QCommandLineOption REORDER_OPTION { "reorder", "packets reordered by the link (default is 0)", "percent" };
+const QCommandLineOption BANDWIDTH_OPTION {
+    "bandwidth", "bandwidth of the link in each direction (default is not limited)", "Mb/s"
+};
+const QCommandLineOption QUEUE_OPTION {
+    "queue", "packets queued in front of the bandwidth limit before dropping (default is 1000)", "packets"
+};
+const QCommandLineOption CONGESTION_CONTROL_OPTION {
+    "congestion-control", "congestion control of both sockets: vegas, bbr or udt (default is vegas)", "name"
+};
+const QCommandLineOption SEED_OPTION { "seed", "seed for the link's random numbers (default is 742272)", "integer" };
+const QCommandLineOption STATS_INTERVAL_OPTION {
+    "stats-interval", "progress output interval (default is 1000ms)", "milliseconds"
+};
+
+// each payload starts with its index and the time it was sent
+static const int PAYLOAD_HEADER_SIZE = sizeof(quint64) + sizeof(qint64);
+
+static const int SEND_INTERVAL_MSECS = 1;
+static const int DRAIN_CHECK_INTERVAL_MSECS = 10;
+static const int MAX_DRAIN_MSECS = 5000;
+
+static const double MEGABITS_PER_BYTE = 8.0 / 1000000.0;
+static const double BYTES_PER_MEGABYTE = 1000000.0;
+
+UDTSimulator::UDTSimulator(int& argc, char** argv) :
+    QCoreApplication(argc, argv)
+{
+    qInstallMessageHandler(LogHandler::verboseMessageHandler);
+
+    parseArguments();
+
+    LossyLink::Parameters linkParameters;
+
+    if (_argumentParser.isSet(MODE_OPTION)) {
+        auto mode = _argumentParser.value(MODE_OPTION);
+        if (mode == "unreliable") {
+            _mode = Mode::Unreliable;
+        } else if (mode == "messages") {
+            _mode = Mode::Messages;
+        } else if (mode != "reliable") {
+            qCritical() << "Unknown mode" << mode << "- it must be reliable, unreliable or messages.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+            return;
+        }
+    }
+
+    if (_argumentParser.isSet(DURATION_OPTION)) {
+        _durationSecs = _argumentParser.value(DURATION_OPTION).toInt();
+    }
+    if (_argumentParser.isSet(PACKET_SIZE_OPTION)) {
+        _packetSize = std::min(_argumentParser.value(PACKET_SIZE_OPTION).toInt(), udt::MAX_PACKET_SIZE);
+    }
+    if (_argumentParser.isSet(MESSAGE_SIZE_OPTION)) {
+        _messageSize = _argumentParser.value(MESSAGE_SIZE_OPTION).toInt();
+    }
+    if (_argumentParser.isSet(WINDOW_OPTION)) {
+        _windowBytes = _argumentParser.value(WINDOW_OPTION).toInt();
+    }
+    if (_argumentParser.isSet(SEND_RATE_OPTION)) {
+        _sendRateKbps = (int)(_argumentParser.value(SEND_RATE_OPTION).toDouble() * 1000);
+    }
+    if (_argumentParser.isSet(LATENCY_OPTION)) {
+        linkParameters.latencyUsecs = (int)(_argumentParser.value(LATENCY_OPTION).toDouble() * USECS_PER_MSEC);
+    }
+    if (_argumentParser.isSet(JITTER_OPTION)) {
+        linkParameters.jitterUsecs = (int)(_argumentParser.value(JITTER_OPTION).toDouble() * USECS_PER_MSEC);
+    }
+    if (_argumentParser.isSet(LOSS_OPTION)) {
+        linkParameters.lossRate = _argumentParser.value(LOSS_OPTION).toDouble() / 100.0;
+    }
+    if (_argumentParser.isSet(LOSS_BURST_OPTION)) {
+        linkParameters.meanLossBurst = _argumentParser.value(LOSS_BURST_OPTION).toDouble();
+    }
+    if (_argumentParser.isSet(REORDER_OPTION)) {
+        linkParameters.reorderRate = _argumentParser.value(REORDER_OPTION).toDouble() / 100.0;
+    }
+    if (_argumentParser.isSet(BANDWIDTH_OPTION)) {
+        linkParameters.bandwidthKbps = (int)(_argumentParser.value(BANDWIDTH_OPTION).toDouble() * 1000);
+    }
+    if (_argumentParser.isSet(QUEUE_OPTION)) {
+        linkParameters.queuePackets = _argumentParser.value(QUEUE_OPTION).toInt();
+    }
+    if (_argumentParser.isSet(STATS_INTERVAL_OPTION)) {
+        _statsIntervalMsecs = _argumentParser.value(STATS_INTERVAL_OPTION).toInt();
+    }
+
+    static const quint32 DEFAULT_SEED = 742272;
+    quint32 seed = _argumentParser.isSet(SEED_OPTION) ? _argumentParser.value(SEED_OPTION).toUInt() : DEFAULT_SEED;
+
+    if (_packetSize - udt::Packet::localHeaderSize(false) < PAYLOAD_HEADER_SIZE || _messageSize < PAYLOAD_HEADER_SIZE) {
+        qCritical() << "Packets and messages must have room for a" << PAYLOAD_HEADER_SIZE << "byte payload header.";
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL_OPTION)) {
+        // the receiver's congestion control picks how often it ACKs, so both use the same one
+        auto congestionControl = _argumentParser.value(CONGESTION_CONTROL_OPTION);
+        if (!_sender.setCongestionControl(congestionControl) || !_receiver.setCongestionControl(congestionControl)) {
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+            return;
+        }
+    }
+
+    // sender -> first side of the link -> receiver, and back
+    _sender.bind(QHostAddress::LocalHost);
+    _receiver.bind(QHostAddress::LocalHost);
+
+    _link.reset(new LossyLink(linkParameters, seed));
+    _link->start(HifiSockAddr(QHostAddress::LocalHost, _sender.localPort()),
+                 HifiSockAddr(QHostAddress::LocalHost, _receiver.localPort()));
+    _target = _link->getFirstSideAddress();
+
+    if (_mode == Mode::Messages) {
+        _receiver.setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
+            handleReceivedMessagePacket(std::move(packet));
+        });
+        _receiver.setMessageFailureHandler([this](HifiSockAddr from, udt::Packet::MessageNumber messageNumber) {
+            _pendingMessages.erase(messageNumber);
+        });
+    } else {
+        _receiver.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+            handleReceivedPacket(std::move(packet));
+        });
+    }
+
+    qDebug() << "Sending for" << _durationSecs << "seconds from" << _sender.localPort() << "to" << _receiver.localPort()
+        << "through a link with" << linkParameters.latencyUsecs << "us latency," << linkParameters.jitterUsecs << "us jitter,"
+        << linkParameters.lossRate * 100.0 << "% loss," << linkParameters.reorderRate * 100.0 << "% reordering and"
+        << linkParameters.bandwidthKbps << "kb/s bandwidth (0 is not limited)";
+
+    _clock.start();
+    _startCPU = std::clock();
+
+    connect(&_sendTimer, &QTimer::timeout, this, &UDTSimulator::sendMore);
+    _sendTimer.setTimerType(Qt::PreciseTimer);
+    _sendTimer.start(SEND_INTERVAL_MSECS);
+
+    QTimer* statsTimer = new QTimer(this);
+    connect(statsTimer, &QTimer::timeout, this, &UDTSimulator::sampleStats);
+    statsTimer->start(_statsIntervalMsecs);
+
+    QTimer::singleShot(_durationSecs * MSECS_PER_SECOND, this, &UDTSimulator::finishSending);
+
+    sendMore();
+}
+
+void UDTSimulator::parseArguments() {
+    // use a QCommandLineParser to setup command line arguments and give helpful output
+    _argumentParser.setApplicationDescription("High Fidelity UDT Protocol Link Simulator");
+
+    const QCommandLineOption helpOption = _argumentParser.addHelpOption();
+
+    _argumentParser.addOptions({
+        MODE_OPTION, DURATION_OPTION, PACKET_SIZE_OPTION, MESSAGE_SIZE_OPTION, WINDOW_OPTION, SEND_RATE_OPTION,
+        LATENCY_OPTION, JITTER_OPTION, LOSS_OPTION, LOSS_BURST_OPTION, REORDER_OPTION, BANDWIDTH_OPTION, QUEUE_OPTION,
+        CONGESTION_CONTROL_OPTION, SEED_OPTION, STATS_INTERVAL_OPTION
+    });
+
+    if (!_argumentParser.parse(arguments())) {
+        qCritical() << _argumentParser.errorText();
+        _argumentParser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (_argumentParser.isSet(helpOption)) {
+        _argumentParser.showHelp();
+        Q_UNREACHABLE();
+    }
+}
+
+void UDTSimulator::writeHeader(char* payload, quint64 index) const {
+    qint64 sendUsecs = _clock.nsecsElapsed() / NSECS_PER_USEC;
+    memcpy(payload, &index, sizeof(index));
+    memcpy(payload + sizeof(index), &sendUsecs, sizeof(sendUsecs));
+}
+
+void UDTSimulator::recordLatency(const char* payload) {
+    qint64 sendUsecs;
+    memcpy(&sendUsecs, payload + sizeof(quint64), sizeof(sendUsecs));
+
+    _lastReceiveUsecs = _clock.nsecsElapsed() / NSECS_PER_USEC;
+    _latenciesUsecs.push_back(_lastReceiveUsecs - sendUsecs);
+}
+
+void UDTSimulator::sendMore() {
+    if (!_isSending) {
+        return;
+    }
+
+    if (_mode == Mode::Unreliable) {
+        // keep to the send rate
+        qint64 nowUsecs = _clock.nsecsElapsed() / NSECS_PER_USEC;
+        _unreliableBytesOwed += (nowUsecs - _lastSendUsecs) * _sendRateKbps / (8.0 * MSECS_PER_SECOND);
+        _lastSendUsecs = nowUsecs;
+
+        while (_unreliableBytesOwed >= _packetSize) {
+            sendPacket();
+            _unreliableBytesOwed -= _packetSize;
+        }
+    } else {
+        // keep the window full
+        while (_bytesSent - _bytesReceived < (quint64)_windowBytes) {
+            if (_mode == Mode::Messages) {
+                sendMessage();
+            } else {
+                sendPacket();
+            }
+        }
+    }
+}
+
+void UDTSimulator::sendPacket() {
+    bool isReliable = _mode == Mode::Reliable;
+    int payloadSize = _packetSize - udt::Packet::localHeaderSize(false);
+
+    auto packet = udt::Packet::create(payloadSize, isReliable);
+    packet->setPayloadSize(payloadSize);
+    writeHeader(packet->getPayload(), _numSent);
+
+    ++_numSent;
+    _bytesSent += payloadSize;
+
+    if (isReliable) {
+        _sender.writePacket(std::move(packet), _target);
+    } else {
+        _sender.writePacket(*packet, _target);
+    }
+}
+
+void UDTSimulator::sendMessage() {
+    auto packetList = udt::PacketList::create(PacketType::BulkAvatarData, QByteArray(), true, true);
+
+    QByteArray message(_messageSize, 0);
+    writeHeader(message.data(), _numSent);
+    packetList->write(message);
+    packetList->closeCurrentPacket();
+
+    ++_numSent;
+    _bytesSent += _messageSize;
+
+    _sender.writePacketList(std::move(packetList), _target);
+}
+
+void UDTSimulator::handleReceivedPacket(std::unique_ptr<udt::Packet> packet) {
+    recordLatency(packet->getPayload());
+
+    ++_numReceived;
+    _bytesReceived += packet->getPayloadSize();
+
+    sendMore();
+}
+
+void UDTSimulator::handleReceivedMessagePacket(std::unique_ptr<udt::Packet> packet) {
+    auto position = packet->getPacketPosition();
+    auto& message = _pendingMessages[packet->getMessageNumber()];
+
+    if (position == udt::Packet::FIRST || position == udt::Packet::ONLY) {
+        message.header = QByteArray(packet->getPayload(), PAYLOAD_HEADER_SIZE);
+    }
+    message.size += (int)packet->getPayloadSize();
+
+    if (position == udt::Packet::LAST || position == udt::Packet::ONLY) {
+        recordLatency(message.header.constData());
+
+        ++_numReceived;
+        _bytesReceived += message.size;
+        _pendingMessages.erase(packet->getMessageNumber());
+
+        sendMore();
+    }
+}
+
+void UDTSimulator::sampleStats() {
+    qint64 nowUsecs = _clock.nsecsElapsed() / NSECS_PER_USEC;
+    double goodput = (_bytesReceived - _lastSampleBytesReceived) * MEGABITS_PER_BYTE * USECS_PER_SECOND
+        / std::max(nowUsecs - _lastSampleUsecs, (qint64)1);
+    _lastSampleBytesReceived = _bytesReceived;
+    _lastSampleUsecs = nowUsecs;
+
+    for (auto& connectionStats : _sender.sampleStatsForAllConnections()) {
+        auto& stats = connectionStats.second;
+        _sentPackets += stats.sentPackets;
+        _retransmittedPackets += stats.events[udt::ConnectionStats::Stats::Retransmission];
+        _sentBytes += stats.sentBytes;
+
+        qDebug() << qPrintable(QString("%1s: %2 Mb/s goodput, RTT %3 ms, CW %4 packets, period %5 us, %6 retransmitted")
+            .arg(nowUsecs / (double)USECS_PER_SECOND, 0, 'f', 1)
+            .arg(goodput, 0, 'f', 2)
+            .arg(stats.rtt / (double)USECS_PER_MSEC, 0, 'f', 2)
+            .arg(stats.congestionWindowSize)
+            .arg(stats.packetSendPeriod)
+            .arg(stats.events[udt::ConnectionStats::Stats::Retransmission]));
+    }
+}
+
+void UDTSimulator::finishSending() {
+    _isSending = false;
+    _sendTimer.stop();
+
+    if (_mode == Mode::Unreliable) {
+        // give what is in flight time to arrive
+        QTimer::singleShot(MAX_DRAIN_MSECS / 10, this, &UDTSimulator::report);
+        return;
+    }
+
+    // wait for what is in flight to be delivered, for a while
+    QElapsedTimer* drainTimer = new QElapsedTimer;
+    drainTimer->start();
+
+    QTimer* drainCheckTimer = new QTimer(this);
+    connect(drainCheckTimer, &QTimer::timeout, this, [this, drainTimer, drainCheckTimer] {
+        if (_bytesReceived >= _bytesSent || drainTimer->elapsed() > MAX_DRAIN_MSECS) {
+            drainCheckTimer->stop();
+            delete drainTimer;
+            report();
+        }
+    });
+    drainCheckTimer->start(DRAIN_CHECK_INTERVAL_MSECS);
+}
+
+void UDTSimulator::report() {
+    double cpuMsecs = (std::clock() - _startCPU) * (double)MSECS_PER_SECOND / CLOCKS_PER_SEC;
+
+    // the last stats of the sender's connection
+    sampleStats();
+
+    _link->stop();
+    auto forwardStats = _link->getStats(true);
+    auto backwardStats = _link->getStats(false);
+
+    double seconds = std::max(_lastReceiveUsecs, (qint64)1) / (double)USECS_PER_SECOND;
+    double megabytes = _bytesReceived / BYTES_PER_MEGABYTE;
+
+    qDebug() << "";
+    qDebug() << qPrintable(QString("Delivered %1 of %2 %3 (%4 MB) in %5 s")
+        .arg(_numReceived).arg(_numSent)
+        .arg(_mode == Mode::Messages ? "messages" : (_mode == Mode::Reliable ? "reliable packets" : "unreliable packets"))
+        .arg(megabytes, 0, 'f', 2).arg(seconds, 0, 'f', 2));
+    qDebug() << qPrintable(QString("Goodput: %1 Mb/s").arg(_bytesReceived * MEGABITS_PER_BYTE / seconds, 0, 'f', 2));
+
+    if (_mode == Mode::Unreliable) {
+        qDebug() << qPrintable(QString("Lost: %1%").arg(_numSent > 0 ? 100.0 * (_numSent - _numReceived) / _numSent : 0.0,
+                                                         0, 'f', 2));
+    } else {
+        qDebug() << qPrintable(QString("Retransmissions: %1 of %2 packets sent (%3%), %4 MB sent")
+            .arg(_retransmittedPackets).arg(_sentPackets)
+            .arg(_sentPackets > 0 ? 100.0 * _retransmittedPackets / _sentPackets : 0.0, 0, 'f', 2)
+            .arg(_sentBytes / BYTES_PER_MEGABYTE, 0, 'f', 2));
+    }
+
+    // the link's own reads and writes are included, and on Windows clock() is wall time
+    qDebug() << qPrintable(QString("CPU: %1 ms, %2 ms per MB delivered")
+        .arg(cpuMsecs, 0, 'f', 0).arg(megabytes > 0.0 ? cpuMsecs / megabytes : 0.0, 0, 'f', 2));
+
+    if (!_latenciesUsecs.empty()) {
+        std::sort(_latenciesUsecs.begin(), _latenciesUsecs.end());
+        auto percentile = [this](double fraction) {
+            auto index = std::min((size_t)(fraction * _latenciesUsecs.size()), _latenciesUsecs.size() - 1);
+            return QString::number(_latenciesUsecs[index] / (double)USECS_PER_MSEC, 'f', 2);
+        };
+        qDebug() << qPrintable(QString("Latency (ms): p50 %1, p90 %2, p99 %3, p99.9 %4, max %5")
+            .arg(percentile(0.5)).arg(percentile(0.9)).arg(percentile(0.99)).arg(percentile(0.999))
+            .arg(percentile(1.0)));
+    }
+
+    qDebug() << qPrintable(QString("Link towards receiver: %1 relayed, %2 lost, %3 dropped by the queue, %4 reordered")
+        .arg(forwardStats.relayedPackets).arg(forwardStats.lostPackets)
+        .arg(forwardStats.queueDroppedPackets).arg(forwardStats.reorderedPackets));
+    qDebug() << qPrintable(QString("Link towards sender: %1 relayed, %2 lost, %3 dropped by the queue, %4 reordered")
+        .arg(backwardStats.relayedPackets).arg(backwardStats.lostPackets)
+        .arg(backwardStats.queueDroppedPackets).arg(backwardStats.reorderedPackets));
+
+    quit();
+}
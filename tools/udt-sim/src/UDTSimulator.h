@@ -0,0 +1,102 @@
+//
+//  UDTSimulator.h
+//  tools/udt-sim/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UDTSimulator_h
+#define hifi_UDTSimulator_h
+
+#include <ctime>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+
+#include <udt/Socket.h>
+
+#include "LossyLink.h"
+
+// Sends from one udt::Socket to another in the same process, through a LossyLink, for a set time.
+// Reports goodput, retransmissions, CPU time per megabyte and the latency of what was delivered.
+class UDTSimulator : public QCoreApplication {
+    Q_OBJECT
+public:
+    enum class Mode {
+        Reliable, // reliable packets
+        Unreliable, // unreliable packets, sent at a fixed rate
+        Messages // reliable ordered PacketLists
+    };
+
+    UDTSimulator(int& argc, char** argv);
+
+private slots:
+    void sendMore();
+    void sampleStats();
+    void finishSending();
+    void report();
+
+private:
+    void parseArguments();
+
+    void sendPacket();
+    void sendMessage();
+    void handleReceivedPacket(std::unique_ptr<udt::Packet> packet);
+    void handleReceivedMessagePacket(std::unique_ptr<udt::Packet> packet);
+
+    void writeHeader(char* payload, quint64 index) const;
+    void recordLatency(const char* payload);
+
+    QCommandLineParser _argumentParser;
+
+    Mode _mode { Mode::Reliable };
+    int _durationSecs { 10 };
+    int _packetSize { udt::MAX_PACKET_SIZE };
+    int _messageSize { 100000 };
+    int _windowBytes { 1000000 }; // sent but not yet delivered, for reliable modes
+    int _sendRateKbps { 10000 }; // for unreliable packets
+    int _statsIntervalMsecs { 1000 };
+
+    std::unique_ptr<LossyLink> _link;
+    udt::Socket _sender { nullptr };
+    udt::Socket _receiver { nullptr };
+    HifiSockAddr _target; // the link, towards the receiver
+
+    QElapsedTimer _clock; // shared by the sender and receiver for latency, since they are in one process
+    std::clock_t _startCPU { 0 };
+    QTimer _sendTimer;
+    bool _isSending { true };
+    qint64 _lastSendUsecs { 0 };
+    double _unreliableBytesOwed { 0.0 };
+
+    quint64 _numSent { 0 };
+    quint64 _bytesSent { 0 };
+    quint64 _numReceived { 0 };
+    quint64 _bytesReceived { 0 };
+    qint64 _lastReceiveUsecs { 0 };
+
+    struct PendingMessage {
+        QByteArray header;
+        int size { 0 };
+    };
+    std::unordered_map<udt::Packet::MessageNumber, PendingMessage> _pendingMessages;
+
+    std::vector<qint64> _latenciesUsecs;
+
+    quint64 _sentPackets { 0 }; // by the sender's connection, including retransmissions
+    quint64 _retransmittedPackets { 0 };
+    quint64 _sentBytes { 0 };
+
+    quint64 _lastSampleBytesReceived { 0 };
+    qint64 _lastSampleUsecs { 0 };
+};
+
+#endif // hifi_UDTSimulator_h
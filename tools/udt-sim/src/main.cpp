@@ -0,0 +1,17 @@
+//
+//  main.cpp
+//  tools/udt-sim/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+
+#include <QtCore/QCoreApplication>
+
+#include "UDTSimulator.h"
+
+int main(int argc, char* argv[]) {
+    UDTSimulator app(argc, argv);
+    return app.exec();
+}